@@ -27,6 +27,8 @@
 //
 #include <GEOMAlgo_Algo.hxx>
 
+#include <OSD_Timer.hxx>
+
 //=======================================================================
 // function:
 // purpose:
@@ -35,7 +37,10 @@ GEOMAlgo_Algo::GEOMAlgo_Algo()
 :
   myErrorStatus(1),
   myWarningStatus(0),
-  myComputeInternalShapes(Standard_True)
+  myComputeInternalShapes(Standard_True),
+  myRunParallel(Standard_False),
+  myTimingEnabled(Standard_False),
+  myPhaseStart(0.)
 {}
 //=======================================================================
 // function: ~
@@ -88,3 +93,74 @@ void GEOMAlgo_Algo::ComputeInternalShapes(const Standard_Boolean theFlag)
 {
   myComputeInternalShapes = theFlag;
 }
+//=======================================================================
+//function : SetRunParallel
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::SetRunParallel(const Standard_Boolean theFlag)
+{
+  myRunParallel=theFlag;
+}
+//=======================================================================
+//function : RunParallel
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Algo::RunParallel()const
+{
+  return myRunParallel;
+}
+//=======================================================================
+//function : SetTimingEnabled
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::SetTimingEnabled(const Standard_Boolean theFlag)
+{
+  myTimingEnabled=theFlag;
+  if (!myTimingEnabled) {
+    ClearPhases();
+  }
+}
+//=======================================================================
+//function : TimingEnabled
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Algo::TimingEnabled()const
+{
+  return myTimingEnabled;
+}
+//=======================================================================
+//function : Phases
+//purpose  :
+//=======================================================================
+const GEOMAlgo_VectorOfPhaseInfo& GEOMAlgo_Algo::Phases()const
+{
+  return myPhases;
+}
+//=======================================================================
+//function : ClearPhases
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::ClearPhases()
+{
+  myPhases.Clear();
+}
+//=======================================================================
+//function : DoBeginPhase
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::DoBeginPhase(const Standard_CString theName)
+{
+  myPhases.Append(GEOMAlgo_PhaseInfo(theName));
+  myPhaseStart=OSD_Timer::GetWallClockTime();
+}
+//=======================================================================
+//function : DoEndPhase
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Algo::DoEndPhase()
+{
+  if (myPhases.IsEmpty()) {
+    return;
+  }
+  myPhases.ChangeLast().SetTime(OSD_Timer::GetWallClockTime()-myPhaseStart);
+}
@@ -32,6 +32,8 @@
 #include <Standard_Macro.hxx>
 #include <Standard_Integer.hxx>
 #include <Standard_Boolean.hxx>
+#include <Standard_Size.hxx>
+#include <GEOMAlgo_VectorOfPhaseInfo.hxx>
 
 //=======================================================================
 //class    : GEOMAlgo_Algo
@@ -54,6 +56,26 @@ class GEOMAlgo_Algo
   Standard_EXPORT
     void ComputeInternalShapes(const Standard_Boolean theFlag) ;
 
+  //! Enables the parallel mode of the algorithm (where it is <br>
+  //!          implemented). Disabled by default. <br>
+  Standard_EXPORT
+    void SetRunParallel(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean RunParallel() const;
+
+  //! Enables the recording of the timing and the counters <br>
+  //!          of the phases of Perform(). Disabled by default. <br>
+  Standard_EXPORT
+    void SetTimingEnabled(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean TimingEnabled() const;
+
+  //! Returns the phases recorded by the last Perform() <br>
+  Standard_EXPORT
+    const GEOMAlgo_VectorOfPhaseInfo& Phases() const;
+
 protected:
   Standard_EXPORT
     GEOMAlgo_Algo();
@@ -67,9 +89,52 @@ protected:
   Standard_EXPORT
     virtual  void CheckResult() ;
 
+  Standard_EXPORT
+    void ClearPhases() ;
+
+  Standard_EXPORT
+    void DoBeginPhase(const Standard_CString theName) ;
+
+  Standard_EXPORT
+    void DoEndPhase() ;
+
+  // The phase recorders below do nothing unless the timing is enabled
+  void BeginPhase(const Standard_CString theName) {
+    if (myTimingEnabled) {
+      DoBeginPhase(theName);
+    }
+  }
+
+  void EndPhase() {
+    if (myTimingEnabled) {
+      DoEndPhase();
+    }
+  }
+
+  void AddPhaseShapes(const Standard_Size theNb) {
+    if (myTimingEnabled && !myPhases.IsEmpty()) {
+      myPhases.ChangeLast().AddShapes(theNb);
+    }
+  }
+
+  void AddPhaseTreeQueries(const Standard_Size theNb) {
+    if (myTimingEnabled && !myPhases.IsEmpty()) {
+      myPhases.ChangeLast().AddTreeQueries(theNb);
+    }
+  }
+
+  void AddPhaseClsfCalls(const Standard_Size theNb) {
+    if (myTimingEnabled && !myPhases.IsEmpty()) {
+      myPhases.ChangeLast().AddClsfCalls(theNb);
+    }
+  }
 
   Standard_Integer myErrorStatus;
   Standard_Integer myWarningStatus;
   Standard_Boolean myComputeInternalShapes;
+  Standard_Boolean myRunParallel;
+  Standard_Boolean myTimingEnabled;
+  Standard_Real myPhaseStart;
+  GEOMAlgo_VectorOfPhaseInfo myPhases;
 };
 #endif
@@ -49,6 +49,10 @@
 #include <GeomAPI_ProjectPointOnSurf.hxx>
 #include <GeomAPI_ProjectPointOnCurve.hxx>
 
+#include <TColgp_Array1OfPnt.hxx>
+
+#include <Poly_Array1OfTriangle.hxx>
+#include <Poly_Triangle.hxx>
 #include <Poly_Triangulation.hxx>
 
 #include <TopAbs_Orientation.hxx>
@@ -83,8 +87,95 @@
 #include <BOPTools_AlgoTools3D.hxx>
 #include <BOPTools_AlgoTools2D.hxx>
 
+#include <OSD_Parallel.hxx>
+#include <NCollection_Array1.hxx>
+
 #include <GEOMAlgo_PassKeyShape.hxx>
 
+#include <algorithm>
+
+//=======================================================================
+//class    : GEOMAlgo_RefineSDShapesFunctor
+//purpose  : Splits the buckets of one chunk into the groups of
+//           the coinciding shapes.
+//           Each chunk takes the context of a free slot of the pool,
+//           the pool has one slot per thread.
+//=======================================================================
+class GEOMAlgo_RefineSDShapesFunctor
+{
+ public:
+  GEOMAlgo_RefineSDShapesFunctor
+    (const GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& theMPKLE,
+     const Standard_Real theTol,
+     const Handle(GEOMAlgo_ContextPool)& thePool,
+     NCollection_Array1<TopTools_IndexedDataMapOfShapeListOfShape>& theMEE,
+     NCollection_Array1<Standard_Integer>& theErr,
+     const Standard_Integer theNbChunks)
+  :
+    myMPKLE(theMPKLE),
+    myTol(theTol),
+    myPool(thePool),
+    myMEE(theMEE),
+    myErr(theErr),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb, iSlot;
+    Handle(IntTools_Context) aCtx;
+    //
+    // the context of the free slot of the pool, a local one
+    // if there is no free slot
+    iSlot=myPool->Acquire();
+    if (iSlot<0) {
+      aCtx=new IntTools_Context;
+    }
+    else {
+      aCtx=myPool->Context(iSlot);
+    }
+    //
+    aNb=myMPKLE.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myErr(i)=GEOMAlgo_AlgoTools::FindSDShapes(myMPKLE(i), myTol,
+                                                myMEE(i), aCtx);
+    }
+    //
+    if (iSlot>=0) {
+      myPool->Release(iSlot);
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& myMPKLE;
+  Standard_Real myTol;
+  Handle(GEOMAlgo_ContextPool) myPool;
+  NCollection_Array1<TopTools_IndexedDataMapOfShapeListOfShape>& myMEE;
+  NCollection_Array1<Standard_Integer>& myErr;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//struct   : GEOMAlgo_TriangulationLink
+//purpose  : the link of the triangulation, myN1<myN2
+//=======================================================================
+struct GEOMAlgo_TriangulationLink
+{
+  Standard_Integer myN1;
+  Standard_Integer myN2;
+  //
+  bool operator<(const GEOMAlgo_TriangulationLink& theOther) const
+  {
+    return (myN1<theOther.myN1) ||
+      (myN1==theOther.myN1 && myN2<theOther.myN2);
+  }
+  //
+  bool operator==(const GEOMAlgo_TriangulationLink& theOther) const
+  {
+    return myN1==theOther.myN1 && myN2==theOther.myN2;
+  }
+};
 
 static
   void GetCount(const TopoDS_Shape& aS,
@@ -736,19 +827,48 @@ Standard_Integer GEOMAlgo_AlgoTools::FindSDShapes
 Standard_Integer GEOMAlgo_AlgoTools::RefineSDShapes
   (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMPKLE,
    const Standard_Real aTol,
-   const Handle(IntTools_Context)& aCtx)
+   const Handle(IntTools_Context)& aCtx,
+   const Standard_Boolean bRunParallel)
 {
-  Standard_Integer i, aNbE, iErr, j, aNbEE, aNbToAdd;
-  TopTools_IndexedDataMapOfShapeListOfShape aMEE, aMSDE, aMEToAdd;
+  Handle(GEOMAlgo_ContextPool) aPool;
   //
-  iErr=1;
+  aPool=new GEOMAlgo_ContextPool(aCtx);
+  return RefineSDShapes(aMPKLE, aTol, aPool, bRunParallel);
+}
+//=======================================================================
+//function : RefineSDShapes
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_AlgoTools::RefineSDShapes
+  (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMPKLE,
+   const Standard_Real aTol,
+   const Handle(GEOMAlgo_ContextPool)& aPool,
+   const Standard_Boolean bRunParallel)
+{
+  Standard_Integer i, aNbE, iErr, j, aNbEE, aNbToAdd, aNbChunks;
+  TopTools_IndexedDataMapOfShapeListOfShape aMEToAdd;
   //
   aNbE=aMPKLE.Extent();
+  if (!aNbE) {
+    return 0;
+  }
+  //
+  // the buckets are independent, the groups of each bucket are found
+  // first and merged in the order of the buckets then
+  NCollection_Array1<TopTools_IndexedDataMapOfShapeListOfShape> aMEEs(1, aNbE);
+  NCollection_Array1<Standard_Integer> aErrs(1, aNbE);
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNbE, bRunParallel);
+  aPool->Reserve(GEOMAlgo_AlgoTools::NbSlots(aNbChunks));
+  GEOMAlgo_RefineSDShapesFunctor aFunctor(aMPKLE, aTol, aPool,
+                                          aMEEs, aErrs, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, !bRunParallel);
+  //
   for (i=1; i<=aNbE; ++i) {
     TopTools_ListOfShape& aLSDE=aMPKLE.ChangeFromIndex(i);
+    TopTools_IndexedDataMapOfShapeListOfShape& aMEE=aMEEs(i);
     //
-    aMEE.Clear();
-    iErr=GEOMAlgo_AlgoTools::FindSDShapes(aLSDE, aTol, aMEE, aCtx);
+    iErr=aErrs(i);
     if (iErr) {
       return iErr;
     }
@@ -841,6 +961,119 @@ Standard_Boolean
   return isTriangulation;
 }
 
+//=======================================================================
+//function : BoundaryNodes
+//purpose  : 
+//=======================================================================
+Standard_Integer GEOMAlgo_AlgoTools::BoundaryNodes
+  (const Handle(Poly_Triangulation)& theTR,
+   NCollection_Array1<Standard_Boolean>& theIsBoundary,
+   NCollection_Vector<Standard_Integer>* thePInnerLinks)
+{
+  Standard_Integer i, j, k, n[4], aNbL, aNbNodes, aNbInner;
+  //
+  const TColgp_Array1OfPnt& aNodes=theTR->Nodes();
+  aNbNodes=aNodes.Length();
+  theIsBoundary.Resize(aNodes.Lower(), aNodes.Upper(), Standard_False);
+  theIsBoundary.Init(Standard_False);
+  //
+  const Poly_Array1OfTriangle& aTrs=theTR->Triangles();
+  if (aTrs.IsEmpty()) {
+    return aNbNodes;
+  }
+  //
+  // all links of the triangles, sorted; the boundary link
+  // occurs once, the inner one - twice
+  aNbL=3*aTrs.Length();
+  NCollection_Array1<GEOMAlgo_TriangulationLink> aLinks(1, aNbL);
+  //
+  k=1;
+  for (i=aTrs.Lower(); i<=aTrs.Upper(); ++i) {
+    aTrs(i).Get(n[0], n[1], n[2]);
+    n[3]=n[0];
+    for (j=0; j<3; ++j, ++k) {
+      GEOMAlgo_TriangulationLink& aL=aLinks(k);
+      aL.myN1=Min(n[j], n[j+1]);
+      aL.myN2=Max(n[j], n[j+1]);
+    }
+  }
+  std::sort(&aLinks(1), &aLinks(1)+aNbL);
+  //
+  aNbInner=aNbNodes;
+  for (i=1; i<=aNbL; i=j) {
+    const GEOMAlgo_TriangulationLink& aL=aLinks(i);
+    for (j=i+1; j<=aNbL && aLinks(j)==aL; ++j) {
+    }
+    //
+    if (j-i>1) {
+      if (thePInnerLinks) {
+        thePInnerLinks->Append(aL.myN1);
+        thePInnerLinks->Append(aL.myN2);
+      }
+      continue;
+    }
+    //
+    for (k=0; k<2; ++k) {
+      Standard_Boolean& bIsBoundary=theIsBoundary(k ? aL.myN2 : aL.myN1);
+      if (!bIsBoundary) {
+        bIsBoundary=Standard_True;
+        --aNbInner;
+      }
+    }
+  }
+  return aNbInner;
+}
+//=======================================================================
+//function : NbChunks
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_AlgoTools::NbChunks
+  (const Standard_Integer theNbItems,
+   const Standard_Boolean theRunParallel)
+{
+  Standard_Integer aNbChunks;
+  //
+  aNbChunks=1;
+  if (theRunParallel) {
+    aNbChunks=4*OSD_Parallel::NbLogicalProcessors();
+    if (aNbChunks>theNbItems) {
+      aNbChunks=Max(theNbItems, 1);
+    }
+  }
+  return aNbChunks;
+}
+//=======================================================================
+//function : NbSlots
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_AlgoTools::NbSlots
+  (const Standard_Integer theNbChunks)
+{
+  Standard_Integer aNbSlots;
+  //
+  aNbSlots=OSD_Parallel::NbLogicalProcessors();
+  if (aNbSlots>theNbChunks) {
+    aNbSlots=theNbChunks;
+  }
+  return Max(aNbSlots, 1);
+}
+//=======================================================================
+//function : ChunkBounds
+//purpose  :
+//=======================================================================
+void GEOMAlgo_AlgoTools::ChunkBounds(const Standard_Integer theChunk,
+                                     const Standard_Integer theNbChunks,
+                                     const Standard_Integer theLower,
+                                     const Standard_Integer theUpper,
+                                     Standard_Integer& theFirst,
+                                     Standard_Integer& theLast)
+{
+  Standard_Size aNb;
+  //
+  aNb=(theUpper>=theLower) ? (Standard_Size)(theUpper-theLower+1) : 0;
+  theFirst=theLower+(Standard_Integer)((aNb*theChunk)/theNbChunks);
+  theLast=theLower+(Standard_Integer)((aNb*(theChunk+1))/theNbChunks)-1;
+}
 //=======================================================================
 //function : IsCompositeShape
 //purpose  :
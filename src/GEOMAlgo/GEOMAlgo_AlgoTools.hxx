@@ -37,6 +37,8 @@
 
 #include <Geom_Surface.hxx>
 
+#include <Poly_Triangulation.hxx>
+
 #include <TopAbs_ShapeEnum.hxx>
 
 #include <TopoDS_Face.hxx>
@@ -47,7 +49,11 @@
 #include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <TopTools_ListOfShape.hxx>
 #include <TopTools_IndexedDataMapOfShapeShape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
 
+#include <GEOMAlgo_ContextPool.hxx>
 #include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
 #include <GEOMAlgo_ListOfCoupleOfShapes.hxx>
 #include <GEOMAlgo_IndexedDataMapOfShapeIndexedMapOfShape.hxx>
@@ -82,11 +88,26 @@ class GEOMAlgo_AlgoTools  {
   Standard_EXPORT
     static  Standard_Boolean BuildTriangulation(const TopoDS_Shape& aS) ;
 
+  //! Splits each list of <aMSD> into the groups of the shapes <br>
+  //!          coinciding with the tolerance <aTol>. <br>
+  //!          With bRunParallel the lists are processed in parallel, <br>
+  //!          each thread has its own context; the result does not <br>
+  //!          depend on the mode. <br>
+  Standard_EXPORT
+    static  Standard_Integer RefineSDShapes
+      (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMSD,
+       const Standard_Real aTol,
+       const Handle(IntTools_Context)& aCtx,
+       const Standard_Boolean bRunParallel = Standard_False) ;
+
+  //! The same as above, the threads take the contexts of <br>
+  //!          the slots of aPool. <br>
   Standard_EXPORT
     static  Standard_Integer RefineSDShapes
       (GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape& aMSD,
        const Standard_Real aTol,
-       const Handle(IntTools_Context)& aCtx) ;
+       const Handle(GEOMAlgo_ContextPool)& aPool,
+       const Standard_Boolean bRunParallel = Standard_False) ;
 
   Standard_EXPORT
     static  Standard_Integer FindSDShapes(const TopTools_ListOfShape& aLE,
@@ -186,6 +207,64 @@ class GEOMAlgo_AlgoTools  {
     static void FindChains(const GEOMAlgo_IndexedDataMapOfShapeIndexedMapOfShape& aMCV,
 			   GEOMAlgo_IndexedDataMapOfShapeIndexedMapOfShape& aMapChains);
 
+  //! Finds the chains of coincident vertices of the map aMV. <br>
+  //!          The vertices i, j are coincident if the distance between <br>
+  //!          them is not greater than the sum of their tolerances <br>
+  //!          and 2*aTol; the chains are the transitive closure of it. <br>
+  //!          The chains are returned in the compressed form: the indices <br>
+  //!          (in aMV) of the vertices of the chain k (k=1..aNbChains) are <br>
+  //!          aMembers(aOffsets(k)) .. aMembers(aOffsets(k+1)-1), <br>
+  //!          in the ascending order; single vertices make chains too. <br>
+  //!          With bRunParallel the neighbours are searched in parallel. <br>
+  Standard_EXPORT
+    static void FindSDVertices(const TopTools_IndexedMapOfShape& aMV,
+                               const Standard_Real aTol,
+                               const Standard_Boolean bRunParallel,
+                               Standard_Integer& aNbChains,
+                               NCollection_Array1<Standard_Integer>& aOffsets,
+                               NCollection_Array1<Standard_Integer>& aMembers);
+
+  //! Finds the boundary nodes of the triangulation theTR, i.e. the <br>
+  //!          nodes of the links that belong to one triangle only. <br>
+  //!          theIsBoundary is resized to the nodes of theTR and set to <br>
+  //!          True for the boundary nodes. If thePInnerLinks is given, <br>
+  //!          the nodes of the inner links are appended to it by pairs, <br>
+  //!          in the ascending order of the links. <br>
+  //!          The links are counted by sorting, not by hashing. <br>
+  //!          Returns the number of the inner nodes. <br>
+  Standard_EXPORT
+    static Standard_Integer BoundaryNodes
+      (const Handle(Poly_Triangulation)& theTR,
+       NCollection_Array1<Standard_Boolean>& theIsBoundary,
+       NCollection_Vector<Standard_Integer>* thePInnerLinks = NULL);
+
+  //! Returns the number of the chunks the theNbItems items of a <br>
+  //!          parallel loop are split into: 4 chunks per logical <br>
+  //!          processor, not more than theNbItems, or 1 if <br>
+  //!          theRunParallel is False. <br>
+  Standard_EXPORT
+    static Standard_Integer NbChunks(const Standard_Integer theNbItems,
+                                     const Standard_Boolean theRunParallel);
+
+  //! Returns the number of the slots of a context pool for the <br>
+  //!          workers of a parallel loop of theNbChunks chunks: one <br>
+  //!          slot per logical processor, not more than theNbChunks. <br>
+  //!          The workers take the slots by GEOMAlgo_ContextPool::Acquire(). <br>
+  Standard_EXPORT
+    static Standard_Integer NbSlots(const Standard_Integer theNbChunks);
+
+  //! Computes the items [theFirst, theLast] of the chunk theChunk, <br>
+  //!          0 <= theChunk < theNbChunks, of the items [theLower, theUpper]. <br>
+  //!          The chunks cover the items in order, their sizes differ <br>
+  //!          by one at most. theFirst > theLast for an empty chunk. <br>
+  Standard_EXPORT
+    static void ChunkBounds(const Standard_Integer theChunk,
+                            const Standard_Integer theNbChunks,
+                            const Standard_Integer theLower,
+                            const Standard_Integer theUpper,
+                            Standard_Integer& theFirst,
+                            Standard_Integer& theLast);
+
   Standard_EXPORT
     static  void CopyShape(const TopoDS_Shape& aS,
 			   TopoDS_Shape& aSC) ;
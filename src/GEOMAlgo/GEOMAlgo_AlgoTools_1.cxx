@@ -32,7 +32,70 @@
 #include <TopoDS_Shape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 
+#include <gp_Pnt.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <BRep_Tool.hxx>
+#include <NCollection_UBTreeFiller.hxx>
+#include <OSD_Parallel.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
 
+#include <GEOMAlgo_BndSphere.hxx>
+#include <GEOMAlgo_BndSphereTree.hxx>
+#include <GEOMAlgo_UnionFind.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_SDVerticesFunctor
+//purpose  : Finds the neighbours of the vertices of one chunk
+//           and merges them into the disjoint sets.
+//           Each chunk has its own selector, the tree is shared.
+//=======================================================================
+class GEOMAlgo_SDVerticesFunctor
+{
+ public:
+  GEOMAlgo_SDVerticesFunctor
+    (const GEOMAlgo_BndSphereTree& theTree,
+     const NCollection_Array1<GEOMAlgo_BndSphere>& theSpheres,
+     GEOMAlgo_UnionFind& theUF,
+     const Standard_Integer theNbChunks)
+  :
+    myTree(theTree),
+    mySpheres(theSpheres),
+    myUF(theUF),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb, aIP1;
+    TColStd_ListIteratorOfListOfInteger aIt;
+    GEOMAlgo_BndSphereTreeSelector aSelector;
+    //
+    aNb=mySpheres.Length();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      aSelector.Clear();
+      aSelector.SetBox(mySpheres(i));
+      if (!myTree.Select(aSelector)) {
+        continue;
+      }
+      //
+      aIt.Initialize(aSelector.Indices());
+      for (; aIt.More(); aIt.Next()) {
+        aIP1=aIt.Value();
+        // the relation is symmetric, each pair is merged once
+        if (aIP1>i) {
+          myUF.Union(i, aIP1);
+        }
+      }
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_BndSphereTree& myTree;
+  const NCollection_Array1<GEOMAlgo_BndSphere>& mySpheres;
+  GEOMAlgo_UnionFind& myUF;
+  Standard_Integer myNbChunks;
+};
 
 static
   void ProcessBlock(const TopoDS_Shape& aF,
@@ -40,6 +103,49 @@ static
                     TopTools_IndexedMapOfShape& aProcessed,
                     TopTools_IndexedMapOfShape& aChain);
 
+//=======================================================================
+// function: FindSDVertices
+// purpose :
+//=======================================================================
+void GEOMAlgo_AlgoTools::FindSDVertices
+  (const TopTools_IndexedMapOfShape& aMV,
+   const Standard_Real aTol,
+   const Standard_Boolean bRunParallel,
+   Standard_Integer& aNbChains,
+   NCollection_Array1<Standard_Integer>& aOffsets,
+   NCollection_Array1<Standard_Integer>& aMembers)
+{
+  Standard_Integer i, aNbV, aNbChunks;
+  GEOMAlgo_UnionFind aUF;
+  GEOMAlgo_BndSphereTree aBBTree;
+  NCollection_UBTreeFiller <Standard_Integer, GEOMAlgo_BndSphere> aTreeFiller(aBBTree);
+  //
+  aNbChains=0;
+  aNbV=aMV.Extent();
+  if (!aNbV) {
+    return;
+  }
+  //
+  NCollection_Array1<GEOMAlgo_BndSphere> aSpheres(1, aNbV);
+  for (i=1; i<=aNbV; ++i) {
+    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
+    GEOMAlgo_BndSphere& aBox=aSpheres(i);
+    //
+    aBox.SetGap(aTol);
+    aBox.SetCenter(BRep_Tool::Pnt(aV));
+    aBox.SetRadius(BRep_Tool::Tolerance(aV));
+    //
+    aTreeFiller.Add(i, aBox);
+  }
+  aTreeFiller.Fill();
+  //
+  aUF.Init(aNbV);
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNbV, bRunParallel);
+  GEOMAlgo_SDVerticesFunctor aFunctor(aBBTree, aSpheres, aUF, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, !bRunParallel);
+  //
+  aUF.Sets(aNbChains, aOffsets, aMembers);
+}
 //=======================================================================
 // function: FindChains
 // purpose :
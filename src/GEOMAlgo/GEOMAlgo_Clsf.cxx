@@ -89,6 +89,70 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_Clsf, GEOMAlgo_HAlgo);
   return myState;
 }
 //=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_Clsf::Perform(const gp_Pnt* pPnts,
+                              const Standard_Size aNbPnts,
+                              TopAbs_State* pStates)
+{
+  Standard_Size i;
+  //
+  myErrorStatus=0;
+  for (i=0; i<aNbPnts; ++i) {
+    myPnt=pPnts[i];
+    Perform();
+    if (myErrorStatus) {
+      return;
+    }
+    pStates[i]=myState;
+  }
+}
+//=======================================================================
+//function : Copy
+//purpose  :
+//=======================================================================
+  Handle(GEOMAlgo_Clsf) GEOMAlgo_Clsf::Copy() const
+{
+  return Handle(GEOMAlgo_Clsf)();
+}
+//=======================================================================
+//function : NbPntsPerBlock
+//purpose  :
+//=======================================================================
+  Standard_Integer GEOMAlgo_Clsf::NbPntsPerBlock() const
+{
+  return 1;
+}
+//=======================================================================
+//function : CopyFrom
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_Clsf::CopyFrom(const GEOMAlgo_Clsf& theOther)
+{
+  myErrorStatus=theOther.myErrorStatus;
+  myWarningStatus=theOther.myWarningStatus;
+  myState=theOther.myState;
+  myPnt=theOther.myPnt;
+  myTolerance=theOther.myTolerance;
+}
+//=======================================================================
+//function : HasStateOfBox
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_Clsf::HasStateOfBox() const
+{
+  return Standard_False;
+}
+//=======================================================================
+//function : StateOfBox
+//purpose  :
+//=======================================================================
+  TopAbs_State GEOMAlgo_Clsf::StateOfBox(const Bnd_Box& ) const
+{
+  return TopAbs_UNKNOWN;
+}
+//=======================================================================
 //function : CanBeON
 //purpose  :
 //=======================================================================
@@ -34,6 +34,8 @@
 #include <TopAbs_State.hxx>
 #include <gp_Pnt.hxx>
 #include <Standard_Real.hxx>
+#include <Standard_Size.hxx>
+#include <Bnd_Box.hxx>
 #include <GEOMAlgo_HAlgo.hxx>
 #include <Standard_Boolean.hxx>
 #include <Geom_Curve.hxx>
@@ -63,6 +65,41 @@ class GEOMAlgo_Clsf : public GEOMAlgo_HAlgo
   Standard_EXPORT
     TopAbs_State State() const;
 
+  using GEOMAlgo_HAlgo::Perform;
+
+  //! Classifies the points pPnts[0..aNbPnts-1] and puts their <br>
+  //!          states to pStates. Stops at the first point that can <br>
+  //!          not be classified, ErrorStatus() is set then. <br>
+  //!          The default implementation calls Perform() for each point. <br>
+  Standard_EXPORT
+    virtual  void Perform(const gp_Pnt* pPnts,
+                          const Standard_Size aNbPnts,
+                          TopAbs_State* pStates) ;
+
+  //! Returns a new classifier with the same data that can be <br>
+  //!          used in another thread, or a null handle if the <br>
+  //!          classifier can not be copied (the default). <br>
+  Standard_EXPORT
+    virtual  Handle(GEOMAlgo_Clsf) Copy() const;
+
+  //! Returns the number of the points worth to be passed to the <br>
+  //!          batch Perform() at once. The classifiers that are <br>
+  //!          expensive per point return 1 (the default), so the <br>
+  //!          caller can stop as soon as it has the answer. <br>
+  Standard_EXPORT
+    virtual  Standard_Integer NbPntsPerBlock() const;
+
+  //! Returns True if StateOfBox() can give the state of a box <br>
+  //!          (False by default). <br>
+  Standard_EXPORT
+    virtual  Standard_Boolean HasStateOfBox() const;
+
+  //! Returns IN or OUT if all points of the box aBox have this <br>
+  //!          state, UNKNOWN if the points may have different states <br>
+  //!          or the state can not be computed (the default). <br>
+  Standard_EXPORT
+    virtual  TopAbs_State StateOfBox(const Bnd_Box& aBox) const;
+
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Curve)& aCT) const;
 
@@ -78,6 +115,10 @@ class GEOMAlgo_Clsf : public GEOMAlgo_HAlgo
   Standard_EXPORT
     virtual ~GEOMAlgo_Clsf();
 
+  //! Copies the data of the base class from theOther, used by Copy() <br>
+  Standard_EXPORT
+    void CopyFrom(const GEOMAlgo_Clsf& theOther) ;
+
   TopAbs_State myState;
   gp_Pnt myPnt;
   Standard_Real myTolerance;
@@ -49,6 +49,10 @@
 
 IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
 
+static
+  TopAbs_State StateByMasks(const Standard_Integer aMaskIn,
+                            const Standard_Integer aMaskOut);
+
 //=======================================================================
 //function :
 //purpose  :
@@ -95,6 +99,7 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
   TopTools_IndexedMapOfShape aMF;
   //
   myErrorStatus=0;
+  myPlanes.Clear();
   //
   if(myBox.IsNull()) {
     myErrorStatus=10; // myBox=NULL
@@ -151,6 +156,15 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
       myGAS[i-1].Load(aSR);
     }
   }
+  //
+  // the plane coefficients for the batch classification
+  for (i=0; i<aNbF; ++i) {
+    if (myGAS[i].GetType()!=GeomAbs_Plane) {
+      myPlanes.Clear();
+      break;
+    }
+    myPlanes.Add(myGAS[i].Plane());
+  }
 }
 //=======================================================================
 //function : Perform
@@ -159,27 +173,72 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
   void GEOMAlgo_ClsfBox::Perform()
 {
   myErrorStatus=0;
-  //
-  const Standard_Integer aNbS=6;
-  Standard_Integer i, aNbON, aNbIN, iNext;
-  TopAbs_State aSt;
   /*
   CheckData();
   if(myErrorStatus) {
     return;
   }
   */
-  iNext=1;
+  if (myPlanes.NbPlanes()==6) {
+    Standard_Integer aMaskIn, aMaskOut;
+    //
+    myPlanes.Perform(&myPnt, 1, myTolerance, &aMaskIn, &aMaskOut);
+    myState=StateByMasks(aMaskIn, aMaskOut);
+    return;
+  }
+  myState=ComputeState(myPnt);
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfBox::Perform(const gp_Pnt* pPnts,
+                                 const Standard_Size aNbPnts,
+                                 TopAbs_State* pStates)
+{
+  const Standard_Size aNbBlock=256;
+  Standard_Size i, j, aNb;
+  Standard_Integer aMaskIn[aNbBlock], aMaskOut[aNbBlock];
+  //
+  myErrorStatus=0;
+  //
+  if (myPlanes.NbPlanes()!=6) {
+    // CheckData() was not called or the faces are not planar
+    for (i=0; i<aNbPnts; ++i) {
+      pStates[i]=ComputeState(pPnts[i]);
+    }
+    return;
+  }
+  //
+  for (i=0; i<aNbPnts; i+=aNb) {
+    aNb=aNbPnts-i;
+    if (aNb>aNbBlock) {
+      aNb=aNbBlock;
+    }
+    myPlanes.Perform(pPnts+i, aNb, myTolerance, aMaskIn, aMaskOut);
+    for (j=0; j<aNb; ++j) {
+      pStates[i+j]=StateByMasks(aMaskIn[j], aMaskOut[j]);
+    }
+  }
+}
+//=======================================================================
+//function : ComputeState
+//purpose  :
+//=======================================================================
+  TopAbs_State GEOMAlgo_ClsfBox::ComputeState(const gp_Pnt& aP) const
+{
+  const Standard_Integer aNbS=6;
+  Standard_Integer i, aNbON, aNbIN;
+  TopAbs_State aSt;
+  //
   aNbON=0;
   aNbIN=0;
-  for(i=0; i<aNbS && iNext; i++) {
-    GEOMAlgo_SurfaceTools::GetState(myPnt, myGAS[i], myTolerance, aSt);
+  for(i=0; i<aNbS; i++) {
+    GEOMAlgo_SurfaceTools::GetState(aP, myGAS[i], myTolerance, aSt);
     //
     switch (aSt) {
       case TopAbs_OUT:
-        myState=aSt;
-        iNext=0;
-        break;
+        return aSt;
       case TopAbs_ON:
         ++aNbON;
         break;
@@ -187,22 +246,77 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
         ++aNbIN;
         break;
       default:
-        myState=TopAbs_UNKNOWN;
-        iNext=0;
-        break;
+        return TopAbs_UNKNOWN;
     }
   }
   //
-  if (iNext) {
-    myState=TopAbs_UNKNOWN;
-    //
-    if (aNbON && aNbIN) {
-      myState=TopAbs_ON;
+  if (aNbON && aNbIN) {
+    return TopAbs_ON;
+  }
+  else if (aNbIN==aNbS){
+    return TopAbs_IN;
+  }
+  return TopAbs_UNKNOWN;
+}
+//=======================================================================
+//function : Copy
+//purpose  :
+//=======================================================================
+  Handle(GEOMAlgo_Clsf) GEOMAlgo_ClsfBox::Copy() const
+{
+  Standard_Integer i;
+  Handle(GEOMAlgo_ClsfBox) aClsf;
+  //
+  aClsf=new GEOMAlgo_ClsfBox();
+  aClsf->CopyFrom(*this);
+  aClsf->myBox=myBox;
+  for (i=0; i<6; ++i) {
+    aClsf->myGAS[i]=myGAS[i];
+  }
+  aClsf->myPlanes=myPlanes;
+  return aClsf;
+}
+//=======================================================================
+//function : NbPntsPerBlock
+//purpose  : the state of a point is cheap to compute
+//=======================================================================
+  Standard_Integer GEOMAlgo_ClsfBox::NbPntsPerBlock() const
+{
+  return 64;
+}
+//=======================================================================
+//function : HasStateOfBox
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfBox::HasStateOfBox() const
+{
+  return Standard_True;
+}
+//=======================================================================
+//function : StateOfBox
+//purpose  : the same rules as ComputeState() for all points of aBox
+//=======================================================================
+  TopAbs_State GEOMAlgo_ClsfBox::StateOfBox(const Bnd_Box& aBox) const
+{
+  const Standard_Integer aNbS=6;
+  Standard_Integer i, iErr, aNbIN;
+  TopAbs_State aSt;
+  //
+  aNbIN=0;
+  for(i=0; i<aNbS; i++) {
+    iErr=GEOMAlgo_SurfaceTools::GetState(aBox, myGAS[i], myTolerance, aSt);
+    if (iErr) {
+      return TopAbs_UNKNOWN;
     }
-    else if (aNbIN==aNbS){
-      myState=TopAbs_IN;
+    if (aSt==TopAbs_OUT) {
+      return aSt;
+    }
+    if (aSt==TopAbs_IN) {
+      ++aNbIN;
     }
   }
+  //
+  return (aNbIN==aNbS) ? TopAbs_IN : TopAbs_UNKNOWN;
 }
 //=======================================================================
 //function : CanBeON
@@ -228,3 +342,22 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox, GEOMAlgo_Clsf)
   //
   return bRet;
 }
+//=======================================================================
+//function : StateByMasks
+//purpose  : the state of a point by the states of the six planes,
+//           see ComputeState()
+//=======================================================================
+TopAbs_State StateByMasks(const Standard_Integer aMaskIn,
+                          const Standard_Integer aMaskOut)
+{
+  if (aMaskOut) {
+    return TopAbs_OUT;
+  }
+  if (aMaskIn==0x3f) {
+    return TopAbs_IN;
+  }
+  if (aMaskIn) {
+    return TopAbs_ON;  // IN for some planes, ON for the others
+  }
+  return TopAbs_UNKNOWN;
+}
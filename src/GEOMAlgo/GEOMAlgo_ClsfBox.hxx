@@ -34,6 +34,7 @@
 #include <TopoDS_Shape.hxx>
 #include <GeomAdaptor_Surface.hxx>
 #include <GEOMAlgo_Clsf.hxx>
+#include <GEOMAlgo_PackedPlanes.hxx>
 #include <Standard_Boolean.hxx>
 #include <Geom_Curve.hxx>
 #include <Geom_Surface.hxx>
@@ -62,9 +63,26 @@ class GEOMAlgo_ClsfBox : public GEOMAlgo_Clsf
   Standard_EXPORT
     virtual  void Perform() ;
 
+  Standard_EXPORT
+    virtual  void Perform(const gp_Pnt* pPnts,
+                          const Standard_Size aNbPnts,
+                          TopAbs_State* pStates) ;
+
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    virtual  Handle(GEOMAlgo_Clsf) Copy() const;
+
+  Standard_EXPORT
+    virtual  Standard_Integer NbPntsPerBlock() const;
+
+  Standard_EXPORT
+    virtual  Standard_Boolean HasStateOfBox() const;
+
+  Standard_EXPORT
+    virtual  TopAbs_State StateOfBox(const Bnd_Box& aBox) const;
+
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Curve)& aC) const;
 
@@ -74,8 +92,12 @@ class GEOMAlgo_ClsfBox : public GEOMAlgo_Clsf
   DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ClsfBox,GEOMAlgo_Clsf)
 
  protected:
+  Standard_EXPORT
+    TopAbs_State ComputeState(const gp_Pnt& aP) const;
+
   TopoDS_Shape myBox;
   GeomAdaptor_Surface myGAS[6];
+  GEOMAlgo_PackedPlanes myPlanes;
 
 
 private:
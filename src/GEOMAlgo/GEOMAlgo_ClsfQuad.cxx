@@ -30,6 +30,7 @@
 #include <GEOMAlgo_SurfaceTools.hxx>
 
 #include <Geom_Plane.hxx>
+#include <gp_Pln.hxx>
 
 IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfQuad, GEOMAlgo_Clsf);
 
@@ -137,11 +138,26 @@ void GEOMAlgo_ClsfQuad::GetCorners(gp_Pnt &theTopLeftPoint,
 void GEOMAlgo_ClsfQuad::CheckData()
 {
   myErrorStatus = 0;
+  myPackedPlanes.Clear();
+  mySideVecs.clear();
 
   if (myQuadNormal.SquareMagnitude() <= DBL_MIN) {
     myErrorStatus = 10; // undefined quadrangle normal.
     return;
   }
+
+  // plane coefficients and side directions for the batch classification
+  for (size_t i = 0; i < myPlanes.size(); ++i) {
+    const gp_Pln aPln = myPlanes[i].Plane();
+    gp_Vec aSideNorm = aPln.Axis().Direction();
+
+    if (!myPackedPlanes.Add(aPln)) {
+      myPackedPlanes.Clear();
+      mySideVecs.clear();
+      return;
+    }
+    mySideVecs.push_back(myQuadNormal ^ aSideNorm);
+  }
 }
 //=======================================================================
 //function : Perform
@@ -150,7 +166,93 @@ void GEOMAlgo_ClsfQuad::CheckData()
 void GEOMAlgo_ClsfQuad::Perform()
 {
   myErrorStatus=0;
-  //
+
+  if (myPlanes.empty() || mySideVecs.size() != myPlanes.size()) {
+    // CheckData() was not called
+    myState=ComputeState(myPnt);
+    return;
+  }
+
+  Standard_Integer aMaskIn, aMaskOut;
+
+  myPackedPlanes.Perform(&myPnt, 1, myTolerance, &aMaskIn, &aMaskOut);
+  myState=ComputeState(myPnt, aMaskIn, aMaskOut);
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ClsfQuad::Perform(const gp_Pnt* pPnts,
+                                const Standard_Size aNbPnts,
+                                TopAbs_State* pStates)
+{
+  myErrorStatus=0;
+
+  if (myPlanes.empty() || mySideVecs.size() != myPlanes.size()) {
+    // CheckData() was not called
+    for (Standard_Size i = 0; i < aNbPnts; ++i) {
+      pStates[i] = ComputeState(pPnts[i]);
+    }
+    return;
+  }
+
+  const Standard_Size aNbBlock = 256;
+  Standard_Integer aMaskIn[aNbBlock], aMaskOut[aNbBlock];
+
+  for (Standard_Size i = 0; i < aNbPnts; i += aNbBlock) {
+    Standard_Size aNb = aNbPnts - i;
+    if (aNb > aNbBlock) {
+      aNb = aNbBlock;
+    }
+    myPackedPlanes.Perform(pPnts + i, aNb, myTolerance, aMaskIn, aMaskOut);
+    for (Standard_Size j = 0; j < aNb; ++j) {
+      pStates[i + j] = ComputeState(pPnts[i + j], aMaskIn[j], aMaskOut[j]);
+    }
+  }
+}
+//=======================================================================
+//function : ComputeState
+//purpose  : the same as ComputeState(aP) with the states of aP
+//           against the side planes given by the masks of
+//           GEOMAlgo_PackedPlanes
+//=======================================================================
+TopAbs_State GEOMAlgo_ClsfQuad::ComputeState(const gp_Pnt& aP,
+                                             const Standard_Integer aMaskIn,
+                                             const Standard_Integer aMaskOut) const
+{
+  double nbIn = 0.;
+
+  for (size_t i = 0; i < myPlanes.size(); ++i) {
+    if (aMaskIn & (1 << i)) {
+      nbIn += myConcaveSide[i] ? 0.5 : 1.0;
+    } else if (!(aMaskOut & (1 << i))) {
+      // ON: check that aP is between quadrangle corners
+      gp_Vec c1p (myPoints[i], aP);
+      gp_Vec pc2 (aP, myPoints[i+1]);
+
+      if (mySideVecs[i] * c1p >= 0. && mySideVecs[i] * pc2 >= 0.) {
+        return TopAbs_ON;
+      }
+    }
+  }
+
+  Standard_Real inThreshold = myPlanes.size(); // usually 4.0
+
+  if (myConcaveQuad) {
+    inThreshold = 2.5; // 1.0 + 1.0 + 0.5
+  }
+
+  if (nbIn >= inThreshold) {
+    return TopAbs_IN;
+  }
+  return TopAbs_OUT;
+}
+//=======================================================================
+//function : ComputeState
+//purpose  :
+//=======================================================================
+TopAbs_State GEOMAlgo_ClsfQuad::ComputeState(const gp_Pnt& aP) const
+{
   // Return IN if aP has TopAbs_IN with all sides.
   // In the case of concave quadrangle, return IN if
   // aP is OUT of only one concave side
@@ -159,7 +261,7 @@ void GEOMAlgo_ClsfQuad::Perform()
   for (size_t i = 0; i < myPlanes.size(); ++i) {
     TopAbs_State aSt;
 
-    GEOMAlgo_SurfaceTools::GetState(myPnt, myPlanes[i], myTolerance, aSt);
+    GEOMAlgo_SurfaceTools::GetState(aP, myPlanes[i], myTolerance, aSt);
 
     if (aSt == TopAbs_IN) {
       nbIn += myConcaveSide[i] ? 0.5 : 1.0;
@@ -169,12 +271,11 @@ void GEOMAlgo_ClsfQuad::Perform()
         Handle(Geom_Plane)::DownCast(myPlanes[i].Surface());
       gp_Vec aSideNorm = aSidePlane->Axis().Direction();
       gp_Vec aSideVec = myQuadNormal ^ aSideNorm;
-      gp_Vec c1p (myPoints[i], myPnt);
-      gp_Vec pc2 (myPnt, myPoints[i+1]);
+      gp_Vec c1p (myPoints[i], aP);
+      gp_Vec pc2 (aP, myPoints[i+1]);
 
       if (aSideVec * c1p >= 0. && aSideVec * pc2 >= 0.) {
-        myState = TopAbs_ON;
-        return;
+        return TopAbs_ON;
       }
       // consider to be IN (???????????)
       //nbIn += myConcaveSide[i] ? 0.5 : 1.0;
@@ -188,10 +289,115 @@ void GEOMAlgo_ClsfQuad::Perform()
   }
 
   if (nbIn >= inThreshold) {
-    myState = TopAbs_IN;
-  } else {
-    myState = TopAbs_OUT;
+    return TopAbs_IN;
+  }
+  return TopAbs_OUT;
+}
+//=======================================================================
+//function : Copy
+//purpose  :
+//=======================================================================
+Handle(GEOMAlgo_Clsf) GEOMAlgo_ClsfQuad::Copy() const
+{
+  Handle(GEOMAlgo_ClsfQuad) aClsf = new GEOMAlgo_ClsfQuad();
+
+  aClsf->CopyFrom(*this);
+  aClsf->myConcaveQuad  = myConcaveQuad;
+  aClsf->myConcaveSide  = myConcaveSide;
+  aClsf->myPoints       = myPoints;
+  aClsf->myPlanes       = myPlanes;
+  aClsf->myQuadNormal   = myQuadNormal;
+  aClsf->myPackedPlanes = myPackedPlanes;
+  aClsf->mySideVecs     = mySideVecs;
+
+  return aClsf;
+}
+//=======================================================================
+//function : NbPntsPerBlock
+//purpose  : the state of a point is cheap to compute
+//=======================================================================
+Standard_Integer GEOMAlgo_ClsfQuad::NbPntsPerBlock() const
+{
+  return 64;
+}
+//=======================================================================
+//function : HasStateOfBox
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ClsfQuad::HasStateOfBox() const
+{
+  return Standard_True;
+}
+//=======================================================================
+//function : StateOfBox
+//purpose  : the same rules as ComputeState() for all points of aBox:
+//           the sides that are IN or OUT for the whole box give
+//           the bounds of the weight of the IN sides; a side that
+//           crosses the box may give ON if the box overlaps the
+//           strip between the corners of the side
+//=======================================================================
+TopAbs_State GEOMAlgo_ClsfQuad::StateOfBox(const Bnd_Box& aBox) const
+{
+  if (myPlanes.empty() || aBox.IsVoid() || aBox.IsOpen()) {
+    return TopAbs_UNKNOWN;
+  }
+
+  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+
+  double nbInMin = 0., nbInMax = 0.;
+
+  for (size_t i = 0; i < myPlanes.size(); ++i) {
+    const gp_Pln aPln = myPlanes[i].Plane();
+    Standard_Real aDMin, aDMax;
+    double aWeight = myConcaveSide[i] ? 0.5 : 1.0;
+
+    GEOMAlgo_SurfaceTools::DistanceRange(aBox, aPln, aDMin, aDMax);
+    if (aDMax < -myTolerance) {
+      nbInMin += aWeight;
+      nbInMax += aWeight;
+      continue;
+    }
+    if (aDMin > myTolerance) {
+      continue;
+    }
+    nbInMax += aWeight;
+
+    // ON is possible if the projection of the box to the side
+    // overlaps the side
+    gp_Vec aSideVec = myQuadNormal ^ gp_Vec(aPln.Axis().Direction());
+    Standard_Real aPMin, aPMax, aP1, aP2, aP;
+
+    aPMin = RealLast();
+    aPMax = RealFirst();
+    for (int j = 0; j < 8; ++j) {
+      gp_Vec aV((j & 1) ? aXmax : aXmin,
+                (j & 2) ? aYmax : aYmin,
+                (j & 4) ? aZmax : aZmin);
+      aP = aSideVec * aV;
+      aPMin = Min(aPMin, aP);
+      aPMax = Max(aPMax, aP);
+    }
+    aP1 = aSideVec * gp_Vec(myPoints[i].XYZ());
+    aP2 = aSideVec * gp_Vec(myPoints[i+1].XYZ());
+    if (aPMax >= aP1 && aPMin <= aP2) {
+      return TopAbs_UNKNOWN;
+    }
+  }
+
+  Standard_Real inThreshold = myPlanes.size(); // usually 4.0
+
+  if (myConcaveQuad) {
+    inThreshold = 2.5; // 1.0 + 1.0 + 0.5
+  }
+
+  if (nbInMin >= inThreshold) {
+    return TopAbs_IN;
+  }
+  if (nbInMax < inThreshold) {
+    return TopAbs_OUT;
   }
+  return TopAbs_UNKNOWN;
 }
 //=======================================================================
 //function : CanBeON
@@ -30,6 +30,7 @@
 
 
 #include <GEOMAlgo_Clsf.hxx>
+#include <GEOMAlgo_PackedPlanes.hxx>
 
 #include <GeomAdaptor_Surface.hxx>
 #include <Standard_DefineHandle.hxx>
@@ -69,9 +70,26 @@ public:
   Standard_EXPORT
     virtual  void Perform();
 
+  Standard_EXPORT
+    virtual  void Perform(const gp_Pnt* pPnts,
+                          const Standard_Size aNbPnts,
+                          TopAbs_State* pStates) ;
+
   Standard_EXPORT
     virtual  void CheckData();
 
+  Standard_EXPORT
+    virtual  Handle(GEOMAlgo_Clsf) Copy() const;
+
+  Standard_EXPORT
+    virtual  Standard_Integer NbPntsPerBlock() const;
+
+  Standard_EXPORT
+    virtual  Standard_Boolean HasStateOfBox() const;
+
+  Standard_EXPORT
+    virtual  TopAbs_State StateOfBox(const Bnd_Box& aBox) const;
+
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Curve)& aC) const;
 
@@ -82,11 +100,22 @@ public:
 
 protected:
 
+  Standard_EXPORT
+    TopAbs_State ComputeState(const gp_Pnt& aP) const;
+
+  Standard_EXPORT
+    TopAbs_State ComputeState(const gp_Pnt& aP,
+                              const Standard_Integer aMaskIn,
+                              const Standard_Integer aMaskOut) const;
+
   bool                              myConcaveQuad;
   std::vector<bool>                 myConcaveSide;
   std::vector<gp_Pnt>               myPoints;
   std::vector<GeomAdaptor_Surface>  myPlanes;
   gp_Vec                            myQuadNormal;
+  // prepared by CheckData() for the batch classification
+  GEOMAlgo_PackedPlanes             myPackedPlanes;
+  std::vector<gp_Vec>               mySideVecs;
 
 };
 #endif
@@ -29,9 +29,26 @@
 #include <TopoDS.hxx>
 #include <TopoDS_Solid.hxx>
 
+#include <TopoDS_Edge.hxx>
+#include <TopoDS_Face.hxx>
+#include <TopoDS_Shell.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopExp_Explorer.hxx>
+
+#include <gp_Trsf.hxx>
+#include <Bnd_Box.hxx>
+#include <Poly_Array1OfTriangle.hxx>
+#include <Poly_Triangle.hxx>
+#include <Poly_Triangulation.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+
 #include <BRep_Builder.hxx>
+#include <BRep_Tool.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
 
+#include <GEOMAlgo_AlgoTools.hxx>
+
 IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 
 //=======================================================================
@@ -43,6 +60,9 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
   GEOMAlgo_Clsf()
 {
   myPClsf=NULL;
+  myUseBVH=Standard_False;
+  myBVHGap=0.;
+  myIsBVHUnavailable=Standard_False;
 }
 //=======================================================================
 //function : ~
@@ -64,6 +84,8 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
   void GEOMAlgo_ClsfSolid::SetShape(const TopoDS_Shape& aS)
 {
   myShape=aS;
+  myBVH.Nullify();
+  myIsBVHUnavailable=Standard_False;
 }
 //=======================================================================
 //function : Shape
@@ -74,6 +96,26 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
   return myShape;
 }
 //=======================================================================
+//function : SetUseBVH
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfSolid::SetUseBVH(const Standard_Boolean bFlag)
+{
+  myUseBVH=bFlag;
+  if (!myUseBVH) {
+    myBVH.Nullify();
+    myIsBVHUnavailable=Standard_False;
+  }
+}
+//=======================================================================
+//function : UseBVH
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfSolid::UseBVH() const
+{
+  return myUseBVH;
+}
+//=======================================================================
 //function : CheckData
 //purpose  :
 //=======================================================================
@@ -113,6 +155,10 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
   //
   pSC=new BRepClass3d_SolidClassifier(aS);
   myPClsf=pSC;
+  //
+  if (myUseBVH && myBVH.IsNull() && !myIsBVHUnavailable) {
+    BuildBVH(aS);
+  }
 }
 //=======================================================================
 //function : Perform
@@ -127,11 +173,186 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
     return;
   }
   //
+  myState=ComputeState(myPnt);
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfSolid::Perform(const gp_Pnt* pPnts,
+                                   const Standard_Size aNbPnts,
+                                   TopAbs_State* pStates)
+{
+  Standard_Size i;
+  //
+  myErrorStatus=0;
+  //
+  if (!myPClsf) {
+    myErrorStatus=11;
+    return;
+  }
+  //
+  for (i=0; i<aNbPnts; ++i) {
+    pStates[i]=ComputeState(pPnts[i]);
+  }
+}
+//=======================================================================
+//function : ComputeState
+//purpose  : 
+//=======================================================================
+  TopAbs_State GEOMAlgo_ClsfSolid::ComputeState(const gp_Pnt& aP) const
+{
+  Standard_Boolean bIsDegenerated;
+  Standard_Integer aNbHits;
+  Standard_Real aGap;
+  BRepClass3d_SolidClassifier* pSC;
+  //
+  if (!myBVH.IsNull()) {
+    aGap=myTolerance+myBVHGap;
+    if (myBVH->IsOut(aP, aGap)) {
+      return TopAbs_OUT;
+    }
+    if (!myBVH->IsNear(aP, aGap)) {
+      aNbHits=myBVH->NbRayHits(aP, bIsDegenerated);
+      if (!bIsDegenerated) {
+        return (aNbHits%2) ? TopAbs_IN : TopAbs_OUT;
+      }
+    }
+  }
+  //
+  pSC=(BRepClass3d_SolidClassifier*)myPClsf;
+  pSC->Perform(aP, myTolerance);
+  return pSC->State();
+}
+//=======================================================================
+//function : BuildBVH
+//purpose  : the BVH is not built (myBVH is null) if the solid can
+//           not be meshed, the deflection of the mesh is unknown or
+//           the solid is not closed or finite; myIsBVHUnavailable is
+//           set then, so the build is not tried again for the shape
+//=======================================================================
+  void GEOMAlgo_ClsfSolid::BuildBVH(const TopoDS_Solid& aS)
+{
+  Standard_Boolean bHasMesh;
+  Standard_Integer i, n1, n2, n3;
+  Standard_Real aDeflection, aTolMax, aTol, aXmin, aYmin, aZmin, aXmax,
+    aYmax, aZmax, aD;
+  TopLoc_Location aLoc;
+  TopExp_Explorer aExp;
+  Handle(Poly_Triangulation) aTR;
+  Handle(GEOMAlgo_TriangleBVH) aBVH;
+  Bnd_Box aBox;
   BRepClass3d_SolidClassifier* pSC;
   //
+  myBVH.Nullify();
+  myBVHGap=0.;
+  myIsBVHUnavailable=Standard_True;
+  //
+  // the parity of the crossings is valid for closed shells only
+  aExp.Init(aS, TopAbs_SHELL);
+  for (; aExp.More(); aExp.Next()) {
+    if (!BRep_Tool::IsClosed(aExp.Current())) {
+      return;
+    }
+  }
+  //
+  bHasMesh=Standard_True;
+  aExp.Init(aS, TopAbs_FACE);
+  for (; aExp.More() && bHasMesh; aExp.Next()) {
+    aTR=BRep_Tool::Triangulation(TopoDS::Face(aExp.Current()), aLoc);
+    bHasMesh=!aTR.IsNull();
+  }
+  if (!bHasMesh) {
+    if (!GEOMAlgo_AlgoTools::BuildTriangulation(aS)) {
+      return;
+    }
+  }
+  //
+  aBVH=new GEOMAlgo_TriangleBVH;
+  aDeflection=0.;
+  aExp.Init(aS, TopAbs_FACE);
+  for (; aExp.More(); aExp.Next()) {
+    const TopoDS_Face& aF=TopoDS::Face(aExp.Current());
+    aTR=BRep_Tool::Triangulation(aF, aLoc);
+    if (aTR.IsNull() || aTR->Deflection()<=0.) {
+      return;
+    }
+    aDeflection=Max(aDeflection, aTR->Deflection());
+    //
+    const gp_Trsf& aTrsf=aLoc.Transformation();
+    const TColgp_Array1OfPnt& aNodes=aTR->Nodes();
+    const Poly_Array1OfTriangle& aTrs=aTR->Triangles();
+    for (i=aTrs.Lower(); i<=aTrs.Upper(); ++i) {
+      aTrs(i).Get(n1, n2, n3);
+      const gp_Pnt aP1=aNodes(n1).Transformed(aTrsf);
+      const gp_Pnt aP2=aNodes(n2).Transformed(aTrsf);
+      const gp_Pnt aP3=aNodes(n3).Transformed(aTrsf);
+      aBVH->AddTriangle(aP1, aP2, aP3);
+      aBox.Add(aP1);
+      aBox.Add(aP2);
+      aBox.Add(aP3);
+    }
+  }
+  if (!aBVH->NbTriangles()) {
+    return;
+  }
+  //
+  // the points near the boundary are classified exactly
+  aTolMax=0.;
+  const TopAbs_ShapeEnum aTypes[3]={TopAbs_FACE, TopAbs_EDGE, TopAbs_VERTEX};
+  for (i=0; i<3; ++i) {
+    aExp.Init(aS, aTypes[i]);
+    for (; aExp.More(); aExp.Next()) {
+      const TopoDS_Shape& aSx=aExp.Current();
+      if (aTypes[i]==TopAbs_FACE) {
+        aTol=BRep_Tool::Tolerance(TopoDS::Face(aSx));
+      }
+      else if (aTypes[i]==TopAbs_EDGE) {
+        aTol=BRep_Tool::Tolerance(TopoDS::Edge(aSx));
+      }
+      else {
+        aTol=BRep_Tool::Tolerance(TopoDS::Vertex(aSx));
+      }
+      aTolMax=Max(aTolMax, aTol);
+    }
+  }
+  //
+  aBVH->Build();
+  //
+  // a point out of the box must be OUT, otherwise the solid
+  // is infinite (reversed) and the parity is not valid
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  aD=(aXmax-aXmin)+(aYmax-aYmin)+(aZmax-aZmin)+1.;
   pSC=(BRepClass3d_SolidClassifier*)myPClsf;
-  pSC->Perform(myPnt, myTolerance);
-  myState=pSC->State();
+  pSC->Perform(gp_Pnt(aXmax+aD, aYmax+aD, aZmax+aD), myTolerance);
+  if (pSC->State()!=TopAbs_OUT) {
+    return;
+  }
+  //
+  myBVH=aBVH;
+  myBVHGap=2.*aDeflection+aTolMax;
+  myIsBVHUnavailable=Standard_False;
+}
+//=======================================================================
+//function : Copy
+//purpose  : the copy has its own BRepClass3d_SolidClassifier,
+//           the BVH of the triangles is shared
+//=======================================================================
+  Handle(GEOMAlgo_Clsf) GEOMAlgo_ClsfSolid::Copy() const
+{
+  Handle(GEOMAlgo_ClsfSolid) aClsf;
+  //
+  aClsf=new GEOMAlgo_ClsfSolid();
+  aClsf->CopyFrom(*this);
+  aClsf->myShape=myShape;
+  aClsf->myUseBVH=myUseBVH;
+  aClsf->myBVH=myBVH;
+  aClsf->myBVHGap=myBVHGap;
+  aClsf->myIsBVHUnavailable=myIsBVHUnavailable;
+  if (myPClsf) {
+    aClsf->CheckData();
+  }
+  return aClsf;
 }
 //
 // myErrorStatus :
@@ -29,7 +29,9 @@
 #include <Standard_DefineHandle.hxx>
 #include <TopoDS_Shape.hxx>
 #include <Standard_Address.hxx>
+#include <TopoDS_Solid.hxx>
 #include <GEOMAlgo_Clsf.hxx>
+#include <GEOMAlgo_TriangleBVH.hxx>
 
 DEFINE_STANDARD_HANDLE(GEOMAlgo_ClsfSolid, GEOMAlgo_Clsf)
 
@@ -52,17 +54,52 @@ class GEOMAlgo_ClsfSolid : public GEOMAlgo_Clsf
   Standard_EXPORT
     const TopoDS_Shape& Shape() const;
 
+  //! Sets the mode of the classification by the triangulation: <br>
+  //!          CheckData() meshes the solid if needed and builds the BVH <br>
+  //!          of its triangles; the points far from the triangles are <br>
+  //!          classified by the parity of the number of the triangles <br>
+  //!          crossed by a ray, the points near the triangles (within <br>
+  //!          the deflection of the mesh and the tolerances) and the <br>
+  //!          ambiguous rays by BRepClass3d_SolidClassifier. <br>
+  //!          The mode is used for closed solids only. <br>
+  Standard_EXPORT
+    void SetUseBVH(const Standard_Boolean bFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean UseBVH() const;
+
   Standard_EXPORT
     virtual  void Perform() ;
 
+  Standard_EXPORT
+    virtual  void Perform(const gp_Pnt* pPnts,
+                          const Standard_Size aNbPnts,
+                          TopAbs_State* pStates) ;
+
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    virtual  Handle(GEOMAlgo_Clsf) Copy() const;
+
   DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ClsfSolid,GEOMAlgo_Clsf)
 
   protected:
+  Standard_EXPORT
+    void BuildBVH(const TopoDS_Solid& aS) ;
+
+  Standard_EXPORT
+    TopAbs_State ComputeState(const gp_Pnt& aP) const;
+
     TopoDS_Shape myShape;
   Standard_Address myPClsf;
+  Standard_Boolean myUseBVH;
+  // the triangles of myShape and the distance from them
+  // within which the points are classified exactly
+  Handle(GEOMAlgo_TriangleBVH) myBVH;
+  Standard_Real myBVHGap;
+  // the BVH can not be built for myShape
+  Standard_Boolean myIsBVHUnavailable;
 
 };
 #endif
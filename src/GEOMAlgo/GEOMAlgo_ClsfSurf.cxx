@@ -105,6 +105,66 @@ IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ClsfSurf, GEOMAlgo_Clsf);
   GEOMAlgo_SurfaceTools::GetState(myPnt, myGAS, myTolerance, myState);
 }
 //=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+  void GEOMAlgo_ClsfSurf::Perform(const gp_Pnt* pPnts,
+                                  const Standard_Size aNbPnts,
+                                  TopAbs_State* pStates)
+{
+  Standard_Size i;
+  //
+  myErrorStatus=0;
+  for (i=0; i<aNbPnts; ++i) {
+    GEOMAlgo_SurfaceTools::GetState(pPnts[i], myGAS, myTolerance, pStates[i]);
+  }
+}
+//=======================================================================
+//function : Copy
+//purpose  :
+//=======================================================================
+  Handle(GEOMAlgo_Clsf) GEOMAlgo_ClsfSurf::Copy() const
+{
+  Handle(GEOMAlgo_ClsfSurf) aClsf;
+  //
+  aClsf=new GEOMAlgo_ClsfSurf();
+  aClsf->CopyFrom(*this);
+  aClsf->myS=myS;
+  aClsf->myGAS=myGAS;
+  return aClsf;
+}
+//=======================================================================
+//function : NbPntsPerBlock
+//purpose  : the state of a point is cheap to compute
+//=======================================================================
+  Standard_Integer GEOMAlgo_ClsfSurf::NbPntsPerBlock() const
+{
+  return 64;
+}
+//=======================================================================
+//function : HasStateOfBox
+//purpose  :
+//=======================================================================
+  Standard_Boolean GEOMAlgo_ClsfSurf::HasStateOfBox() const
+{
+  return Standard_True;
+}
+//=======================================================================
+//function : StateOfBox
+//purpose  :
+//=======================================================================
+  TopAbs_State GEOMAlgo_ClsfSurf::StateOfBox(const Bnd_Box& aBox) const
+{
+  Standard_Integer iErr;
+  TopAbs_State aSt;
+  //
+  iErr=GEOMAlgo_SurfaceTools::GetState(aBox, myGAS, myTolerance, aSt);
+  if (iErr) {
+    return TopAbs_UNKNOWN;
+  }
+  return aSt;
+}
+//=======================================================================
 //function : CanBeON
 //purpose  :
 //=======================================================================
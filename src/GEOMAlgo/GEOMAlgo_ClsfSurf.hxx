@@ -60,9 +60,26 @@ class GEOMAlgo_ClsfSurf : public GEOMAlgo_Clsf
   Standard_EXPORT
     virtual  void Perform() ;
 
+  Standard_EXPORT
+    virtual  void Perform(const gp_Pnt* pPnts,
+                          const Standard_Size aNbPnts,
+                          TopAbs_State* pStates) ;
+
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    virtual  Handle(GEOMAlgo_Clsf) Copy() const;
+
+  Standard_EXPORT
+    virtual  Standard_Integer NbPntsPerBlock() const;
+
+  Standard_EXPORT
+    virtual  Standard_Boolean HasStateOfBox() const;
+
+  Standard_EXPORT
+    virtual  TopAbs_State StateOfBox(const Bnd_Box& aBox) const;
+
   Standard_EXPORT
     virtual  Standard_Boolean CanBeON(const Handle(Geom_Curve)& aC) const;
 
@@ -0,0 +1,121 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_ContextPool.cxx
+//
+#include <GEOMAlgo_ContextPool.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ContextPool, Standard_Transient);
+
+//=======================================================================
+//function : GEOMAlgo_ContextPool
+//purpose  :
+//=======================================================================
+GEOMAlgo_ContextPool::GEOMAlgo_ContextPool
+  (const Handle(IntTools_Context)& theContext)
+:
+  myContexts(0, 0),
+  myIsBusy(0, 0)
+{
+  myIsBusy(0)=Standard_False;
+  myContexts(0)=theContext;
+  if (myContexts(0).IsNull()) {
+    myContexts(0)=new IntTools_Context;
+  }
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_ContextPool::~GEOMAlgo_ContextPool()
+{
+}
+//=======================================================================
+//function : MainContext
+//purpose  :
+//=======================================================================
+const Handle(IntTools_Context)& GEOMAlgo_ContextPool::MainContext() const
+{
+  return myContexts(0);
+}
+//=======================================================================
+//function : Reserve
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ContextPool::Reserve(const Standard_Integer theNbSlots)
+{
+  Standard_Integer i, aNbOld;
+  //
+  aNbOld=myContexts.Length();
+  if (theNbSlots > aNbOld) {
+    myContexts.Resize(0, theNbSlots-1, Standard_True);
+    myIsBusy.Resize(0, theNbSlots-1, Standard_True);
+    for (i=aNbOld; i<theNbSlots; ++i) {
+      myIsBusy(i)=Standard_False;
+    }
+  }
+}
+//=======================================================================
+//function : NbSlots
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ContextPool::NbSlots() const
+{
+  return myContexts.Length();
+}
+//=======================================================================
+//function : Context
+//purpose  :
+//=======================================================================
+const Handle(IntTools_Context)&
+  GEOMAlgo_ContextPool::Context(const Standard_Integer theSlot)
+{
+  Handle(IntTools_Context)& aCtx=myContexts(theSlot);
+  if (aCtx.IsNull()) {
+    aCtx=new IntTools_Context;
+  }
+  return aCtx;
+}
+//=======================================================================
+//function : Acquire
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ContextPool::Acquire()
+{
+  Standard_Integer i, aNb;
+  //
+  Standard_Mutex::Sentry aSentry(myMutex);
+  aNb=myIsBusy.Length();
+  for (i=0; i<aNb; ++i) {
+    if (!myIsBusy(i)) {
+      myIsBusy(i)=Standard_True;
+      return i;
+    }
+  }
+  return -1;
+}
+//=======================================================================
+//function : Release
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ContextPool::Release(const Standard_Integer theSlot)
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  myIsBusy(theSlot)=Standard_False;
+}
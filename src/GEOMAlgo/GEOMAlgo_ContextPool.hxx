@@ -0,0 +1,93 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_ContextPool.hxx
+//
+#ifndef _GEOMAlgo_ContextPool_HeaderFile
+#define _GEOMAlgo_ContextPool_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <IntTools_Context.hxx>
+#include <NCollection_Array1.hxx>
+#include <Standard_Mutex.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_ContextPool, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_ContextPool
+//purpose  : The contexts (IntTools_Context) of the parallel workers.
+//           IntTools_Context caches the projectors, classifiers and
+//           hatchers and can not be used by two threads at once, so
+//           each worker takes the context of its own slot.
+//           The slot 0 is the main context of the algorithm, the
+//           other contexts are created at the first use and kept,
+//           so the next parallel loops reuse their caches.
+//           A worker takes a free slot by Acquire() and gives it back
+//           by Release(), so the chunks run by one thread share one
+//           context; the pool needs one slot per thread (see
+//           GEOMAlgo_AlgoTools::NbSlots), a worker that finds no free
+//           slot uses a local context.
+//=======================================================================
+class GEOMAlgo_ContextPool : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_ContextPool(const Handle(IntTools_Context)& theContext);
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_ContextPool();
+
+  //! Returns the context of the slot 0 <br>
+  Standard_EXPORT
+    const Handle(IntTools_Context)& MainContext() const;
+
+  //! Makes at least theNbSlots slots. <br>
+  //!          Must not be called while the workers run. <br>
+  Standard_EXPORT
+    void Reserve(const Standard_Integer theNbSlots) ;
+
+  Standard_EXPORT
+    Standard_Integer NbSlots() const;
+
+  //! Returns the context of the slot theSlot, 0 <= theSlot < NbSlots(). <br>
+  //!          A slot must be used by one thread at a time. <br>
+  Standard_EXPORT
+    const Handle(IntTools_Context)& Context(const Standard_Integer theSlot) ;
+
+  //! Takes the free slot with the lowest index and returns it. <br>
+  //!          The slots must be reserved for all workers that can <br>
+  //!          run at once, -1 is returned if there is no free slot. <br>
+  Standard_EXPORT
+    Standard_Integer Acquire() ;
+
+  //! Gives back the slot theSlot taken by Acquire() <br>
+  Standard_EXPORT
+    void Release(const Standard_Integer theSlot) ;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ContextPool, Standard_Transient)
+
+ protected:
+  NCollection_Array1<Handle(IntTools_Context)> myContexts;
+  NCollection_Array1<Standard_Boolean> myIsBusy;
+  Standard_Mutex myMutex;
+};
+#endif
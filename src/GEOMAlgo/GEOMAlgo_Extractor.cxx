@@ -27,25 +27,192 @@
 
 
 #include <GEOMAlgo_Extractor.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
 
 #include <BRep_Builder.hxx>
 #include <BRep_Tool.hxx>
 #include <BRepClass3d.hxx>
 #include <BRepTools.hxx>
 #include <BRepTools_WireExplorer.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_DataMap.hxx>
 #include <NCollection_Sequence.hxx>
+#include <NCollection_Vector.hxx>
+#include <OSD_Parallel.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TColStd_MapIteratorOfPackedMapOfInteger.hxx>
 #include <TColStd_MapOfInteger.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Iterator.hxx>
+#include <TopTools_DataMapIteratorOfDataMapOfShapeListOfShape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <TopTools_ListIteratorOfListOfShape.hxx>
 #include <TopTools_MapIteratorOfMapOfShape.hxx>
 #include <TopTools_MapOfShape.hxx>
 
+#include <algorithm>
+
+//=======================================================================
+//class    : GEOMAlgo_ExtractorBatchFunctor
+//purpose  : extracts the chunk of the sets of sub-shapes
+//=======================================================================
+class GEOMAlgo_ExtractorBatchFunctor
+{
+ public:
+  GEOMAlgo_ExtractorBatchFunctor
+    (const TopoDS_Shape                             &theShape,
+     const Handle(GEOMAlgo_ShapeAncestors)          &theAncestors,
+     const NCollection_Vector<TopTools_ListOfShape> &theSets,
+           NCollection_Vector<TopoDS_Shape>         &theResults,
+           NCollection_Vector<Standard_Integer>     &theErrors,
+     const Standard_Integer                          theNbChunks)
+  : myShape(theShape),
+    myAncestors(theAncestors),
+    mySets(theSets),
+    myResults(theResults),
+    myErrors(theErrors),
+    myNbChunks(theNbChunks)
+  {
+  }
+
+  void operator()(const Standard_Integer theChunk) const
+  {
+    const Standard_Integer aNb = mySets.Length();
+    GEOMAlgo_Extractor     anExtractor;
+    Standard_Integer       i, i1, i2;
+
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 0, aNb - 1, i1, i2);
+
+    // The extractor of the chunk shares the index of the main shape.
+    anExtractor.SetShape(myShape);
+    anExtractor.SetAncestors(myAncestors);
+
+    for (i = i1; i <= i2; ++i) {
+      anExtractor.SetShapesToRemove(mySets(i));
+      anExtractor.Perform();
+
+      myErrors.ChangeValue(i)  = anExtractor.ErrorStatus();
+      myResults.ChangeValue(i) = anExtractor.GetResult();
+    }
+  }
+
+ private:
+  const TopoDS_Shape                             &myShape;
+  const Handle(GEOMAlgo_ShapeAncestors)          &myAncestors;
+  const NCollection_Vector<TopTools_ListOfShape> &mySets;
+  NCollection_Vector<TopoDS_Shape>               &myResults;
+  NCollection_Vector<Standard_Integer>           &myErrors;
+  Standard_Integer                                myNbChunks;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_ExtractorLevelFunctor
+//purpose  : processes the chunk of the modified shapes of one level
+//=======================================================================
+class GEOMAlgo_ExtractorLevelFunctor
+{
+ public:
+  GEOMAlgo_ExtractorLevelFunctor
+    (GEOMAlgo_Extractor                                     &theExtractor,
+     const NCollection_Vector<Standard_Integer>             &theIds,
+     NCollection_Array1<TopTools_DataMapOfShapeListOfShape> &theMaps,
+     const Standard_Integer                                  theNbChunks)
+  : myExtractor(theExtractor),
+    myIds(theIds),
+    myMaps(theMaps),
+    myNbChunks(theNbChunks)
+  {
+  }
+
+  void operator()(const Standard_Integer theChunk) const
+  {
+    const Standard_Integer aNb = myIds.Length();
+    Standard_Integer       i, i1, i2;
+
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 0, aNb - 1, i1, i2);
+
+    // The new shapes of the chunk are kept apart up to the end
+    // of the level.
+    TopTools_DataMapOfShapeListOfShape &aMapNewShapeAnc =
+      myMaps.ChangeValue(theChunk);
+
+    for (i = i1; i <= i2; ++i) {
+      TopoDS_Shape aShape = myExtractor.myAncestors->SubShape(myIds(i));
+
+      aShape.Orientation(TopAbs_FORWARD);
+      myExtractor.processShape(aShape, aMapNewShapeAnc);
+    }
+  }
+
+ private:
+  GEOMAlgo_Extractor                                     &myExtractor;
+  const NCollection_Vector<Standard_Integer>             &myIds;
+  NCollection_Array1<TopTools_DataMapOfShapeListOfShape> &myMaps;
+  Standard_Integer                                        myNbChunks;
+};
+
+//=======================================================================
+//function : CompoundLevel
+//purpose  : returns the nesting level of the modified compound theId:
+//           0 if there is no modified compound in it, otherwise
+//           the level of its deepest modified compound plus 1
+//=======================================================================
+static Standard_Integer CompoundLevel
+  (const Handle(GEOMAlgo_ShapeAncestors)                   &theAncestors,
+   const TColStd_PackedMapOfInteger                        &theModifiedIds,
+   const Standard_Integer                                   theId,
+   NCollection_DataMap<Standard_Integer, Standard_Integer> &theLevels)
+{
+  const Standard_Integer *pLevel = theLevels.Seek(theId);
+
+  if (pLevel) {
+    return *pLevel;
+  }
+
+  const Standard_Integer aNbSub = theAncestors->NbSubShapes(theId);
+  Standard_Integer       i, aLevel = 0;
+
+  for (i = 1; i <= aNbSub; ++i) {
+    const Standard_Integer aSubId = theAncestors->SubShapeIndex(theId, i);
+
+    if (theModifiedIds.Contains(aSubId) &&
+        theAncestors->SubShape(aSubId).ShapeType() == TopAbs_COMPOUND) {
+      aLevel = Max(aLevel, CompoundLevel(theAncestors, theModifiedIds,
+                                         aSubId, theLevels) + 1);
+    }
+  }
+
+  theLevels.Bind(theId, aLevel);
+
+  return aLevel;
+}
+
+//=======================================================================
+//class    : GEOMAlgo_ExtractorLevelLess
+//purpose  : compares the indices of the compounds by their nesting level
+//=======================================================================
+class GEOMAlgo_ExtractorLevelLess
+{
+ public:
+  GEOMAlgo_ExtractorLevelLess
+    (const NCollection_DataMap<Standard_Integer, Standard_Integer> &theLevels)
+  : myLevels(theLevels)
+  {
+  }
+
+  bool operator()(const Standard_Integer theId1,
+                  const Standard_Integer theId2) const
+  {
+    return myLevels.Find(theId1) < myLevels.Find(theId2);
+  }
+
+ private:
+  const NCollection_DataMap<Standard_Integer, Standard_Integer> &myLevels;
+};
 
 //=======================================================================
 //function : GEOMAlgo_Extractor
@@ -70,10 +237,33 @@ GEOMAlgo_Extractor::~GEOMAlgo_Extractor()
 void GEOMAlgo_Extractor::SetShape(const TopoDS_Shape &theShape)
 {
   myShape = theShape;
-  myMapShapeAnc.Clear();
   clear();
 }
 
+//=======================================================================
+//function : SetAncestors
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::SetAncestors
+                        (const Handle(GEOMAlgo_ShapeAncestors) &theAncestors)
+{
+  myAncestors = theAncestors;
+}
+
+//=======================================================================
+//function : Prepare
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::Prepare()
+{
+  if (myAncestors.IsNull() || !myAncestors->IsValidFor(myShape)) {
+    // The index that is set may be shared. Make a new one.
+    myAncestors = new GEOMAlgo_ShapeAncestors;
+    myAncestors->SetShape(myShape);
+    myAncestors->Perform();
+  }
+}
+
 //=======================================================================
 //function : SetShapesToRemove
 //purpose  :
@@ -92,9 +282,12 @@ void GEOMAlgo_Extractor::SetShapesToRemove
 void GEOMAlgo_Extractor::Perform()
 {
   clear();
+  ClearPhases();
   myErrorStatus = 0;
   //
+  BeginPhase("CheckData");
   checkData();
+  EndPhase();
 
   if(myErrorStatus) {
     return;
@@ -107,35 +300,56 @@ void GEOMAlgo_Extractor::Perform()
   }
 
   // Mark sub-shapes as removed and modified.
+  BeginPhase("MarkShapes");
   markShapes();
+  AddPhaseShapes(myRemovedIds.Extent() + myModifiedIds.Extent());
+  EndPhase();
 
   // Process Edges.
+  BeginPhase("ProcessEdges");
   processShapes(TopAbs_EDGE);
+  EndPhase();
 
   // Process Wires.
+  BeginPhase("ProcessWires");
   processShapes(TopAbs_WIRE);
+  EndPhase();
 
   // Process Faces.
+  BeginPhase("ProcessFaces");
   processShapes(TopAbs_FACE);
+  EndPhase();
 
   // Process Shells.
+  BeginPhase("ProcessShells");
   processShapes(TopAbs_SHELL);
+  EndPhase();
 
   // Process Solids.
+  BeginPhase("ProcessSolids");
   processShapes(TopAbs_SOLID);
+  EndPhase();
 
   // Process Comp-Solids.
+  BeginPhase("ProcessCompSolids");
   processShapes(TopAbs_COMPSOLID);
+  EndPhase();
 
   // Process Compounds.
+  BeginPhase("ProcessCompounds");
   processShapes(TopAbs_COMPOUND);
+  EndPhase();
 
   // Make the result.
+  BeginPhase("MakeResult");
   myResult = makeResult(myShape);
+  EndPhase();
 
   TopTools_MapOfShape aMapFence;
 
+  BeginPhase("MakeHistory");
   makeHistory(myShape, aMapFence);
+  EndPhase();
 }
 
 //=======================================================================
@@ -147,6 +361,52 @@ const TopoDS_Shape &GEOMAlgo_Extractor::GetResult() const
   return myResult;
 }
 
+//=======================================================================
+//function : PerformBatch
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::PerformBatch
+                        (const NCollection_Vector<TopTools_ListOfShape> &theSets)
+{
+  const Standard_Integer aNbSets = theSets.Length();
+  Standard_Integer       i, aNbChunks;
+
+  clear();
+  ClearPhases();
+  myErrorStatus = 0;
+  myBatchResults.Clear();
+  myBatchErrors.Clear();
+
+  if (myShape.IsNull()) {
+    myErrorStatus = 10;
+    return;
+  }
+
+  // Prepare the main shape once for all the sets.
+  BeginPhase("Prepare");
+  Prepare();
+  EndPhase();
+
+  for (i = 0; i < aNbSets; ++i) {
+    myBatchResults.Append(TopoDS_Shape());
+    myBatchErrors.Append(0);
+  }
+
+  if (!aNbSets) {
+    return;
+  }
+
+  aNbChunks = GEOMAlgo_AlgoTools::NbChunks(aNbSets, myRunParallel);
+
+  BeginPhase("ExtractSets");
+  GEOMAlgo_ExtractorBatchFunctor aFunctor(myShape, myAncestors, theSets,
+                                          myBatchResults, myBatchErrors,
+                                          aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks == 1);
+  AddPhaseShapes(aNbSets);
+  EndPhase();
+}
+
 //=======================================================================
 //function : clear
 //purpose  :
@@ -159,7 +419,8 @@ void GEOMAlgo_Extractor::clear()
   myRemoved.Clear();
   myModified.Clear();
   myNew.Clear();
-  myMapRemoved.Clear();
+  myRemovedIds.Clear();
+  myModifiedIds.Clear();
   myMapModified.Clear();
   myMapNewShapeAnc.Clear();
 }
@@ -180,24 +441,26 @@ void GEOMAlgo_Extractor::checkData()
     return;
   }
 
+  // Fill the indices of shapes and their ancestors.
+  Prepare();
+
   TopTools_ListIteratorOfListOfShape anIter(mySubShapes);
-  TopTools_IndexedMapOfShape         anIndices;
   TopTools_MapOfShape                aMapFence;
 
-  TopExp::MapShapes(myShape, anIndices);
-
   while (anIter.More()) {
     const TopoDS_Shape &aSubShape = anIter.Value();
 
     if (aMapFence.Add(aSubShape)) {
+      const Standard_Integer anId = myAncestors->Index(aSubShape);
+
       // Check if it is a sub-shape of the given shape.
-      if (!anIndices.Contains(aSubShape)) {
+      if (anId == 0) {
         myErrorStatus = 11;
         return;
       }
 
       // Check if it is a main shape.
-      if (aSubShape.IsSame(myShape)) {
+      if (anId == 1) {
         myErrorStatus = 12;
         return;
       }
@@ -209,11 +472,6 @@ void GEOMAlgo_Extractor::checkData()
     }
   }
 
-  if (myMapShapeAnc.IsEmpty()) {
-    // Fill the map of shapes - ancestors.
-    makeMapShapeAncestors(myShape);
-  }
-
   // Check if there are seam or degenerated edges on faces.
   for (anIter.Initialize(mySubShapes); anIter.More(); anIter.Next()) {
     const TopoDS_Shape &aSubShape = anIter.Value();
@@ -222,16 +480,16 @@ void GEOMAlgo_Extractor::checkData()
       // Get the list of ancestor wires.
       TopTools_ListOfShape               anAncWires;
       TopTools_ListIteratorOfListOfShape anAncIt;
+      const Standard_Integer             anId = myAncestors->Index(aSubShape);
+      const Standard_Integer             aNbAnc = myAncestors->NbAncestors(anId);
+      Standard_Integer                   i;
 
-      if (myMapShapeAnc.IsBound(aSubShape)) {
-        anAncIt.Initialize(myMapShapeAnc.Find(aSubShape));
+      for (i = 1; i <= aNbAnc; ++i) {
+        const TopoDS_Shape &anAncShape =
+          myAncestors->SubShape(myAncestors->Ancestor(anId, i));
 
-        for (; anAncIt.More(); anAncIt.Next()) {
-          const TopoDS_Shape &anAncShape = anAncIt.Value();
-
-          if (anAncShape.ShapeType() == TopAbs_WIRE) {
-            anAncWires.Append(anAncShape);
-          }
+        if (anAncShape.ShapeType() == TopAbs_WIRE) {
+          anAncWires.Append(anAncShape);
         }
       }
 
@@ -266,34 +524,15 @@ void GEOMAlgo_Extractor::checkData()
 }
 
 //=======================================================================
-//function : makeMapShapeAncestors
+//function : isRemoved
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::makeMapShapeAncestors(const TopoDS_Shape &theShape)
+Standard_Boolean GEOMAlgo_Extractor::isRemoved
+                        (const TopoDS_Shape &theShape) const
 {
-  if (theShape.ShapeType() == TopAbs_VERTEX) {
-    // Vertex is the lowest type. It has no ancestors.
-    return;
-  }
-
-  TopoDS_Iterator     anIter(theShape);
-  TopTools_MapOfShape aMapFence;
+  const Standard_Integer anId = myAncestors->Index(theShape);
 
-  for (; anIter.More(); anIter.Next()) {
-    const TopoDS_Shape &aSubShape = anIter.Value();
-
-    if (aMapFence.Add(aSubShape)) {
-      // Add theShape as an ancestor shape.
-      if (!myMapShapeAnc.IsBound(aSubShape)) {
-        myMapShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
-      }
-
-      myMapShapeAnc.ChangeFind(aSubShape).Append(theShape);
-
-      // Recursively call this method for a sub-shape.
-      makeMapShapeAncestors(aSubShape);
-    }
-  }
+  return anId > 0 && myRemovedIds.Contains(anId);
 }
 
 //=======================================================================
@@ -308,14 +547,14 @@ void GEOMAlgo_Extractor::markShapes()
   for (; anIter.More(); anIter.Next()) {
     const TopoDS_Shape &aSubShape = anIter.Value();
 
-    markRemoved(aSubShape);
+    markRemoved(myAncestors->Index(aSubShape));
   }
 
   // Mark undestors of sub-shapes as modified.
   for (anIter.Initialize(mySubShapes); anIter.More(); anIter.Next()) {
     const TopoDS_Shape &aSubShape = anIter.Value();
 
-    markAncestorsModified(aSubShape);
+    markAncestorsModified(myAncestors->Index(aSubShape));
   }
 }
 
@@ -323,34 +562,28 @@ void GEOMAlgo_Extractor::markShapes()
 //function : markRemoved
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::markRemoved(const TopoDS_Shape &theShape)
+void GEOMAlgo_Extractor::markRemoved(const Standard_Integer theId)
 {
-  if (myMapRemoved.Add(theShape)) {
+  if (myRemovedIds.Add(theId)) {
     // Check sub-shapes.
-    TopoDS_Iterator     anIter(theShape);
-    TopTools_MapOfShape aMapFence;
-
-    for (; anIter.More(); anIter.Next()) {
-      const TopoDS_Shape &aSubShape = anIter.Value();
+    const Standard_Integer aNbSub = myAncestors->NbSubShapes(theId);
+    Standard_Integer       i, j;
 
-      if (aMapFence.Add(aSubShape)) {
-        TopTools_ListIteratorOfListOfShape anAncIt
-                                (myMapShapeAnc.Find(aSubShape));
-        Standard_Boolean                   isToRm = Standard_True;
-
-        for (; anAncIt.More(); anAncIt.Next()) {
-          const TopoDS_Shape &anAncShape = anAncIt.Value();
+    for (i = 1; i <= aNbSub; ++i) {
+      const Standard_Integer aSubId = myAncestors->SubShapeIndex(theId, i);
+      const Standard_Integer aNbAnc = myAncestors->NbAncestors(aSubId);
+      Standard_Boolean       isToRm = Standard_True;
 
-          if (!myMapRemoved.Contains(anAncShape)) {
-            isToRm = Standard_False;
-            break;
-          }
+      for (j = 1; j <= aNbAnc; ++j) {
+        if (!myRemovedIds.Contains(myAncestors->Ancestor(aSubId, j))) {
+          isToRm = Standard_False;
+          break;
         }
+      }
 
-        if (isToRm) {
-          // Mark sub-shape as removed.
-          markRemoved(aSubShape);
-        }
+      if (isToRm) {
+        // Mark sub-shape as removed.
+        markRemoved(aSubId);
       }
     }
   }
@@ -360,22 +593,20 @@ void GEOMAlgo_Extractor::markRemoved(const TopoDS_Shape &theShape)
 //function : markAncestorsModified
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::markAncestorsModified(const TopoDS_Shape &theShape)
+void GEOMAlgo_Extractor::markAncestorsModified(const Standard_Integer theId)
 {
-  if (myMapShapeAnc.IsBound(theShape)) {
-    TopTools_ListIteratorOfListOfShape anAncIt(myMapShapeAnc.Find(theShape));
+  const Standard_Integer aNbAnc = myAncestors->NbAncestors(theId);
+  Standard_Integer       i;
 
-    for (; anAncIt.More(); anAncIt.Next()) {
-      const TopoDS_Shape &anAncShape = anAncIt.Value();
+  for (i = 1; i <= aNbAnc; ++i) {
+    const Standard_Integer anAncId = myAncestors->Ancestor(theId, i);
 
-      if (!myMapRemoved.Contains(anAncShape) &&
-          !myMapModified.IsBound(anAncShape)) {
-        // Mark anAncShape as modified.
-        myMapModified.Bind(anAncShape, TopTools_ListOfShape());
+    if (!myRemovedIds.Contains(anAncId) && myModifiedIds.Add(anAncId)) {
+      // Mark the ancestor as modified.
+      myMapModified.Bind(myAncestors->SubShape(anAncId), TopTools_ListOfShape());
 
-        // Mark its ancestors as modified.
-        markAncestorsModified(anAncShape);
-      }
+      // Mark its ancestors as modified.
+      markAncestorsModified(anAncId);
     }
   }
 }
@@ -386,56 +617,181 @@ void GEOMAlgo_Extractor::markAncestorsModified(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_Extractor::processShapes(const TopAbs_ShapeEnum &theType)
 {
-  TopExp_Explorer     anExp(myShape, theType);
-  TopTools_MapOfShape aMapFence;
+  // Only the modified shapes are visited.
+  NCollection_Vector<Standard_Integer> anIds;
+  Standard_Integer                     i, aNbChunks;
 
-  for (; anExp.More(); anExp.Next()) {
-    TopoDS_Shape aShape = anExp.Current(); // Copy
+  getModifiedIds(theType, anIds);
 
-    if (aMapFence.Add(aShape)) {
-      if (myMapRemoved.Contains(aShape) ||
-          !myMapModified.IsBound(aShape)) {
-        // Skip removed or not modified shape.
-        continue;
-      }
+  const Standard_Integer aNbProcessed = anIds.Length();
+
+  // The compounds may be nested, a compound takes the modified shapes
+  // of its compounds, so they are processed serially.
+  aNbChunks = (theType == TopAbs_COMPOUND) ? 1 :
+    GEOMAlgo_AlgoTools::NbChunks(aNbProcessed, myRunParallel);
+
+  if (aNbChunks == 1) {
+    for (i = 0; i < aNbProcessed; ++i) {
+      TopoDS_Shape aShape = myAncestors->SubShape(anIds(i)); // Copy
 
       aShape.Orientation(TopAbs_FORWARD);
+      processShape(aShape, myMapNewShapeAnc);
+    }
+  } else {
+    // Process the chunks of shapes concurrently.
+    NCollection_Array1<TopTools_DataMapOfShapeListOfShape> aMaps
+                                                    (0, aNbChunks - 1);
+    GEOMAlgo_ExtractorLevelFunctor aFunctor(*this, anIds, aMaps, aNbChunks);
 
-      switch(theType) {
-        case TopAbs_EDGE:
-          processEdge(aShape);
-          break;
-        case TopAbs_WIRE:
-          processWire(aShape);
-          break;
-        case TopAbs_FACE:
-        case TopAbs_SOLID:
-          processFOrSo(aShape);
-          break;
-        case TopAbs_SHELL:
-        case TopAbs_COMPSOLID:
-          processShOrCS(aShape);
-          break;
-        case TopAbs_COMPOUND:
-          processCompound(aShape);
-          break;
-        default:
-          break;
+    OSD_Parallel::For(0, aNbChunks, aFunctor);
+
+    // Merge the new shapes - ancestors in the order of the chunks.
+    // A shape made by a chunk that is the same as a shape made by
+    // the previous chunks is replaced by the latter, as in the serial mode.
+    for (i = 0; i < aNbChunks; ++i) {
+      TopTools_MapOfShape aMapReplaced;
+
+      if (i > 0) {
+        reuseShapes(anIds, i, aNbChunks, aMaps(i), aMapReplaced);
+      }
+
+      TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aMapIt(aMaps(i));
+
+      for (; aMapIt.More(); aMapIt.Next()) {
+        const TopoDS_Shape                 &aSubShape = aMapIt.Key();
+        TopTools_ListIteratorOfListOfShape  anAncIt(aMapIt.Value());
+
+        for (; anAncIt.More(); anAncIt.Next()) {
+          const TopoDS_Shape &anAncestor = anAncIt.Value();
+
+          if (aMapReplaced.Contains(anAncestor)) {
+            continue;
+          }
+
+          if (!myMapNewShapeAnc.IsBound(aSubShape)) {
+            myMapNewShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
+          }
+
+          myMapNewShapeAnc.ChangeFind(aSubShape).Append(anAncestor);
+        }
       }
     }
   }
 
+  AddPhaseShapes(aNbProcessed);
+
   if (theType == TopAbs_FACE || theType == TopAbs_SOLID) {
     // Clear duplicated edges from the faces and faces from solids
     removeBoundsOnFOrSo(theType);
   }
 }
 
+//=======================================================================
+//function : reuseShapes
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::reuseShapes
+            (const NCollection_Vector<Standard_Integer>  &theIds,
+             const Standard_Integer                       theChunk,
+             const Standard_Integer                       theNbChunks,
+             const TopTools_DataMapOfShapeListOfShape    &theMapNewShapeAnc,
+                   TopTools_MapOfShape                   &theMapReplaced)
+{
+  // Collect the shapes made by the chunk.
+  TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aMapIt(theMapNewShapeAnc);
+  TopTools_MapOfShape                                 aMapNew;
+  Standard_Integer                                    i, i1, i2;
+
+  for (; aMapIt.More(); aMapIt.Next()) {
+    TopTools_ListIteratorOfListOfShape anAncIt(aMapIt.Value());
+
+    for (; anAncIt.More(); anAncIt.Next()) {
+      aMapNew.Add(anAncIt.Value());
+    }
+  }
+
+  GEOMAlgo_AlgoTools::ChunkBounds(theChunk, theNbChunks,
+                                  0, theIds.Length() - 1, i1, i2);
+
+  for (i = i1; i <= i2; ++i) {
+    const TopoDS_Shape   &aShape     = myAncestors->SubShape(theIds(i));
+    TopTools_ListOfShape *pNewShapes = myMapModified.ChangeSeek(aShape);
+
+    if (!pNewShapes) {
+      continue;
+    }
+
+    TopTools_ListIteratorOfListOfShape anIter(*pNewShapes);
+
+    for (; anIter.More(); anIter.Next()) {
+      TopoDS_Shape &aNewShape = anIter.ChangeValue();
+
+      if (!aMapNew.Contains(aNewShape)) {
+        // The shape is not made by the chunk.
+        continue;
+      }
+
+      // Look for the same shape among the ones of the previous chunks.
+      TopoDS_Iterator      aSubIt(aNewShape);
+      TopTools_ListOfShape aSubShapes;
+
+      for (; aSubIt.More(); aSubIt.Next()) {
+        aSubShapes.Append(aSubIt.Value());
+      }
+
+      if (aSubShapes.IsEmpty()) {
+        continue;
+      }
+
+      const TopoDS_Shape aSameShape =
+        getShapeFromSubShapes(aNewShape, aSubShapes, myMapNewShapeAnc);
+
+      if (!aSameShape.IsNull()) {
+        theMapReplaced.Add(aNewShape);
+        aNewShape = aSameShape;
+      }
+    }
+  }
+}
+
+//=======================================================================
+//function : processShape
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::processShape
+                     (const TopoDS_Shape                 &theShape,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
+{
+  switch(theShape.ShapeType()) {
+    case TopAbs_EDGE:
+      processEdge(theShape, theMapNewShapeAnc);
+      break;
+    case TopAbs_WIRE:
+      processWire(theShape, theMapNewShapeAnc);
+      break;
+    case TopAbs_FACE:
+    case TopAbs_SOLID:
+      processFOrSo(theShape, theMapNewShapeAnc);
+      break;
+    case TopAbs_SHELL:
+    case TopAbs_COMPSOLID:
+      processShOrCS(theShape, theMapNewShapeAnc);
+      break;
+    case TopAbs_COMPOUND:
+      processCompound(theShape, theMapNewShapeAnc);
+      break;
+    default:
+      break;
+  }
+}
+
 //=======================================================================
 //function : processEdge
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
+void GEOMAlgo_Extractor::processEdge
+                     (const TopoDS_Shape                 &theEdge,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   TopoDS_Iterator      anIter(theEdge);
   TopTools_MapOfShape  aMapFence;
@@ -445,7 +801,7 @@ void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
     const TopoDS_Shape &aShapeVertex = anIter.Value();
 
     if (aMapFence.Add(aShapeVertex)) {
-      if (myMapRemoved.Contains(aShapeVertex)) {
+      if (isRemoved(aShapeVertex)) {
         // This vertex is removed.
         const TopAbs_Orientation anOri = aShapeVertex.Orientation();
 
@@ -460,7 +816,7 @@ void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
     }
   }
 
-  TopoDS_Shape aNewEdge = makeShape(theEdge, aVtxList);
+  TopoDS_Shape aNewEdge = makeShape(theEdge, aVtxList, theMapNewShapeAnc);
 
   myMapModified.ChangeFind(theEdge).Append(aNewEdge);
 }
@@ -469,16 +825,22 @@ void GEOMAlgo_Extractor::processEdge(const TopoDS_Shape &theEdge)
 //function : processWire
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
+void GEOMAlgo_Extractor::processWire
+                     (const TopoDS_Shape                 &theWire,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   // Get parent face for the wire.
   TopoDS_Face aFace;
 
-  if (myMapShapeAnc.IsBound(theWire)) {
-    TopTools_ListIteratorOfListOfShape anIter(myMapShapeAnc.Find(theWire));
+  const Standard_Integer anId = myAncestors->Index(theWire);
 
-    for (; anIter.More(); anIter.Next()) {
-      const TopoDS_Shape &aParent = anIter.Value();
+  if (anId > 0) {
+    const Standard_Integer aNbAnc = myAncestors->NbAncestors(anId);
+    Standard_Integer       i;
+
+    for (i = 1; i <= aNbAnc; ++i) {
+      const TopoDS_Shape &aParent =
+        myAncestors->SubShape(myAncestors->Ancestor(anId, i));
 
       if (aParent.ShapeType() == TopAbs_FACE) {
         aFace = TopoDS::Face(aParent.Oriented(TopAbs_FORWARD));
@@ -495,7 +857,7 @@ void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
   for (; anExp.More(); anExp.Next()) {
     const TopoDS_Edge &anEdge = anExp.Current();
 
-    if (myMapRemoved.Contains(anEdge)) {
+    if (isRemoved(anEdge)) {
       // This edge is removed.
       if (!aListEdges.IsEmpty()) {
         aListListEdges.Append(aListEdges);
@@ -531,7 +893,7 @@ void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
   if (!aListListEdges.IsEmpty()) {
     TopTools_ListOfShape aListWires;
 
-    makeWires(theWire, aListListEdges, aListWires);
+    makeWires(theWire, aListListEdges, aListWires, theMapNewShapeAnc);
     myMapModified.ChangeFind(theWire) = aListWires;
   }
 }
@@ -540,7 +902,9 @@ void GEOMAlgo_Extractor::processWire(const TopoDS_Shape &theWire)
 //function : processFOrSo
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
+void GEOMAlgo_Extractor::processFOrSo
+                     (const TopoDS_Shape                 &theFOrSo,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   Standard_Boolean     isToCreate = Standard_True;
   TopTools_ListOfShape aClosedSubShapes;
@@ -560,7 +924,7 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
   }
 
   // Process an outer sub-shape.
-  if (myMapRemoved.Contains(anOuterSubShape)) {
+  if (isRemoved(anOuterSubShape)) {
     isToCreate = Standard_False;
   } else if (myMapModified.IsBound(anOuterSubShape)) {
     TopTools_ListOfShape aModifSubShapes;
@@ -641,7 +1005,7 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
           aNewShapes.Append(aNewShape);
         }
       }
-    } else if (!myMapRemoved.Contains(aSubShape)) {
+    } else if (!isRemoved(aSubShape)) {
       // The shape is not modified.
       if (isToCreate) {
         aClosedSubShapes.Append(aSubShape);
@@ -653,7 +1017,8 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
 
   if (isToCreate) {
     // Create a new shape.
-    TopoDS_Shape aNewShape = makeShape(theFOrSo, aClosedSubShapes);
+    TopoDS_Shape aNewShape = makeShape(theFOrSo, aClosedSubShapes,
+                                       theMapNewShapeAnc);
 
     aNewShapes.Prepend(aNewShape);
   }
@@ -668,7 +1033,9 @@ void GEOMAlgo_Extractor::processFOrSo(const TopoDS_Shape &theFOrSo)
 //function : processShOrCS
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
+void GEOMAlgo_Extractor::processShOrCS
+                     (const TopoDS_Shape                 &theShOrCS,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   // Treat sub-shapes.
   TopoDS_Iterator      anIter(theShOrCS);
@@ -705,7 +1072,7 @@ void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
           aNewOtherShapes.Append(aNewShape);
         }
       }
-    } else if (!myMapRemoved.Contains(aSubShape)) {
+    } else if (!isRemoved(aSubShape)) {
       // Shape is neither removed nor modified. Add it as it is.
       if (aSubShape.ShapeType() == aSubShapeType) {
         aNewSubShapes.Append(aSubShape);
@@ -718,7 +1085,7 @@ void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
   // Group sub-shapes via bounds
   TopTools_ListOfShape aNewShapes;
 
-  groupViaBounds(theShOrCS, aNewSubShapes, aNewShapes);
+  groupViaBounds(theShOrCS, aNewSubShapes, aNewShapes, theMapNewShapeAnc);
   aNewOtherShapes.Prepend(aNewShapes);
 
   if (!aNewOtherShapes.IsEmpty()) {
@@ -731,7 +1098,9 @@ void GEOMAlgo_Extractor::processShOrCS(const TopoDS_Shape &theShOrCS)
 //function : processCompound
 //purpose  :
 //=======================================================================
-void GEOMAlgo_Extractor::processCompound(const TopoDS_Shape &theCompound)
+void GEOMAlgo_Extractor::processCompound
+                     (const TopoDS_Shape                 &theCompound,
+                            TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   // Treat sub-shapes.
   TopoDS_Iterator      anIter(theCompound);
@@ -753,7 +1122,7 @@ void GEOMAlgo_Extractor::processCompound(const TopoDS_Shape &theCompound)
 
         aNewSubShapes.Append(aNewShape);
       }
-    } else if (!myMapRemoved.Contains(aSubShape)) {
+    } else if (!isRemoved(aSubShape)) {
       // Shape is neither removed nor modified. Add it as it is.
       aNewSubShapes.Append(aSubShape);
     }
@@ -764,7 +1133,8 @@ void GEOMAlgo_Extractor::processCompound(const TopoDS_Shape &theCompound)
       // Avoid creation of new compound for a single sub-shape.
       myMapModified.ChangeFind(theCompound).Append(aNewSubShapes.First());
     } else {
-      TopoDS_Shape aNewShape = makeShape(theCompound, aNewSubShapes);
+      TopoDS_Shape aNewShape = makeShape(theCompound, aNewSubShapes,
+                                         theMapNewShapeAnc);
 
       // Store modified shapes.
       myMapModified.ChangeFind(theCompound).Append(aNewShape);
@@ -778,12 +1148,14 @@ void GEOMAlgo_Extractor::processCompound(const TopoDS_Shape &theCompound)
 //=======================================================================
 void GEOMAlgo_Extractor::removeBoundsOnFOrSo(const TopAbs_ShapeEnum theType)
 {
-  // Get bounds on faces or solids.
-  TopExp_Explorer            anExp(myShape, theType);
-  TopTools_MapOfShape        aMapFence;
-  TopAbs_ShapeEnum           aBoundType;
-  TopAbs_ShapeEnum           aComplexBndType;
-  TopTools_IndexedMapOfShape aMapBounds;
+  // Get bounds on the modified faces or solids. The bounds on the faces
+  // or solids that are kept as they are, are found via the ancestors
+  // (see isCommonBound).
+  NCollection_Vector<Standard_Integer> anIds;
+  TopAbs_ShapeEnum                     aBoundType;
+  TopAbs_ShapeEnum                     aComplexBndType;
+  TopTools_IndexedMapOfShape           aMapBounds;
+  Standard_Integer                     i;
 
   if (theType == TopAbs_FACE) {
     aBoundType      = TopAbs_EDGE;
@@ -793,80 +1165,165 @@ void GEOMAlgo_Extractor::removeBoundsOnFOrSo(const TopAbs_ShapeEnum theType)
     aComplexBndType = TopAbs_SHELL;
   }
 
-  for (; anExp.More(); anExp.Next()) {
-    const TopoDS_Shape &aShape = anExp.Current();
+  getModifiedIds(theType, anIds);
 
-    if (aMapFence.Add(aShape)) {
-      if (myMapRemoved.Contains(aShape)) {
-        continue;
-      }
+  const Standard_Integer aNbShapes = anIds.Length();
 
-      if (myMapModified.IsBound(aShape)) {
-        TopTools_ListOfShape aNewShapes;
+  for (i = 0; i < aNbShapes; ++i) {
+    const TopoDS_Shape   &aShape = myAncestors->SubShape(anIds(i));
+    TopTools_ListOfShape  aNewShapes;
 
-        getModified(aShape, aNewShapes);
+    getModified(aShape, aNewShapes);
 
-        if (!aNewShapes.IsEmpty()) {
-          const TopoDS_Shape &aNewShape = aNewShapes.First();
+    if (!aNewShapes.IsEmpty()) {
+      const TopoDS_Shape &aNewShape = aNewShapes.First();
 
-          if (aNewShape.ShapeType() == theType) {
-            // Get bounds from the modified shape.
-            TopExp::MapShapes(aNewShape, aBoundType, aMapBounds);
-          }
+      if (aNewShape.ShapeType() == theType) {
+        // Get bounds from the modified shape.
+        TopExp::MapShapes(aNewShape, aBoundType, aMapBounds);
+      }
+    }
+  }
+
+  // Remove duplicated bounds from the faces or solids
+  for (i = 0; i < aNbShapes; ++i) {
+    const TopoDS_Shape                 &aShape     =
+                                       myAncestors->SubShape(anIds(i));
+    TopTools_ListOfShape               &aNewShapes =
+                                       myMapModified.ChangeFind(aShape);
+    TopTools_ListIteratorOfListOfShape  anIter(aNewShapes);
+
+    while (anIter.More()) {
+      const TopoDS_Shape &aSubShape = anIter.Value();
+      Standard_Boolean    isToRm    = Standard_False;
+
+      if (aSubShape.ShapeType() == aBoundType) {
+        // edge or face
+        isToRm = isCommonBound(aSubShape, aMapBounds, theType);
+      } else if (aSubShape.ShapeType() == aComplexBndType) {
+        // wire or shell
+        TopTools_ListOfShape aNewBounds;
+        Standard_Boolean     isModified;
+
+        if (theType == TopAbs_FACE) {
+          isModified = removeCommonEdges(aSubShape, aMapBounds, aNewBounds);
+        } else {
+          isModified = removeCommonFaces(aSubShape, aMapBounds, aNewBounds);
+        }
+
+        if (isModified) {
+          myMapModified.Bind(aSubShape, aNewBounds);
+          aNewShapes.InsertBefore(aNewBounds, anIter);
+          isToRm = Standard_True; // To remove unmodified bound.
         }
+      }
+
+      if (isToRm) {
+        aNewShapes.Remove(anIter);
       } else {
-        // Get bounds from the original shapes.
-        TopExp::MapShapes(aShape, aBoundType, aMapBounds);
+        anIter.Next();
       }
     }
   }
+}
 
-  // Remove duplicated bounds from the faces or solids
-  aMapFence.Clear();
+//=======================================================================
+//function : getModifiedIds
+//purpose  :
+//=======================================================================
+void GEOMAlgo_Extractor::getModifiedIds
+                     (const TopAbs_ShapeEnum                theType,
+                            NCollection_Vector<Standard_Integer> &theIds) const
+{
+  if (myModifiedIds.IsEmpty()) {
+    return;
+  }
 
-  for (anExp.Init(myShape, theType); anExp.More(); anExp.Next()) {
-    const TopoDS_Shape &aShape = anExp.Current();
+  NCollection_Array1<Standard_Integer>    anIds(1, myModifiedIds.Extent());
+  TColStd_MapIteratorOfPackedMapOfInteger anIter(myModifiedIds);
+  Standard_Integer                        i, aNbIds = 0;
 
-    if (aMapFence.Add(aShape)) {
-      if (myMapModified.IsBound(aShape)) {
-        TopTools_ListOfShape               &aNewShapes =
-                                       myMapModified.ChangeFind(aShape);
-        TopTools_ListIteratorOfListOfShape  anIter(aNewShapes);
-
-        while (anIter.More()) {
-          const TopoDS_Shape &aSubShape = anIter.Value();
-          Standard_Boolean    isToRm    = Standard_False;
-
-          if (aSubShape.ShapeType() == aBoundType) {
-            // edge or face
-            isToRm = aMapBounds.Contains(aSubShape);
-          } else if (aSubShape.ShapeType() == aComplexBndType) {
-            // wire or shell
-            TopTools_ListOfShape aNewBounds;
-            Standard_Boolean     isModified;
-
-            if (theType == TopAbs_FACE) {
-              isModified = removeCommonEdges(aSubShape, aMapBounds, aNewBounds);
-            } else {
-              isModified = removeCommonFaces(aSubShape, aMapBounds, aNewBounds);
-            }
+  for (; anIter.More(); anIter.Next()) {
+    const Standard_Integer anId = anIter.Key();
 
-            if (isModified) {
-              myMapModified.Bind(aSubShape, aNewBounds);
-              aNewShapes.InsertBefore(aNewBounds, anIter);
-              isToRm = Standard_True; // To remove unmodified bound.
-            }
-          }
+    if (myAncestors->SubShape(anId).ShapeType() == theType) {
+      anIds(++aNbIds) = anId;
+    }
+  }
 
-          if (isToRm) {
-            aNewShapes.Remove(anIter);
-          } else {
-            anIter.Next();
-          }
+  if (aNbIds) {
+    std::sort(&anIds(1), &anIds(1) + aNbIds);
+
+    if (theType == TopAbs_COMPOUND) {
+      // The nested compounds go before the compounds that contain them.
+      NCollection_DataMap<Standard_Integer, Standard_Integer> aLevels;
+
+      for (i = 1; i <= aNbIds; ++i) {
+        CompoundLevel(myAncestors, myModifiedIds, anIds(i), aLevels);
+      }
+
+      std::stable_sort(&anIds(1), &anIds(1) + aNbIds,
+                       GEOMAlgo_ExtractorLevelLess(aLevels));
+    }
+
+    for (i = 1; i <= aNbIds; ++i) {
+      theIds.Append(anIds(i));
+    }
+  }
+}
+
+//=======================================================================
+//function : isCommonBound
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_Extractor::isCommonBound
+                     (const TopoDS_Shape               &theBound,
+                      const TopTools_IndexedMapOfShape &theMapBounds,
+                      const TopAbs_ShapeEnum            theType) const
+{
+  if (theMapBounds.Contains(theBound)) {
+    return Standard_True;
+  }
+
+  const Standard_Integer anId = myAncestors->Index(theBound);
+
+  if (anId == 0) {
+    // This is a new shape. It can be only on the modified shapes.
+    return Standard_False;
+  }
+
+  // Look for a face (solid) that is neither removed nor modified among
+  // the ancestors of theBound up to the level of faces (solids).
+  TColStd_ListOfInteger aToVisit;
+  TColStd_MapOfInteger  aMapFence;
+  Standard_Integer      i;
+
+  aToVisit.Append(anId);
+
+  while (!aToVisit.IsEmpty()) {
+    const Standard_Integer aCurId = aToVisit.First();
+    const Standard_Integer aNbAnc = myAncestors->NbAncestors(aCurId);
+
+    aToVisit.RemoveFirst();
+
+    for (i = 1; i <= aNbAnc; ++i) {
+      const Standard_Integer anAncId   = myAncestors->Ancestor(aCurId, i);
+      const TopAbs_ShapeEnum anAncType =
+        myAncestors->SubShape(anAncId).ShapeType();
+
+      if (anAncType == theType) {
+        if (!myRemovedIds.Contains(anAncId) &&
+            !myModifiedIds.Contains(anAncId)) {
+          return Standard_True;
         }
+      } else if (anAncType > theType && aMapFence.Add(anAncId)) {
+        // wire or shell
+        aToVisit.Append(anAncId);
       }
     }
   }
+
+  return Standard_False;
 }
 
 //=======================================================================
@@ -890,10 +1347,12 @@ TopoDS_Shape GEOMAlgo_Extractor::oriented(const TopoDS_Shape &theShape,
 //purpose  :
 //=======================================================================
 TopoDS_Shape GEOMAlgo_Extractor::makeShape
-                        (const TopoDS_Shape         &theShape,
-                         const TopTools_ListOfShape &theSubShapes)
+                        (const TopoDS_Shape                 &theShape,
+                         const TopTools_ListOfShape         &theSubShapes,
+                         TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
-  TopoDS_Shape aResult = getShapeFromSubShapes(theShape, theSubShapes);
+  TopoDS_Shape aResult =
+    getShapeFromSubShapes(theShape, theSubShapes, theMapNewShapeAnc);
 
   if (aResult.IsNull()) {
     // Create a new shape.
@@ -911,11 +1370,11 @@ TopoDS_Shape GEOMAlgo_Extractor::makeShape
         aBuilder.Add(aResult, aSubShape);
 
         // Fill the map of new shape - ancestors.
-        if (!myMapNewShapeAnc.IsBound(aSubShape)) {
-          myMapNewShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
+        if (!theMapNewShapeAnc.IsBound(aSubShape)) {
+          theMapNewShapeAnc.Bind(aSubShape, TopTools_ListOfShape());
         }
 
-        myMapNewShapeAnc.ChangeFind(aSubShape).Append(aResult);
+        theMapNewShapeAnc.ChangeFind(aSubShape).Append(aResult);
       }
     }
   }
@@ -928,8 +1387,9 @@ TopoDS_Shape GEOMAlgo_Extractor::makeShape
 //purpose  :
 //=======================================================================
 TopoDS_Shape GEOMAlgo_Extractor::getShapeFromSubShapes
-                              (const TopoDS_Shape         &theShape,
-                               const TopTools_ListOfShape &theSubShapes)
+            (const TopoDS_Shape                       &theShape,
+             const TopTools_ListOfShape               &theSubShapes,
+             const TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   // Fill the map of sub-shapes.
   TopTools_ListIteratorOfListOfShape anIter(theSubShapes);
@@ -956,9 +1416,28 @@ TopoDS_Shape GEOMAlgo_Extractor::getShapeFromSubShapes
       iCur  = iCur  ? 0 : 1;
       iPrev = iPrev ? 0 : 1;
 
-      if (myMapNewShapeAnc.IsBound(aSubShape)) {
+      // Get the ancestors made by the lower levels and by the current chunk.
+      const TopTools_ListOfShape *pAncs = myMapNewShapeAnc.Seek(aSubShape);
+      TopTools_ListOfShape        aJoinedAncs;
+
+      if (&theMapNewShapeAnc != &myMapNewShapeAnc &&
+          theMapNewShapeAnc.IsBound(aSubShape)) {
         TopTools_ListIteratorOfListOfShape
-                      anAncIt(myMapNewShapeAnc.Find(aSubShape));
+                      aChunkIt(theMapNewShapeAnc.Find(aSubShape));
+
+        if (pAncs) {
+          aJoinedAncs.Assign(*pAncs);
+        }
+
+        for (; aChunkIt.More(); aChunkIt.Next()) {
+          aJoinedAncs.Append(aChunkIt.Value());
+        }
+
+        pAncs = &aJoinedAncs;
+      }
+
+      if (pAncs) {
+        TopTools_ListIteratorOfListOfShape anAncIt(*pAncs);
 
         if (isFirst) {
           // This is a first loop. Just fill the map of ancestors.
@@ -1040,7 +1519,7 @@ TopoDS_Shape GEOMAlgo_Extractor::makeResult(const TopoDS_Shape &theShape)
 {
   TopoDS_Shape aResult;
 
-  if (!myMapRemoved.Contains(theShape)) {
+  if (!isRemoved(theShape)) {
     if (myMapModified.IsBound(theShape)) {
       // The shape is modified.
       TopTools_ListOfShape aListModif;
@@ -1089,7 +1568,7 @@ void GEOMAlgo_Extractor::makeHistory(const TopoDS_Shape        &theShape,
   if (theMapFence.Add(theShape)) {
     Standard_Boolean isKept = Standard_True;
 
-    if (myMapRemoved.Contains(theShape)) {
+    if (isRemoved(theShape)) {
       myRemoved.Append(theShape);
       isKept = Standard_False;
     } else if (myMapModified.IsBound(theShape)) {
@@ -1150,7 +1629,7 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonEdges
   for (; anExp.More(); anExp.Next()) {
     const TopoDS_Shape &anEdge = anExp.Current();
 
-    if (theMapEdgesToRm.Contains(anEdge)) {
+    if (isCommonBound(anEdge, theMapEdgesToRm, TopAbs_FACE)) {
       // This edge is removed.
       TopExp::Vertices(TopoDS::Edge(anEdge), aVtx[0], aVtx[1]);
 
@@ -1174,7 +1653,7 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonEdges
 
   if (isModified && !aListListEdges.IsEmpty()) {
     // Make wires.
-    makeWires(theWire, aListListEdges, theNewWires);
+    makeWires(theWire, aListListEdges, theNewWires, myMapNewShapeAnc);
   }
 
   return isModified;
@@ -1196,7 +1675,7 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonFaces
   for (; anExp.More(); anExp.Next()) {
     const TopoDS_Shape &aFace = anExp.Current();
 
-    if (theMapFacesToRm.Contains(aFace)) {
+    if (isCommonBound(aFace, theMapFacesToRm, TopAbs_SOLID)) {
       isModified = Standard_True;
     } else {
       aListFaces.Append(aFace);
@@ -1205,7 +1684,7 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonFaces
 
   if (isModified && !aListFaces.IsEmpty()) {
     // Create new shells.
-    groupViaBounds(theShell, aListFaces, theNewShells);
+    groupViaBounds(theShell, aListFaces, theNewShells, myMapNewShapeAnc);
   }
 
   return isModified;
@@ -1218,7 +1697,8 @@ Standard_Boolean GEOMAlgo_Extractor::removeCommonFaces
 void GEOMAlgo_Extractor::makeWires
             (const TopoDS_Shape                           &theWire,
                    NCollection_List<TopTools_ListOfShape> &theListListEdges,
-                   TopTools_ListOfShape                   &theWires)
+                   TopTools_ListOfShape                   &theWires,
+                   TopTools_DataMapOfShapeListOfShape     &theMapNewShapeAnc)
 {
   if (theListListEdges.Size() > 1) {
     // Check if it is possible to merge first and last lists of edges.
@@ -1246,7 +1726,8 @@ void GEOMAlgo_Extractor::makeWires
 
   for (;anIter.More(); anIter.Next()) {
     const TopTools_ListOfShape &anEdges       = anIter.Value();
-    TopoDS_Shape                aNewWireShape = makeShape(theWire, anEdges);
+    TopoDS_Shape                aNewWireShape = makeShape(theWire, anEdges,
+                                                          theMapNewShapeAnc);
     TopoDS_Wire                 aNewWire      = TopoDS::Wire(aNewWireShape);
     TopoDS_Vertex               aV[2];
 
@@ -1265,9 +1746,10 @@ void GEOMAlgo_Extractor::makeWires
 //purpose  :
 //=======================================================================
 void GEOMAlgo_Extractor::groupViaBounds
-                       (const TopoDS_Shape         &theShape,
-                        const TopTools_ListOfShape &theSubShapes,
-                              TopTools_ListOfShape &theNewShapes)
+                       (const TopoDS_Shape                 &theShape,
+                        const TopTools_ListOfShape         &theSubShapes,
+                              TopTools_ListOfShape         &theNewShapes,
+                        TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc)
 {
   const Standard_Boolean isShell = theShape.ShapeType() == TopAbs_SHELL;
   TopAbs_ShapeEnum       aBoundType;
@@ -1374,7 +1856,8 @@ void GEOMAlgo_Extractor::groupViaBounds
       // Avoid creation of comp-solid with a single solid.
       aNewSubShapes.Append(aListSubShapes.First());
     } else {
-      TopoDS_Shape aNewShape = makeShape(theShape, aListSubShapes);
+      TopoDS_Shape aNewShape = makeShape(theShape, aListSubShapes,
+                                         theMapNewShapeAnc);
 
       if (aBounds.Value(i).IsEmpty()) {
         // This is a closed shape.
@@ -28,8 +28,11 @@
 
 
 #include <GEOMAlgo_Algo.hxx>
+#include <GEOMAlgo_ShapeAncestors.hxx>
 
 #include <NCollection_List.hxx>
+#include <NCollection_Vector.hxx>
+#include <TColStd_PackedMapOfInteger.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopTools_DataMapOfShapeListOfShape.hxx>
 #include <TopTools_ListOfShape.hxx>
@@ -70,6 +73,32 @@ public:
   const TopoDS_Shape &GetShape() const
   { return myShape; }
 
+  /**
+   * \brief This method sets the index of the main shape and its ancestors.
+   * The index is made by Prepare or Perform if it is not set or if it is
+   * made for another shape, so the same index can be shared by several
+   * extractors of the same main shape.
+   *
+   * \param theAncestors the index of the main shape.
+   */
+  Standard_EXPORT void SetAncestors
+      (const Handle(GEOMAlgo_ShapeAncestors) &theAncestors);
+
+  /**
+   * \brief This method returns the index of the main shape and its
+   * ancestors.
+   *
+   * \return the index of the main shape.
+   */
+  const Handle(GEOMAlgo_ShapeAncestors) &GetAncestors() const
+  { return myAncestors; }
+
+  /**
+   * \brief This method prepares the main shape for several removals,
+   * i.e. makes the index of its sub-shapes and their ancestors once.
+   */
+  Standard_EXPORT void Prepare();
+
   /**
    * \brief This method sets the list of sub-shapes to be removed
    *  from the main shape.
@@ -100,6 +129,36 @@ public:
    */
   Standard_EXPORT const TopoDS_Shape &GetResult() const;
 
+  /**
+   * \brief This method extracts each set of sub-shapes of theSets from
+   * the main shape independently. The main shape is prepared once, then
+   * each set is processed as by SetShapesToRemove and Perform, in parallel
+   * if the parallel mode is on. Only the ancestors modified by a set are
+   * rebuilt. The history of the sets is not kept.
+   *
+   * \param theSets the sets of sub-shapes to be removed.
+   */
+  Standard_EXPORT void PerformBatch
+      (const NCollection_Vector<TopTools_ListOfShape> &theSets);
+
+  /**
+   * \brief This method returns the results of PerformBatch in the order
+   * of the sets. The result of a failed set is a null shape.
+   *
+   * \return the results of the sets.
+   */
+  const NCollection_Vector<TopoDS_Shape> &GetBatchResults() const
+  { return myBatchResults; }
+
+  /**
+   * \brief This method returns the error statuses of PerformBatch in the
+   * order of the sets (see myErrorStatus).
+   *
+   * \return the error statuses of the sets.
+   */
+  const NCollection_Vector<Standard_Integer> &GetBatchErrors() const
+  { return myBatchErrors; }
+
   /**
    * \brief This method returns the sub-shapes removed from the main shape.
    *
@@ -138,13 +197,12 @@ private:
   void checkData();
 
   /**
-   * \brief This method fills the map of shapes and ancestors for the whole
-   * sub-shapes of theShape. This method is recursively called up to the lowest
-   * level of sub-shapes i.e. vertices.
+   * \brief This method returns Standard_True if theShape is a sub-shape
+   * of the main shape marked as removed.
    *
    * \param theShape the shape.
    */
-  void makeMapShapeAncestors(const TopoDS_Shape &theShape);
+  Standard_Boolean isRemoved(const TopoDS_Shape &theShape) const;
 
   /**
    * \brief This method marks shapes to be removed and to be modified.
@@ -152,63 +210,113 @@ private:
   void markShapes();
 
   /**
-   * \brief This method marks theShape to be removed. If it is required, it
-   * recursively marks its sub-shapes to be removed.
+   * \brief This method marks the shape with the index theId to be removed.
+   * If it is required, it recursively marks its sub-shapes to be removed.
    *
-   * \param theShape the shape.
+   * \param theId the index of the shape in myAncestors.
    */
-  void markRemoved(const TopoDS_Shape &theShape);
+  void markRemoved(const Standard_Integer theId);
 
   /**
-   * \brief This method marks ancestors of theShape to be modified. It is
-   * recursively called up to the level of main shape.
+   * \brief This method marks ancestors of the shape with the index theId
+   * to be modified. It is recursively called up to the level of main shape.
    *
-   * \param theShape the shape.
+   * \param theId the index of the shape in myAncestors.
    */
-  void markAncestorsModified(const TopoDS_Shape &theShape);
+  void markAncestorsModified(const Standard_Integer theId);
 
   /**
    * \brief This method performs computation of modified shapes of
-   *  the provided type.
+   *  the provided type. Each modified shape but a compound depends only on
+   *  the shapes of the lower levels, so in the parallel mode the shapes
+   *  other than compounds are processed by chunks concurrently. Each chunk
+   *  fills its own map of new shapes - ancestors, the maps are merged into
+   *  myMapNewShapeAnc in the order of the chunks at the end of the level.
+   *  A shape made in a chunk that the serial mode would take from a previous
+   *  chunk is replaced by it at the merge (see reuseShapes), so the result
+   *  does not depend on the mode.
    *
    * \param theType the processed shape type.
    */
   void processShapes(const TopAbs_ShapeEnum &theType);
 
+  /**
+   * \brief This method replaces the shapes made by the chunk of the level
+   * by the same shapes made by the previous chunks, which are already
+   * merged into myMapNewShapeAnc (see getShapeFromSubShapes).
+   *
+   * \param theIds the indices of the processed shapes of the level.
+   * \param theChunk the index of the chunk.
+   * \param theNbChunks the number of chunks of the level.
+   * \param theMapNewShapeAnc the map of new shapes - ancestors of the chunk.
+   * \param theMapReplaced the replaced shapes of the chunk. Output parameter.
+   */
+  void reuseShapes(const NCollection_Vector<Standard_Integer>  &theIds,
+                   const Standard_Integer                       theChunk,
+                   const Standard_Integer                       theNbChunks,
+                   const TopTools_DataMapOfShapeListOfShape    &theMapNewShapeAnc,
+                         TopTools_MapOfShape                   &theMapReplaced);
+
+  /**
+   * \brief This method performs computation of a modified shape of any
+   * type.
+   *
+   * \param theShape the modified shape (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
+   */
+  void processShape(const TopoDS_Shape                 &theShape,
+                          TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
+
   /**
    * \brief This method performs computation of a modified edge. 
    *
    * \param theEdge the modified edge (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void processEdge(const TopoDS_Shape &theEdge);
+  void processEdge(const TopoDS_Shape                 &theEdge,
+                         TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method performs computation of a modified wire.
    *
    * \param theWire the modified wire (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void processWire(const TopoDS_Shape &theWire);
+  void processWire(const TopoDS_Shape                 &theWire,
+                         TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method performs computation of a modified face or solid.
    *
    * \param theFOrSo the modified face or solid (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void processFOrSo(const TopoDS_Shape &theFOrSo);
+  void processFOrSo(const TopoDS_Shape                 &theFOrSo,
+                          TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method performs computation of a modified shell or comp-solid.
    *
    * \param theShOrCS the modified shell or comp-solid (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void processShOrCS(const TopoDS_Shape &theShOrCS);
+  void processShOrCS(const TopoDS_Shape                 &theShOrCS,
+                           TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method performs computation of a modified compound.
    *
    * \param theCompound the modified compound (should be forward).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void processCompound(const TopoDS_Shape &theCompound);
+  void processCompound(const TopoDS_Shape                 &theCompound,
+                             TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method removes hanging edges (faces) built for faces (solids)
@@ -218,6 +326,32 @@ private:
    */
   void removeBoundsOnFOrSo(const TopAbs_ShapeEnum theType);
 
+  /**
+   * \brief This method returns the indices of the modified shapes of the
+   * provided type in the increasing order. The compounds are ordered by
+   * their nesting level first, so a nested compound is processed before
+   * the compounds that contain it.
+   *
+   * \param theType the shape type.
+   * \param theIds the indices in myAncestors. Output parameter.
+   */
+  void getModifiedIds(const TopAbs_ShapeEnum                theType,
+                            NCollection_Vector<Standard_Integer> &theIds) const;
+
+  /**
+   * \brief This method returns Standard_True if theBound (edge or face)
+   * is in theMapBounds or if it bounds a face (solid) of the main shape
+   * that is neither removed nor modified.
+   *
+   * \param theBound the edge or face.
+   * \param theMapBounds the bounds of the modified faces (solids).
+   * \param theType the shape type. Should be either face or solid.
+   */
+  Standard_Boolean isCommonBound
+                     (const TopoDS_Shape               &theBound,
+                      const TopTools_IndexedMapOfShape &theMapBounds,
+                      const TopAbs_ShapeEnum            theType) const;
+
   /**
    * \brief Returns theShape with an orientation composed with theContext's
    * orientation.
@@ -234,22 +368,30 @@ private:
    *
    * \param theShape the shape to be copied (should be forward).
    * \param theSubShapes the sub-shapes (should be oriented correctly).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    * \return the modified shape.
    */
-  TopoDS_Shape makeShape(const TopoDS_Shape         &theShape,
-                         const TopTools_ListOfShape &theSubShapes);
+  TopoDS_Shape makeShape(const TopoDS_Shape                 &theShape,
+                         const TopTools_ListOfShape         &theSubShapes,
+                         TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method returns the shape from the list of sub-shapes
    * if there is any shape created already with these sub-shapes.
-   * If there is no such shape, null shape is returned.
+   * If there is no such shape, null shape is returned. The shapes are
+   * searched in myMapNewShapeAnc and in theMapNewShapeAnc.
    *
    * \param theShape the shape to be copied (should be forward).
    * \param theSubShapes the sub-shapes (should be oriented correctly).
+   * \param theMapNewShapeAnc the map of new shapes - ancestors of the
+   *        current chunk (see processShapes).
    * \return the modified shape (or null if it is not found).
    */
-  TopoDS_Shape getShapeFromSubShapes(const TopoDS_Shape         &theShape,
-                                     const TopTools_ListOfShape &theSubShapes);
+  TopoDS_Shape getShapeFromSubShapes
+            (const TopoDS_Shape                       &theShape,
+             const TopTools_ListOfShape               &theSubShapes,
+             const TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method makes the result for the given shape. If it is removed
@@ -273,9 +415,10 @@ private:
                          TopTools_MapOfShape &theMapFence);
 
   /**
-   * \brief This method removes edges that are in theMapEdgesToRm from
-   * theWire and re-creates one or more wires from the rest edges. theNewWires
-   * contains the modified wire(s).
+   * \brief This method removes edges that are in theMapEdgesToRm or on
+   * the kept faces (see isCommonBound) from theWire and re-creates one or
+   * more wires from the rest edges. theNewWires contains the modified
+   * wire(s).
    *
    * \param theWire the input wire.
    * \param theMapEdgesToRm the map of edges to be extracted from theWire.
@@ -288,9 +431,10 @@ private:
                             TopTools_ListOfShape       &theNewWires);
 
   /**
-   * \brief This method removes faces that are in theMapFacesToRm from
-   * theShell and re-creates one or more shells from the rest faces.
-   * theNewShells contains the modified shell(s).
+   * \brief This method removes faces that are in theMapFacesToRm or on
+   * the kept solids (see isCommonBound) from theShell and re-creates one or
+   * more shells from the rest faces. theNewShells contains the modified
+   * shell(s).
    *
    * \param theShell the input shell.
    * \param theMapFacesToRm the map of faces to be extracted from theShell.
@@ -309,10 +453,13 @@ private:
    * \param theListListEdges the list of list of edges. Can be modified
    *        on output.
    * \param theWires the list of created wires. Output parameter.
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
   void makeWires(const TopoDS_Shape                           &theWire,
                        NCollection_List<TopTools_ListOfShape> &theListListEdges,
-                       TopTools_ListOfShape                   &theWires);
+                       TopTools_ListOfShape                   &theWires,
+                       TopTools_DataMapOfShapeListOfShape     &theMapNewShapeAnc);
 
   /**
    * \brief This method collects the shapes in theShapes via common bounds.
@@ -324,10 +471,13 @@ private:
    * \param theShape the original shape.
    * \param theSubShapes the list of shapes to be connected.
    * \param theNewShapes the list of newly created shapes. Output parameter.
+   * \param theMapNewShapeAnc the map of new shapes - ancestors to fill
+   *        (see processShapes).
    */
-  void groupViaBounds(const TopoDS_Shape         &theShape,
-                      const TopTools_ListOfShape &theSubShapes,
-                            TopTools_ListOfShape &theNewShapes);
+  void groupViaBounds(const TopoDS_Shape                 &theShape,
+                      const TopTools_ListOfShape         &theSubShapes,
+                            TopTools_ListOfShape         &theNewShapes,
+                      TopTools_DataMapOfShapeListOfShape &theMapNewShapeAnc);
 
   /**
    * \brief This method returns the list of modified shapes obtained
@@ -344,6 +494,8 @@ private:
                          TopTools_ListOfShape &theModifShapes,
                    const TopAbs_ShapeEnum      theShapeType = TopAbs_SHAPE);
 
+  friend class GEOMAlgo_ExtractorLevelFunctor;
+
 protected:
 
   TopoDS_Shape                       myShape;
@@ -352,10 +504,13 @@ protected:
   TopTools_ListOfShape               myRemoved;
   TopTools_ListOfShape               myModified;
   TopTools_ListOfShape               myNew;
-  TopTools_DataMapOfShapeListOfShape myMapShapeAnc;
-  TopTools_MapOfShape                myMapRemoved;
+  Handle(GEOMAlgo_ShapeAncestors)    myAncestors;
+  TColStd_PackedMapOfInteger         myRemovedIds;
+  TColStd_PackedMapOfInteger         myModifiedIds;
   TopTools_DataMapOfShapeListOfShape myMapModified;
   TopTools_DataMapOfShapeListOfShape myMapNewShapeAnc;
+  NCollection_Vector<TopoDS_Shape>     myBatchResults;
+  NCollection_Vector<Standard_Integer> myBatchErrors;
 
 };
 
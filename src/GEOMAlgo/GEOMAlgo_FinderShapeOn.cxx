@@ -344,6 +344,7 @@ void GEOMAlgo_FinderShapeOn::Find(const TopoDS_Shape& aS)
   }
   //
   pSS->SetFiller(aPF);
+  pSS->SetRunParallel(myRunParallel);
   pSS->Perform();
   iErr=pSS->ErrorStatus();
   if (iErr) {
@@ -30,16 +30,15 @@
 
 #include <Precision.hxx>
 #include <TColStd_Array1OfInteger.hxx>
-#include <TColStd_MapOfInteger.hxx>
 
 #include <gp_Trsf.hxx>
 #include <gp_Cylinder.hxx>
 #include <gp_Pnt.hxx>
 
 #include <TColgp_Array1OfPnt.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
 
-#include <Poly_Array1OfTriangle.hxx>
-#include <Poly_Triangle.hxx>
 #include <Poly_PolygonOnTriangulation.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Poly_Polygon3D.hxx>
@@ -68,13 +67,9 @@
 #include <BRep_Tool.hxx>
 #include <BRepLib_MakeEdge.hxx>
 
-#include <GEOMAlgo_ListIteratorOfListOfPnt.hxx>
 #include <GEOMAlgo_SurfaceTools.hxx>
 #include <GEOMAlgo_StateCollector.hxx>
 #include <GEOMAlgo_AlgoTools.hxx>
-#include <GEOMAlgo_PassKey.hxx>
-#include <GEOMAlgo_DataMapOfPassKeyInteger.hxx>
-#include <GEOMAlgo_DataMapIteratorOfDataMapOfPassKeyInteger.hxx>
 
 
 //=======================================================================
@@ -299,11 +294,10 @@ void GEOMAlgo_FinderShapeOn1::ProcessEdges()
   myErrorStatus=0;
   //
   Standard_Boolean bIsConformState, bIsToBreak;
-  Standard_Integer i, aNb, iCnt;
+  Standard_Integer i, aNb, iCnt, aNbP;
   TopAbs_State aSt;
   TopTools_IndexedMapOfShape aM;
   TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
   GeomAbs_SurfaceType aType1;
   //
   aType1=myGAS.GetType();
@@ -314,7 +308,7 @@ void GEOMAlgo_FinderShapeOn1::ProcessEdges()
   //
   aNb=aM.Extent();
   for (i=1; i<=aNb; ++i) {
-    GEOMAlgo_ListOfPnt aLP;
+    GEOMAlgo_ArrayOfPnt aLP;
     GEOMAlgo_StateCollector aSC;
     //
     const TopoDS_Edge& aE=TopoDS::Edge(aM(i));
@@ -363,15 +357,15 @@ void GEOMAlgo_FinderShapeOn1::ProcessEdges()
     }
     //
     bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
+    aNbP=(Standard_Integer)aLP.size();
+    for (iCnt=0; iCnt<aNbP; ++iCnt) {
       if (myNbPntsMax) {
         if (iCnt > myNbPntsMax) {
           break;
         }
       }
       //
-      const gp_Pnt& aP=aIt.Value();
+      const gp_Pnt& aP=aLP[iCnt];
       aSt = GetPointState( aP );
       bIsToBreak=aSC.AppendState(aSt);
       if (bIsToBreak) {
@@ -401,11 +395,10 @@ void GEOMAlgo_FinderShapeOn1::ProcessFaces()
   myErrorStatus=0;
   //
   Standard_Boolean bIsConformState, bIsToBreak;
-  Standard_Integer i, aNbF, iCnt;
+  Standard_Integer i, aNbF, iCnt, aNbP;
   TopAbs_State aSt;
   TopTools_IndexedMapOfShape aM;
   TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
   GeomAbs_SurfaceType aType1, aType2;
   //
   aType1=myGAS.GetType();
@@ -414,7 +407,7 @@ void GEOMAlgo_FinderShapeOn1::ProcessFaces()
   aNbF=aM.Extent();
   for (i=1; i<=aNbF; ++i) {
     GEOMAlgo_StateCollector aSC;
-    GEOMAlgo_ListOfPnt aLP;
+    GEOMAlgo_ArrayOfPnt aLP;
     //
     const TopoDS_Face& aF=TopoDS::Face(aM(i));
     //
@@ -455,15 +448,15 @@ void GEOMAlgo_FinderShapeOn1::ProcessFaces()
     }
     //
     bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
+    aNbP=(Standard_Integer)aLP.size();
+    for (iCnt=0; iCnt<aNbP; ++iCnt) {
       if (myNbPntsMax) {
         if (iCnt > myNbPntsMax) {
           break;
         }
       }
       //
-      const gp_Pnt& aP=aIt.Value();
+      const gp_Pnt& aP=aLP[iCnt];
       aSt = GetPointState( aP );
       bIsToBreak=aSC.AppendState(aSt);
       if (bIsToBreak) {
@@ -539,19 +532,22 @@ void GEOMAlgo_FinderShapeOn1::ProcessSolids()
 //purpose  :
 //=======================================================================
 void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Face& aF,
-                                          GEOMAlgo_ListOfPnt& aLP)
+                                          GEOMAlgo_ArrayOfPnt& aLP)
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, j1, j2, k, n[4], aNbLinks, aNx, aNb, iCnt;//, aNbMax, *pIds;
+  Standard_Boolean bIsDone, bToFill;
+  Standard_Integer j, aNb, aNbLinks, aN1, aN2;
   TopLoc_Location aLoc;
   Handle(Poly_Triangulation) aTRF;
-  TColStd_MapOfInteger aMBN;
-  GEOMAlgo_DataMapOfPassKeyInteger aMPKI;
-  GEOMAlgo_DataMapIteratorOfDataMapOfPassKeyInteger aIt;
+  Handle(Geom_Surface) aS;
+  GeomAdaptor_Surface aGAS;
+  GeomAbs_SurfaceType aType;
+  NCollection_Array1<Standard_Boolean> aIsBoundary;
+  NCollection_Vector<Standard_Integer> aInnerLinks;
   gp_Pnt aP, aP1, aP2;
   //
-  aLP.Clear();
+  aLP.clear();
   //
   aTRF=BRep_Tool::Triangulation(aF, aLoc);
   if (aTRF.IsNull()) {
@@ -563,124 +559,77 @@ void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Face& aF,
   }
   //
   const gp_Trsf& aTrsf=aLoc.Transformation();
-  const Poly_Array1OfTriangle& aTrs=aTRF->Triangles();
   const TColgp_Array1OfPnt& aNodes=aTRF->Nodes();
   //
-  // map link/nbtriangles
-  j1=aTrs.Lower();
-  j2=aTrs.Upper();
-  for (j=j1; j<=j2; ++j) {
-    const Poly_Triangle& aTr=aTrs(j);
-    aTr.Get(n[0], n[1], n[2]);
-    n[3]=n[0];
-    for (k=0; k<3; ++k) {
-      GEOMAlgo_PassKey aPK;
-      //
-      aPK.SetIds(n[k], n[k+1]);
-      if (aMPKI.IsBound(aPK)) {
-        Standard_Integer& iCntX=aMPKI.ChangeFind(aPK);
-        ++iCntX;
-      }
-      else {
-        aMPKI.Bind(aPK, 1);
-      }
-    }
-  }
-  //
-  // boundary nodes aMBN
-  aNbLinks=aMPKI.Extent();
-  aIt.Initialize(aMPKI);
-  for (; aIt.More(); aIt.Next()) {
-    iCnt=aIt.Value();
-    if (iCnt==1) {
-      const GEOMAlgo_PassKey& aPK=aIt.Key();
-      //
-      aNx=(Standard_Integer)aPK.Id(1);
-      aMBN.Add(aNx);
-      aNx=(Standard_Integer)aPK.Id(2);
-      aMBN.Add(aNx);
-    }
-  }
+  // the inner links are needed if there are no inner nodes
+  // and the face is planar or cylindrical
+  aS=BRep_Tool::Surface(aF);
+  aGAS.Load(aS);
+  aType=aGAS.GetType();
+  bToFill=(myNbPntsMin &&
+           (aType==GeomAbs_Plane || aType==GeomAbs_Cylinder));
   //
   // inner nodes=all_nodes - boundary_nodes
-  j1=aNodes.Lower();
-  j2=aNodes.Upper();
-  for (j=j1; j<=j2; ++j) {
-    if (!aMBN.Contains(j)) {
+  aNb=GEOMAlgo_AlgoTools::BoundaryNodes(aTRF, aIsBoundary,
+                                        bToFill ? &aInnerLinks : NULL);
+  aLP.reserve(aNb);
+  for (j=aNodes.Lower(); j<=aNodes.Upper(); ++j) {
+    if (!aIsBoundary(j)) {
       aP=aNodes(j).Transformed(aTrsf);
-      aLP.Append(aP);
+      aLP.push_back(aP);
     }
   }
   //
-  aNb=aLP.Extent();
+  if (aNb || !bToFill) {
+    return;
+  }
   //
-  if (!aNb && myNbPntsMin) {
-    // try to fill it yourself
-    Standard_Boolean bIsDone;
-    Standard_Integer aN1, aN2;
-    Handle(Geom_Surface) aS;
-    GeomAdaptor_Surface aGAS;
-    GeomAbs_SurfaceType aType;
+  // try to fill it yourself:
+  // take the first suitable inner link and discretize it
+  aNbLinks=aInnerLinks.Length()/2;
+  for (j=0; j<aNbLinks; ++j) {
+    aN1=aInnerLinks(2*j);
+    aN2=aInnerLinks(2*j+1);
     //
-    aS=BRep_Tool::Surface(aF);
-    aGAS.Load(aS);
-    aType=aGAS.GetType();
-    if (aType==GeomAbs_Plane || aType==GeomAbs_Cylinder) {
-      // inner links
-      aNbLinks=aMPKI.Extent();
-      aIt.Initialize(aMPKI);
-      for (; aIt.More(); aIt.Next()) {
-        iCnt=aIt.Value();
-        if (iCnt>1) {
-          // take the first having occurred inner link
-          // and discretize it
-          const GEOMAlgo_PassKey& aPK=aIt.Key();
-          //
-          aN1=(Standard_Integer)aPK.Id(1);
-          aN2=(Standard_Integer)aPK.Id(2);
-          //
-          aP1=aNodes(aN1).Transformed(aTrsf);
-          aP2=aNodes(aN2).Transformed(aTrsf);
-          //
-          if (aType==GeomAbs_Cylinder) {
-            gp_Cylinder aCyl;
-            //
-            aCyl=aGAS.Cylinder();
-            if (!GEOMAlgo_SurfaceTools::IsCoaxial(aP1, aP2, aCyl, myTolerance)) {
-              continue;
-            }
-          }
-          //
-          BRepLib_MakeEdge aBME(aP1, aP2);
-          bIsDone=aBME.IsDone();
-          if (!bIsDone) {
-            myErrorStatus=30; //can not obtain the line from the link
-            return;
-          }
-          //
-          const TopoDS_Shape& aSx=aBME.Shape();
-          const TopoDS_Edge& aE=TopoDS::Edge(aSx);
-          //
-          InnerPoints(aE, myNbPntsMin, aLP);
-          break;
-        }// if (iCnt>1)
-      }// for (; aIt.More(); aIt.Next())
-    }// if (aType==GeomAbs_Plane || aType==GeomAbs_Cylinder)
-  }// if (!aNb && myNbPntsMin) {
+    aP1=aNodes(aN1).Transformed(aTrsf);
+    aP2=aNodes(aN2).Transformed(aTrsf);
+    //
+    if (aType==GeomAbs_Cylinder) {
+      gp_Cylinder aCyl;
+      //
+      aCyl=aGAS.Cylinder();
+      if (!GEOMAlgo_SurfaceTools::IsCoaxial(aP1, aP2, aCyl, myTolerance)) {
+        continue;
+      }
+    }
+    //
+    BRepLib_MakeEdge aBME(aP1, aP2);
+    bIsDone=aBME.IsDone();
+    if (!bIsDone) {
+      myErrorStatus=30; //can not obtain the line from the link
+      return;
+    }
+    //
+    const TopoDS_Shape& aSx=aBME.Shape();
+    const TopoDS_Edge& aE=TopoDS::Edge(aSx);
+    //
+    InnerPoints(aE, myNbPntsMin, aLP);
+    break;
+  }
 }
 //=======================================================================
 //function : InnerPoints
 //purpose  :
 //=======================================================================
 void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Edge& aE,
-                                          GEOMAlgo_ListOfPnt& aLP)
+                                          GEOMAlgo_ArrayOfPnt& aLP)
 {
   Standard_Integer aNbPntsMin;
   //
   myErrorStatus=0;
   aNbPntsMin=21;
   //
-  aLP.Clear();
+  aLP.clear();
   InnerPoints(aE, aNbPntsMin, aLP);
 }
 //=======================================================================
@@ -689,7 +638,7 @@ void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Edge& aE,
 //=======================================================================
 void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Edge& aE,
                                           const Standard_Integer aNbPntsMin,
-                                          GEOMAlgo_ListOfPnt& aLP)
+                                          GEOMAlgo_ArrayOfPnt& aLP)
 {
   Standard_Boolean bInf1, bInf2;
   Standard_Integer j, aNbT;
@@ -713,7 +662,7 @@ void GEOMAlgo_FinderShapeOn1::InnerPoints(const TopoDS_Edge& aE,
   for (j=1; j<aNbT; ++j) {
     aT=aT1+j*dT;
     aC3D->D0(aT, aP);
-    aLP.Append(aP);
+    aLP.push_back(aP);
   }
 }
 
@@ -30,7 +30,7 @@
 #include <GEOMAlgo_State.hxx>
 #include <GEOMAlgo_IndexedDataMapOfShapeState.hxx>
 #include <GEOMAlgo_ShapeAlgo.hxx>
-#include <GEOMAlgo_ListOfPnt.hxx>
+#include <GEOMAlgo_ArrayOfPnt.hxx>
 
 #include <TopAbs_State.hxx>
 #include <TopAbs_ShapeEnum.hxx>
@@ -117,16 +117,16 @@ class GEOMAlgo_FinderShapeOn1  : public GEOMAlgo_ShapeAlgo
 
   Standard_EXPORT
     void InnerPoints(const TopoDS_Face& aF,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) ;
 
   Standard_EXPORT
     void InnerPoints(const TopoDS_Edge& aE,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) ;
 
   Standard_EXPORT
     void InnerPoints(const TopoDS_Edge& aE,
                      const Standard_Integer aNbPnts,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) ;
 
   Standard_EXPORT
     virtual  TopAbs_State GetPointState(const gp_Pnt& aP) ;
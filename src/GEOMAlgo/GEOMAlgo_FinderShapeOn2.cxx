@@ -26,10 +26,7 @@
 //              <pkv@irinox>
 //
 #include <GEOMAlgo_FinderShapeOn2.hxx>
-#include <GEOMAlgo_DataMapIteratorOfDataMapOfPassKeyInteger.hxx>
-#include <GEOMAlgo_DataMapOfPassKeyInteger.hxx>
-#include <GEOMAlgo_ListIteratorOfListOfPnt.hxx>
-#include <GEOMAlgo_PassKey.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
 #include <GEOMAlgo_StateCollector.hxx>
 #include <GEOMAlgo_SurfaceTools.hxx>
 
@@ -49,15 +46,12 @@
 #include <gp_Trsf.hxx>
 #include <HatchGen_Domain.hxx>
 #include <IntTools_Tools.hxx>
-#include <Poly_Array1OfTriangle.hxx>
 #include <Poly_Polygon3D.hxx>
 #include <Poly_PolygonOnTriangulation.hxx>
-#include <Poly_Triangle.hxx>
 #include <Poly_Triangulation.hxx>
 #include <Precision.hxx>
 #include <TColgp_Array1OfPnt.hxx>
 #include <TColStd_Array1OfInteger.hxx>
-#include <TColStd_MapOfInteger.hxx>
 #include <TopAbs_State.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
@@ -69,6 +63,8 @@
 #include <TopoDS_Vertex.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <IntTools_Context.hxx>
+#include <NCollection_Array1.hxx>
+#include <OSD_Parallel.hxx>
 
 //=======================================================================
 //function : 
@@ -172,6 +168,24 @@ Standard_Integer GEOMAlgo_FinderShapeOn2::NbPntsMax()const
   return myNbPntsMax;
 }
 //=======================================================================
+//function : SetInnerPointsCache
+//purpose  :
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::SetInnerPointsCache
+  (const Handle(GEOMAlgo_InnerPointsCache)& aCache)
+{
+  myInnerPointsCache=aCache;
+}
+//=======================================================================
+//function : InnerPointsCache
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_InnerPointsCache)&
+  GEOMAlgo_FinderShapeOn2::InnerPointsCache() const
+{
+  return myInnerPointsCache;
+}
+//=======================================================================
 // function: MSS
 // purpose:
 //=======================================================================
@@ -206,10 +220,14 @@ const TopTools_ListOfShape& GEOMAlgo_FinderShapeOn2::Shapes() const
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::Perform()
 {
+  Standard_Integer aNbS;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   myLS.Clear();
   myMSS.Clear();
+  myMBoxStates.Clear();
+  ClearPhases();
   //
   CheckData();
   if(myErrorStatus) {
@@ -221,8 +239,18 @@ void GEOMAlgo_FinderShapeOn2::Perform()
   //
   myClsf->SetTolerance(myTolerance);
   //
+  // 0
+  BeginPhase("ProcessBoxes");
+  ProcessBoxes();
+  AddPhaseShapes(myMBoxStates.Extent());
+  EndPhase();
+  //
   // 1
+  BeginPhase("ProcessVertices");
+  aNbS=myMSS.Extent();
   ProcessVertices();
+  AddPhaseShapes(myMSS.Extent()-aNbS);
+  EndPhase();
   if(myErrorStatus) {
     return;
   }
@@ -231,7 +259,11 @@ void GEOMAlgo_FinderShapeOn2::Perform()
   }
   //
   // 2
+  BeginPhase("ProcessEdges");
+  aNbS=myMSS.Extent();
   ProcessEdges();
+  AddPhaseShapes(myMSS.Extent()-aNbS);
+  EndPhase();
   if(myErrorStatus) {
     return;
   }
@@ -240,7 +272,11 @@ void GEOMAlgo_FinderShapeOn2::Perform()
   }
   //
   // 3
+  BeginPhase("ProcessFaces");
+  aNbS=myMSS.Extent();
   ProcessFaces();
+  AddPhaseShapes(myMSS.Extent()-aNbS);
+  EndPhase();
   if(myErrorStatus) {
     return;
   }
@@ -249,7 +285,11 @@ void GEOMAlgo_FinderShapeOn2::Perform()
   }
   //
   // 4
+  BeginPhase("ProcessSolids");
+  aNbS=myMSS.Extent();
   ProcessSolids();
+  AddPhaseShapes(myMSS.Extent()-aNbS);
+  EndPhase();
   //
 }
 //=======================================================================
@@ -294,6 +334,65 @@ void GEOMAlgo_FinderShapeOn2::CheckData()
   }
 }
 //=======================================================================
+//function : ProcessBoxes
+//purpose  : finds the shapes that are IN or OUT as a whole by their
+//           bounding boxes: myShape, then the solids, the faces and
+//           the edges that are not resolved yet; the sub-shapes of
+//           a resolved shape have its state
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::ProcessBoxes()
+{
+  const TopAbs_ShapeEnum aTypes[4]={
+    TopAbs_SOLID, TopAbs_FACE, TopAbs_EDGE, TopAbs_VERTEX
+  };
+  Standard_Integer i, j, k, aNb;
+  TopAbs_State aSt;
+  TopTools_IndexedMapOfShape aM;
+  TopExp_Explorer aExp;
+  //
+  myMBoxStates.Clear();
+  if (!myClsf->HasStateOfBox()) {
+    return;
+  }
+  //
+  for (k=-1; k<3; ++k) {
+    aM.Clear();
+    if (k<0) {
+      aM.Add(myShape);
+    }
+    else {
+      TopExp::MapShapes(myShape, aTypes[k], aM);
+    }
+    //
+    aNb=aM.Extent();
+    for (i=1; i<=aNb; ++i) {
+      Bnd_Box aBox;
+      //
+      const TopoDS_Shape& aS=aM(i);
+      if (myMBoxStates.Contains(aS)) {
+        continue;
+      }
+      //
+      BRepBndLib::Add(aS, aBox, Standard_False);
+      aBox.Enlarge(Precision::Confusion());
+      aSt=myClsf->StateOfBox(aBox);
+      if (!(aSt==TopAbs_IN || aSt==TopAbs_OUT)) {
+        continue;
+      }
+      //
+      for (j=k+1; j<4; ++j) {
+        aExp.Init(aS, aTypes[j]);
+        for (; aExp.More(); aExp.Next()) {
+          myMBoxStates.Add(aExp.Current(), aSt);
+        }
+      }
+      if (k>=0) {
+        myMBoxStates.Add(aS, aSt);
+      }
+    }
+  }
+}
+//=======================================================================
 //function : ProcessVertices
 //purpose  :
 //=======================================================================
@@ -302,26 +401,51 @@ void GEOMAlgo_FinderShapeOn2::ProcessVertices()
   myErrorStatus=0;
   //
   Standard_Boolean bIsConformState;
-  Standard_Integer i, aNb, iErr;
-  gp_Pnt aP;
+  Standard_Integer i, aNb, aNbP, iErr;
   TopTools_IndexedMapOfShape aM;
   TopAbs_State aSt;
   //
   TopExp::MapShapes(myShape, TopAbs_VERTEX, aM);
   aNb=aM.Extent();
+  if (!aNb) {
+    return;
+  }
+  //
+  // the vertices with no state from the bounding boxes
+  // are classified in one call
+  NCollection_Array1<gp_Pnt> aPnts(1, aNb);
+  NCollection_Array1<TopAbs_State> aStates(1, aNb);
+  NCollection_Array1<Standard_Integer> aIndices(1, aNb);
+  aNbP=0;
   for (i=1; i<=aNb; ++i) {
-    const TopoDS_Vertex& aV=TopoDS::Vertex(aM(i));
-    aP=BRep_Tool::Pnt(aV);
+    const TopoDS_Shape& aV=aM(i);
+    if (myMBoxStates.Contains(aV)) {
+      aStates(i)=myMBoxStates.FindFromKey(aV);
+      continue;
+    }
+    ++aNbP;
+    aPnts(aNbP)=BRep_Tool::Pnt(TopoDS::Vertex(aV));
+    aIndices(aNbP)=i;
+  }
+  //
+  if (aNbP) {
+    NCollection_Array1<TopAbs_State> aPStates(1, aNbP);
     //
-    myClsf->SetPnt(aP);
-    myClsf->Perform();
+    myClsf->Perform(&aPnts(1), aNbP, &aPStates(1));
+    AddPhaseClsfCalls(aNbP);
     iErr=myClsf->ErrorStatus();
     if (iErr) {
       myErrorStatus=40; // point can not be classified
       return;
     }
-    //
-    aSt=myClsf->State();
+    for (i=1; i<=aNbP; ++i) {
+      aStates(aIndices(i))=aPStates(i);
+    }
+  }
+  //
+  for (i=1; i<=aNb; ++i) {
+    const TopoDS_Vertex& aV=TopoDS::Vertex(aM(i));
+    aSt=aStates(i);
     bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
     //
     if (myShapeType==TopAbs_VERTEX){
@@ -334,208 +458,380 @@ void GEOMAlgo_FinderShapeOn2::ProcessVertices()
     }
   }
 }
+//=======================================================================
+//class    : GEOMAlgo_FinderShapeOn2Functor
+//purpose  : computes the states of the chunk of the shapes theM;
+//           the shapes are not meshed here, the shapes without mesh
+//           are left for the serial pass (status ShapeNoMesh);
+//           each chunk takes a free slot of the pool and uses the
+//           context and the classifier of this slot; the copy of the
+//           classifier of a slot is made at the first use of the slot
+//=======================================================================
+class GEOMAlgo_FinderShapeOn2Functor
+{
+ public:
+  GEOMAlgo_FinderShapeOn2Functor
+    (GEOMAlgo_FinderShapeOn2& theFinder,
+     const TopTools_IndexedMapOfShape& theM,
+     NCollection_Array1<Handle(GEOMAlgo_Clsf)>& theClsfs,
+     const Handle(GEOMAlgo_ContextPool)& thePool,
+     NCollection_Array1<Standard_Integer>& theRets,
+     NCollection_Array1<TopAbs_State>& theStates,
+     NCollection_Array1<Standard_Integer>& theErrs,
+     NCollection_Array1<Standard_Integer>& theNbClsfCalls,
+     const Standard_Integer theNbChunks)
+  :
+    myFinder(theFinder),
+    myM(theM),
+    myClsfs(theClsfs),
+    myPool(thePool),
+    myRets(theRets),
+    myStates(theStates),
+    myErrs(theErrs),
+    myNbClsfCalls(theNbClsfCalls),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Boolean bMeshOnly;
+    Standard_Integer i, i1, i2, aNb;
+    //
+    Standard_Integer iSlot;
+    //
+    bMeshOnly=(myNbChunks>1);
+    aNb=myM.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    //
+    iSlot=myPool->Acquire();
+    Handle(GEOMAlgo_Clsf)& aClsf=myClsfs(iSlot);
+    if (aClsf.IsNull()) {
+      aClsf=myClsfs(0)->Copy();
+    }
+    if (aClsf.IsNull()) {
+      // no copy of the classifier, the shapes are left for the serial pass
+      for (i=i1; i<=i2; ++i) {
+        myRets(i)=GEOMAlgo_FinderShapeOn2::ShapeNoMesh;
+      }
+      myPool->Release(iSlot);
+      return;
+    }
+    const Handle(IntTools_Context)& aCtx=myPool->Context(iSlot);
+    //
+    for (i=i1; i<=i2; ++i) {
+      myRets(i)=myFinder.ShapeState(myM(i), aClsf, aCtx, bMeshOnly,
+                                    myStates(i), myErrs(i),
+                                    myNbClsfCalls(i));
+      if (myRets(i)==GEOMAlgo_FinderShapeOn2::ShapeError) {
+        break;
+      }
+    }
+    myPool->Release(iSlot);
+  }
+  //
+ protected:
+  GEOMAlgo_FinderShapeOn2& myFinder;
+  const TopTools_IndexedMapOfShape& myM;
+  NCollection_Array1<Handle(GEOMAlgo_Clsf)>& myClsfs;
+  Handle(GEOMAlgo_ContextPool) myPool;
+  NCollection_Array1<Standard_Integer>& myRets;
+  NCollection_Array1<TopAbs_State>& myStates;
+  NCollection_Array1<Standard_Integer>& myErrs;
+  NCollection_Array1<Standard_Integer>& myNbClsfCalls;
+  Standard_Integer myNbChunks;
+};
+
 //=======================================================================
 //function : ProcessEdges
 //purpose  :
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::ProcessEdges()
 {
-  myErrorStatus=0;
-  //
-  Standard_Boolean bIsConformState, bIsToBreak;
-  Standard_Integer i, aNb, iCnt, iErr;
+  ProcessShapes(TopAbs_EDGE);
+}
+//=======================================================================
+//function : ProcessFaces
+//purpose  :
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::ProcessFaces()
+{
+  ProcessShapes(TopAbs_FACE);
+}
+//=======================================================================
+//function : ProcessShapes
+//purpose  : computes the states of the edges or of the faces;
+//           in the parallel mode each chunk of the shapes has its own
+//           copy of the classifier, the shapes that have no mesh are
+//           left for the serial pass; the states are added to myMSS
+//           in the order of the shapes in both modes
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::ProcessShapes(const TopAbs_ShapeEnum aType)
+{
+  Standard_Integer i, aNb, aNbChunks, iRet, iErr, aNbCalls;
   TopAbs_State aSt;
   TopTools_IndexedMapOfShape aM;
-  TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
   //
-  TopExp::MapShapes(myShape, TopAbs_EDGE, aM);
+  myErrorStatus=0;
+  //
+  TopExp::MapShapes(myShape, aType, aM);
   aNb=aM.Extent();
+  if (!aNb) {
+    return;
+  }
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, myRunParallel);
+  const Handle(GEOMAlgo_ContextPool)& aPool=ContextPool();
+  aPool->Reserve(aNbChunks);
+  //
+  // the classifiers of the slots of the pool: myClsf is used in
+  // the slot 0, the copies for the other slots are made by the
+  // workers at the first use of the slot
+  NCollection_Array1<Handle(GEOMAlgo_Clsf)> aClsfs(0, aPool->NbSlots()-1);
+  aClsfs(0)=myClsf;
+  if (aNbChunks>1) {
+    aClsfs(1)=myClsf->Copy();
+    if (aClsfs(1).IsNull()) {
+      // the classifier can not be copied, run in one thread
+      aNbChunks=1;
+    }
+  }
+  //
+  NCollection_Array1<Standard_Integer> aRets(1, aNb), aErrs(1, aNb);
+  NCollection_Array1<Standard_Integer> aNbClsfCalls(1, aNb);
+  NCollection_Array1<TopAbs_State> aStates(1, aNb);
+  aRets.Init(ShapeSkipped);
+  aErrs.Init(0);
+  aNbClsfCalls.Init(0);
+  //
+  GEOMAlgo_FinderShapeOn2Functor aFunctor(*this, aM, aClsfs, aPool,
+                                          aRets, aStates, aErrs,
+                                          aNbClsfCalls, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+  //
+  // merge
+  aNbCalls=0;
   for (i=1; i<=aNb; ++i) {
-    GEOMAlgo_ListOfPnt aLP;
-    GEOMAlgo_StateCollector aSC;
-    //
-    const TopoDS_Edge& aE=TopoDS::Edge(aM(i));
+    iRet=aRets(i);
+    aSt=aStates(i);
+    iErr=aErrs(i);
+    if (iRet==ShapeNoMesh) {
+      iRet=ShapeState(aM(i), myClsf, myContext, Standard_False,
+                      aSt, iErr, aNbClsfCalls(i));
+    }
+    aNbCalls+=aNbClsfCalls(i);
     //
-    bIsConformState=Standard_False;
+    if (iRet==ShapeError) {
+      myErrorStatus=iErr;
+      break;
+    }
+    if (iRet==ShapeTaken) {
+      myMSS.Add(aM(i), aSt);
+    }
+  }
+  AddPhaseClsfCalls(aNbCalls);
+}
+//=======================================================================
+//function : ShapeState
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_FinderShapeOn2::ShapeState
+  (const TopoDS_Shape& aS,
+   const Handle(GEOMAlgo_Clsf)& aClsf,
+   const Handle(IntTools_Context)& aCtx,
+   const Standard_Boolean bMeshOnly,
+   TopAbs_State& aSt,
+   Standard_Integer& iErr,
+   Standard_Integer& aNbClsfCalls)
+{
+  Standard_Boolean bIsConformState, bCanBeON, bIsCached;
+  TopAbs_ShapeEnum aType, aSubType;
+  TopExp_Explorer aExp;
+  GEOMAlgo_ArrayOfPnt aLP;
+  GEOMAlgo_StateCollector aSC;
+  //
+  iErr=0;
+  aSt=TopAbs_UNKNOWN;
+  aType=aS.ShapeType();
+  aSubType=(aType==TopAbs_FACE) ? TopAbs_EDGE : TopAbs_VERTEX;
+  //
+  if (aType==TopAbs_FACE && myState==GEOMAlgo_ST_ON) {
+    Handle(Geom_Surface) aSurf;
     //
-    aExp.Init(aE, TopAbs_VERTEX);
-    for (; aExp.More(); aExp.Next()) {
-      const TopoDS_Shape& aV=aExp.Current();
-      //
-      bIsConformState=myMSS.Contains(aV);
-      if (!bIsConformState) {
-        break;// vertex has non-conformed state
-      }
-      else {
-        aSt=myMSS.FindFromKey(aV);
-        aSC.AppendState(aSt);
-      }
+    aSurf=BRep_Tool::Surface(TopoDS::Face(aS));
+    bCanBeON=aClsf->CanBeON(aSurf);
+    if(!bCanBeON) {
+      return ShapeSkipped;
     }
+  }
+  //
+  // the states of the sub-shapes
+  bIsConformState=Standard_False;
+  //
+  aExp.Init(aS, aSubType);
+  for (; aExp.More(); aExp.Next()) {
+    const TopoDS_Shape& aSS=aExp.Current();
     //
+    bIsConformState=myMSS.Contains(aSS);
     if (!bIsConformState) {
-      continue; // vertex has non-conformed state,skip edge
+      break;// sub-shape has non-conformed state
     }
+    else {
+      aSt=myMSS.FindFromKey(aSS);
+      aSC.AppendState(aSt);
+    }
+  }
+  //
+  if (!bIsConformState) {
+    return ShapeSkipped; // sub-shape has non-conformed state
+  }
+  //
+  if (myMBoxStates.Contains(aS)) {
+    // the state is known from the bounding box
+    aSt=myMBoxStates.FindFromKey(aS);
+    return StatusOfState(aType, aSt);
+  }
+  //
+  bIsCached=(!myInnerPointsCache.IsNull() &&
+             myInnerPointsCache->Find(aS, myNbPntsMin, aLP));
+  //
+  if (aType==TopAbs_EDGE) {
+    const TopoDS_Edge& aE=TopoDS::Edge(aS);
     //
     if (BRep_Tool::Degenerated(aE)) {
-      myMSS.Add(aE, aSt);
-      continue;
+      return ShapeTaken;
     }
     //
     if (myState==GEOMAlgo_ST_ON) {
-      Standard_Boolean bCanBeON;
       Standard_Real aT1, aT2;
       Handle(Geom_Curve) aC;
       //
       aC=BRep_Tool::Curve(aE, aT1, aT2);
-      bCanBeON=myClsf->CanBeON(aC);
+      bCanBeON=aClsf->CanBeON(aC);
       if(!bCanBeON) {
-        continue;
+        return ShapeSkipped;
       }
     }
     //
-    InnerPoints(aE, aLP);
-    if (myErrorStatus) {
-      return;
+    if (bIsCached) {
+      // the points are taken from the cache
     }
-    //
-    bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
-      if (myNbPntsMax) {
-        if (iCnt > myNbPntsMax) {
-          break;
-        }
+    else if (bMeshOnly) {
+      if (!MeshInnerPoints(aE, aLP)) {
+        return ShapeNoMesh;
       }
-      //
-      const gp_Pnt& aP=aIt.Value();
-      //
-      myClsf->SetPnt(aP);
-      myClsf->Perform();
-      iErr=myClsf->ErrorStatus();
-      if (iErr) {
-        myErrorStatus=40; // point can not be classified
-        return;
+      if (aLP.empty() && myNbPntsMin) {
+        InnerPoints(aE, myNbPntsMin, aLP);
       }
-      //
-      aSt=myClsf->State();
-      //
-      bIsToBreak=aSC.AppendState(aSt);
-      if (bIsToBreak) {
-        break;
+    }
+    else {
+      InnerPoints(aE, aLP);
+      if (myErrorStatus) {
+        iErr=myErrorStatus;
+        return ShapeError;
       }
     }
+  }
+  else {
+    const TopoDS_Face& aF=TopoDS::Face(aS);
     //
-    aSt=aSC.State();
-    //
-    bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
-    if (myShapeType==TopAbs_EDGE) {
-      if (bIsConformState) {
-        myMSS.Add(aE, aSt);
+    if (bIsCached) {
+      // the points are taken from the cache
+    }
+    else if (bMeshOnly) {
+      if (!MeshInnerPoints(aF, aLP)) {
+        return ShapeNoMesh;
+      }
+      if (aLP.empty() && myNbPntsMin) {
+        iErr=HatchInnerPoints(aF, aCtx, aLP);
+        if (iErr) {
+          return ShapeError;
+        }
       }
     }
-    else if (bIsConformState || aSt==TopAbs_ON) {
-      myMSS.Add(aE, aSt);
+    else {
+      InnerPoints(aF, aLP);
+      if (myErrorStatus) {
+        iErr=myErrorStatus;
+        return ShapeError;
+      }
     }
-  } //  for (i=1; i<=aNb; ++i) next edge
+  }
+  //
+  if (!bIsCached && !aLP.empty() && !myInnerPointsCache.IsNull()) {
+    myInnerPointsCache->Add(aS, myNbPntsMin, aLP);
+  }
+  //
+  iErr=ClassifyPoints(aClsf, aLP, aSC, aNbClsfCalls);
+  if (iErr) {
+    return ShapeError;
+  }
+  //
+  aSt=aSC.State();
+  //
+  return StatusOfState(aType, aSt);
 }
 //=======================================================================
-//function : ProcessFaces
-//purpose  :
+//function : StatusOfState
+//purpose  : the shapes of myShapeType are taken if the state is
+//           conform to myState, the other ones if it is ON as well
 //=======================================================================
-void GEOMAlgo_FinderShapeOn2::ProcessFaces()
+Standard_Integer GEOMAlgo_FinderShapeOn2::StatusOfState
+  (const TopAbs_ShapeEnum aType,
+   const TopAbs_State aSt) const
 {
-  myErrorStatus=0;
+  Standard_Boolean bIsConformState;
   //
-  Standard_Boolean bIsConformState, bIsToBreak, bCanBeON;
-  Standard_Integer i, aNbF, iCnt, iErr;
-  TopAbs_State aSt;
-  TopTools_IndexedMapOfShape aM;
-  TopExp_Explorer aExp;
-  GEOMAlgo_ListIteratorOfListOfPnt aIt;
+  bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
+  if (myShapeType==aType) {
+    return bIsConformState ? ShapeTaken : ShapeSkipped;
+  }
+  return (bIsConformState || aSt==TopAbs_ON) ? ShapeTaken : ShapeSkipped;
+}
+//=======================================================================
+//function : ClassifyPoints
+//purpose  : classifies the points of aLP (not more than myNbPntsMax+1
+//           if myNbPntsMax is set) and appends the states to aSC;
+//           the points are passed to the classifier by blocks of
+//           aClsf->NbPntsPerBlock() points; the expensive classifiers
+//           take one point at a time, so no point is classified after
+//           aSC has the answer
+//=======================================================================
+Standard_Integer GEOMAlgo_FinderShapeOn2::ClassifyPoints
+  (const Handle(GEOMAlgo_Clsf)& aClsf,
+   const GEOMAlgo_ArrayOfPnt& aLP,
+   GEOMAlgo_StateCollector& aSC,
+   Standard_Integer& aNbClsfCalls) const
+{
+  const Standard_Integer aNbBlockMax=64;
+  Standard_Boolean bIsToBreak;
+  Standard_Integer i, iCnt, aNb, aNbP, aNbBlock, iErr;
+  TopAbs_State aStates[aNbBlockMax];
   //
-  TopExp::MapShapes(myShape, TopAbs_FACE, aM);
-  aNbF=aM.Extent();
-  for (i=1; i<=aNbF; ++i) {
-    GEOMAlgo_StateCollector aSC;
-    GEOMAlgo_ListOfPnt aLP;
-    //
-    const TopoDS_Face& aF=TopoDS::Face(aM(i));
-    //
-    if (myState==GEOMAlgo_ST_ON) {
-      Handle(Geom_Surface) aS;
-      //
-      aS=BRep_Tool::Surface(aF);
-      bCanBeON=myClsf->CanBeON(aS);
-      if(!bCanBeON) {
-        continue;
-      }
-    }
-    //
-    //
-    bIsConformState=Standard_False;
-    //
-    aExp.Init(aF, TopAbs_EDGE);
-    for (; aExp.More(); aExp.Next()) {
-      const TopoDS_Shape& aE=aExp.Current();
-      bIsConformState=myMSS.Contains(aE);
-      if (!bIsConformState) {
-        break;// edge has non-conformed state
-      }
-      else {
-        aSt=myMSS.FindFromKey(aE);
-        aSC.AppendState(aSt);
-      }
-    }
-    //
-    if (!bIsConformState) {
-      continue; // edge has non-conformed state,skip face
-    }
+  aNbBlock=Max(1, Min(aNbBlockMax, aClsf->NbPntsPerBlock()));
+  //
+  aNb=(Standard_Integer)aLP.size();
+  if (myNbPntsMax) {
+    aNb=Min(aNb, myNbPntsMax+1);
+  }
+  //
+  for (iCnt=0; iCnt<aNb; iCnt+=aNbP) {
+    aNbP=Min(aNbBlock, aNb-iCnt);
     //
-    InnerPoints(aF, aLP);
-    if (myErrorStatus) {
-      return;
+    aClsf->Perform(&aLP[iCnt], aNbP, aStates);
+    aNbClsfCalls+=aNbP;
+    iErr=aClsf->ErrorStatus();
+    if (iErr) {
+      return 40; // point can not be classified
     }
     //
-    bIsConformState=Standard_True;
-    aIt.Initialize(aLP);
-    for (iCnt=0; aIt.More(); aIt.Next(), ++iCnt) {
-      if (myNbPntsMax) {
-        if (iCnt > myNbPntsMax) {
-          break;
-        }
-      }
-      //
-      const gp_Pnt& aP=aIt.Value();
-      //
-      myClsf->SetPnt(aP);
-      myClsf->Perform();
-      iErr=myClsf->ErrorStatus();
-      if (iErr) {
-        myErrorStatus=40; // point can not be classified
-        return;
-      }
-      //
-      aSt=myClsf->State();
-      //
-      bIsToBreak=aSC.AppendState(aSt);
+    for (i=0; i<aNbP; ++i) {
+      bIsToBreak=aSC.AppendState(aStates[i]);
       if (bIsToBreak) {
-        break;
+        return 0;
       }
     }
-    //
-    aSt=aSC.State();
-    //
-    bIsConformState=GEOMAlgo_SurfaceTools::IsConformState(aSt, myState);
-    if (myShapeType==TopAbs_FACE) {
-      if (bIsConformState) {
-        myMSS.Add(aF, aSt);
-      }
-    }
-    else if (bIsConformState || aSt==TopAbs_ON) {
-      myMSS.Add(aF, aSt);
-    }
-  }//  for (i=1; i<=aNb; ++i) next face
+  }
+  return 0;
 }
 //=======================================================================
 //function : ProcessSolids
@@ -588,183 +884,198 @@ void GEOMAlgo_FinderShapeOn2::ProcessSolids()
 }
 //
 //=======================================================================
-//function : InnerPoints
-//purpose  :
+//function : MeshInnerPoints
+//purpose  : the nodes of the triangulation of aF that are not on 
+//           the boundary of the triangulation; 
+//           returns False if aF has no triangulation
 //=======================================================================
-void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Face& aF,
-                                          GEOMAlgo_ListOfPnt& aLP)
+Standard_Boolean GEOMAlgo_FinderShapeOn2::MeshInnerPoints
+  (const TopoDS_Face& aF,
+   GEOMAlgo_ArrayOfPnt& aLP) const
 {
-  Standard_Integer j, j1, j2, k, n[4], aNx, aNb, iCnt;//, aNbLinks, aNbMax, *pIds;
+  Standard_Integer j, aNbInner;
   TopLoc_Location aLoc;
   Handle(Poly_Triangulation) aTRF;
-  TColStd_MapOfInteger aMBN;
-  GEOMAlgo_DataMapOfPassKeyInteger aMPKI;
-  GEOMAlgo_DataMapIteratorOfDataMapOfPassKeyInteger aIt;
-  gp_Pnt aP, aP1, aP2;
-  // 
-  myErrorStatus=0;
+  NCollection_Array1<Standard_Boolean> aIsBoundary;
+  gp_Pnt aP;
   //
-  aLP.Clear();
+  aLP.clear();
   //
   aTRF=BRep_Tool::Triangulation(aF, aLoc);
   if (aTRF.IsNull()) {
-    if (!BuildTriangulation(aF)) {
-      myWarningStatus=20; // no triangulation found
-      return;
-    }
-    aTRF=BRep_Tool::Triangulation(aF, aLoc);
+    return Standard_False;
   }
   //
   const gp_Trsf& aTrsf=aLoc.Transformation();
-  const Poly_Array1OfTriangle& aTrs=aTRF->Triangles();
   const TColgp_Array1OfPnt& aNodes=aTRF->Nodes();
   //
-  // map link/nbtriangles
-  j1=aTrs.Lower();
-  j2=aTrs.Upper();
-  for (j=j1; j<=j2; ++j) {
-    const Poly_Triangle& aTr=aTrs(j);
-    aTr.Get(n[0], n[1], n[2]);
-    n[3]=n[0];
-    for (k=0; k<3; ++k) {
-      GEOMAlgo_PassKey aPK;
-      //
-      aPK.SetIds(n[k], n[k+1]);
-      if (aMPKI.IsBound(aPK)) {
-        Standard_Integer& iCntX=aMPKI.ChangeFind(aPK);
-        ++iCntX;
-      }
-      else {
-        aMPKI.Bind(aPK, 1);
-      }
-    }
+  // inner nodes=all_nodes - boundary_nodes
+  aNbInner=GEOMAlgo_AlgoTools::BoundaryNodes(aTRF, aIsBoundary);
+  if (!aNbInner) {
+    return Standard_True;
   }
-  //
-  // boundary nodes aMBN
-  aIt.Initialize(aMPKI);
-  for (; aIt.More(); aIt.Next()) {
-    iCnt=aIt.Value();
-    if (iCnt==1) {
-      const GEOMAlgo_PassKey& aPK=aIt.Key();
-      aNx=(Standard_Integer)aPK.Id(1);
-      aMBN.Add(aNx);
-      aNx=(Standard_Integer)aPK.Id(2);
-      aMBN.Add(aNx);
-      
+  aLP.reserve(aNbInner);
+  for (j=aNodes.Lower(); j<=aNodes.Upper(); ++j) {
+    if (!aIsBoundary(j)) {
+      aP=aNodes(j).Transformed(aTrsf);
+      aLP.push_back(aP);
     }
   }
+  return Standard_True;
+}
+//=======================================================================
+//function : InnerPoints
+//purpose  :
+//=======================================================================
+void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Face& aF,
+                                          GEOMAlgo_ArrayOfPnt& aLP)
+{
+  Standard_Integer aNb;
+  // 
+  myErrorStatus=0;
   //
-  // inner nodes=all_nodes - boundary_nodes
-  j1=aNodes.Lower();
-  j2=aNodes.Upper();
-  for (j=j1; j<=j2; ++j) {
-    if (!aMBN.Contains(j)) {
-      aP=aNodes(j).Transformed(aTrsf);
-      aLP.Append(aP);
+  if (!MeshInnerPoints(aF, aLP)) {
+    if (!BuildTriangulation(aF)) {
+      myWarningStatus=20; // no triangulation found
+      return;
     }
+    MeshInnerPoints(aF, aLP);
   }
   //
-  aNb=aLP.Extent();
+  aNb=(Standard_Integer)aLP.size();
   //
   //modified by NIZNHY-PKV Mon Sep 24 08:42:32 2012f
   if (!aNb && myNbPntsMin) {    // A
-    Standard_Boolean bIsDone, bHasFirstPoint, bHasSecondPoint;
-    Standard_Integer i, aNb, aIx, /*iErr, */aNbDomains;
-    Standard_Real aUMin, aUMax, aVMin, aVMax, dU, aUx, aVx, aV1, aV2;
-    gp_Pnt aPx;
-    gp_Dir2d aD2D (0., 1.);
-    gp_Pnt2d aP2D;
-    Handle(Geom2d_Line) aL2D;
-    Handle(Geom_Surface) aS;
-    TopoDS_Face aFF;
+    myErrorStatus=HatchInnerPoints(aF, myContext, aLP);
+  }
+}
+//=======================================================================
+//function : HatchInnerPoints
+//purpose  : the points are taken in the middles of the domains of
+//           the iso-lines of the face; the hatcher of aCtx is used
+//=======================================================================
+Standard_Integer GEOMAlgo_FinderShapeOn2::HatchInnerPoints
+  (const TopoDS_Face& aF,
+   const Handle(IntTools_Context)& aCtx,
+   GEOMAlgo_ArrayOfPnt& aLP) const
+{
+  Standard_Boolean bIsDone, bHasFirstPoint, bHasSecondPoint;
+  Standard_Integer i, j, aNb, aIx, aNbDomains;
+  Standard_Real aUMin, aUMax, aVMin, aVMax, dU, aUx, aVx, aV1, aV2;
+  gp_Pnt aPx;
+  gp_Dir2d aD2D (0., 1.);
+  gp_Pnt2d aP2D;
+  Handle(Geom2d_Line) aL2D;
+  Handle(Geom_Surface) aS;
+  TopoDS_Face aFF;
+  //
+  aFF=aF;
+  aFF.Orientation (TopAbs_FORWARD);
+  //
+  Geom2dHatch_Hatcher& aHatcher=aCtx->Hatcher(aFF);
+  //
+  aS=BRep_Tool::Surface(aFF);
+  BRepTools::UVBounds(aFF, aUMin, aUMax, aVMin, aVMax);
+  //
+  aNb=myNbPntsMin+1;
+  dU=(aUMax-aUMin)/aNb;
+  for (i=1; i<aNb; ++i) {
+    aUx=aUMin+i*dU;
+    aP2D.SetCoord(aUx, 0.);
+    aL2D=new Geom2d_Line (aP2D, aD2D);
+    Geom2dAdaptor_Curve aHCur(aL2D);
     //
-    aFF=aF;
-    aFF.Orientation (TopAbs_FORWARD);
+    aHatcher.ClrHatchings();
+    aIx=aHatcher.AddHatching(aHCur);
     //
-    Geom2dHatch_Hatcher& aHatcher=myContext->Hatcher(aFF);
+    aHatcher.Trim(aIx);
+    bIsDone=aHatcher.TrimDone(aIx);
+    if (!bIsDone) {
+      return 42;
+    }
     //
-    aS=BRep_Tool::Surface(aFF);
-    BRepTools::UVBounds(aFF, aUMin, aUMax, aVMin, aVMax);
+    aHatcher.ComputeDomains(aIx);
+    bIsDone=aHatcher.IsDone(aIx);
+    if (!bIsDone) {
+      continue;
+    }
     //
-    aNb=myNbPntsMin+1;
-    dU=(aUMax-aUMin)/aNb;
-    for (i=1; i<aNb; ++i) {
-      aUx=aUMin+i*dU;
-      aP2D.SetCoord(aUx, 0.);
-      aL2D=new Geom2d_Line (aP2D, aD2D);
-      Geom2dAdaptor_Curve aHCur(aL2D);
-      //
-      aHatcher.ClrHatchings();
-      aIx=aHatcher.AddHatching(aHCur);
-      //
-      aHatcher.Trim(aIx);
-      bIsDone=aHatcher.TrimDone(aIx);
-      if (!bIsDone) {
-        myErrorStatus=42;
-        return;
-      }
-      //
-      aHatcher.ComputeDomains(aIx);
-      bIsDone=aHatcher.IsDone(aIx);
-      if (!bIsDone) {
+    aNbDomains=aHatcher.NbDomains(aIx);
+    for (j=1; j<=aNbDomains; ++j) {
+      const HatchGen_Domain& aDomain=aHatcher.Domain (aIx, j) ; 
+      // 1
+      bHasFirstPoint=aDomain.HasFirstPoint();
+      bHasSecondPoint=aDomain.HasSecondPoint();
+      if (!bHasFirstPoint || !bHasSecondPoint) {
         continue;
       }
-      //
-      aNbDomains=aHatcher.NbDomains(aIx);
-      for (j=1; j<=aNbDomains; ++j) {
-        const HatchGen_Domain& aDomain=aHatcher.Domain (aIx, j) ; 
-        // 1
-        bHasFirstPoint=aDomain.HasFirstPoint();
-        bHasSecondPoint=aDomain.HasSecondPoint();
-        if (!bHasFirstPoint || !bHasSecondPoint) {
-          continue;
-        }
-        // 2
-        aV1=aDomain.FirstPoint().Parameter();
-        aV2=aDomain.SecondPoint().Parameter();
-        aVx=IntTools_Tools::IntermediatePoint(aV1, aV2);
-        // 3
-        aS->D0(aUx, aVx, aPx);
-        aLP.Append(aPx);
-        break;
-      }
-    }// for (i=1; i<aNb; ++i) {
-  }// if (!aNb && myNbPntsMin) {
+      // 2
+      aV1=aDomain.FirstPoint().Parameter();
+      aV2=aDomain.SecondPoint().Parameter();
+      aVx=IntTools_Tools::IntermediatePoint(aV1, aV2);
+      // 3
+      aS->D0(aUx, aVx, aPx);
+      aLP.push_back(aPx);
+      break;
+    }
+  }// for (i=1; i<aNb; ++i) {
+  return 0;
 }
 //=======================================================================
 //function : InnerPoints
 //purpose  :
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Edge& aE,
-                                          GEOMAlgo_ListOfPnt& aLP)
+                                          GEOMAlgo_ArrayOfPnt& aLP)
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, aNbNodes, aIndex, aNb;
+  Standard_Integer aNb;
+  //
+  if (!MeshInnerPoints(aE, aLP)) {
+    if (!BuildTriangulation(aE)) {
+      myErrorStatus=20; // no triangulation found
+      return;
+    }
+    MeshInnerPoints(aE, aLP);
+  }
+  //
+  aNb=(Standard_Integer)aLP.size();
+  if (!aNb && myNbPntsMin) {
+    // try to fill it yourself
+    InnerPoints(aE, myNbPntsMin, aLP);
+    aNb=(Standard_Integer)aLP.size();
+  }
+}
+//=======================================================================
+//function : MeshInnerPoints
+//purpose  : the inner nodes of the polygon of aE;
+//           returns False if aE has no polygon
+//=======================================================================
+Standard_Boolean GEOMAlgo_FinderShapeOn2::MeshInnerPoints
+  (const TopoDS_Edge& aE,
+   GEOMAlgo_ArrayOfPnt& aLP) const
+{
+  Standard_Integer j, aNbNodes, aIndex;
   Handle(Poly_PolygonOnTriangulation) aPTE;
   Handle(Poly_Triangulation) aTRE;
   TopLoc_Location aLoc;
   gp_Pnt aP;
   //
-  aLP.Clear();
+  aLP.clear();
   BRep_Tool::PolygonOnTriangulation(aE, aPTE, aTRE, aLoc);
   if (aTRE.IsNull() || aPTE.IsNull()) {
     Handle(Poly_Polygon3D) aPE = BRep_Tool::Polygon3D(aE, aLoc);
     if (aPE.IsNull()) {
-      if (!BuildTriangulation(aE)) {
-        myErrorStatus=20; // no triangulation found
-        return;
-      }
-      aPE = BRep_Tool::Polygon3D(aE, aLoc);
+      return Standard_False;
     }
     const gp_Trsf& aTrsf=aLoc.Transformation();
     const TColgp_Array1OfPnt& aNodes=aPE->Nodes();
     //
-    aNbNodes=aPE->NbNodes();
     Standard_Integer low = aNodes.Lower(), up = aNodes.Upper();
     for (j=low+1; j<up; ++j) {
       aP=aNodes(j).Transformed(aTrsf);
-      aLP.Append(aP);
+      aLP.push_back(aP);
     }
   }
   else {
@@ -776,16 +1087,10 @@ void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Edge& aE,
     for (j=2; j<aNbNodes; ++j) {
       aIndex=aInds(j);
       aP=aNodes(aIndex).Transformed(aTrsf);
-      aLP.Append(aP);
+      aLP.push_back(aP);
     }
   }
-  //
-  aNb=aLP.Extent();
-  if (!aNb && myNbPntsMin) {
-    // try to fill it yourself
-    InnerPoints(aE, myNbPntsMin, aLP);
-    aNb=aLP.Extent();
-  }
+  return Standard_True;
 }
 //=======================================================================
 //function : InnerPoints
@@ -793,7 +1098,7 @@ void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Edge& aE,
 //=======================================================================
 void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Edge& aE,
                                           const Standard_Integer aNbPntsMin,
-                                          GEOMAlgo_ListOfPnt& aLP)
+                                          GEOMAlgo_ArrayOfPnt& aLP) const
 {
   // try to fill it yourself
   Standard_Boolean bInf1, bInf2;
@@ -818,7 +1123,7 @@ void GEOMAlgo_FinderShapeOn2::InnerPoints(const TopoDS_Edge& aE,
   for (j=1; j<=aNbPntsMin; ++j) {
     aT=aT1+j*dT;
     aC3D->D0(aT, aP);
-    aLP.Append(aP);
+    aLP.push_back(aP);
   }
 }
 
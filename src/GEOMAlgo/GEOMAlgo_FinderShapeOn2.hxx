@@ -36,13 +36,16 @@
 
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Edge.hxx>
+#include <TopoDS_Shape.hxx>
 
 #include <TopTools_ListOfShape.hxx>
 
 #include <GEOMAlgo_IndexedDataMapOfShapeState.hxx>
 #include <GEOMAlgo_State.hxx>
-#include <GEOMAlgo_ListOfPnt.hxx>
+#include <GEOMAlgo_ArrayOfPnt.hxx>
+#include <GEOMAlgo_StateCollector.hxx>
 #include <GEOMAlgo_Clsf.hxx>
+#include <GEOMAlgo_InnerPointsCache.hxx>
 #include <GEOMAlgo_ShapeAlgo.hxx>
 
 //=======================================================================
@@ -88,6 +91,15 @@ class GEOMAlgo_FinderShapeOn2  : public GEOMAlgo_ShapeAlgo
   Standard_EXPORT
     Standard_Integer NbPntsMax() const;
 
+  //! Sets the cache of the inner points of the edges and the faces. <br>
+  //!          The cache can be shared by the finders that work on the <br>
+  //!          same shapes, the points found in it are not computed again. <br>
+  Standard_EXPORT
+    void SetInnerPointsCache(const Handle(GEOMAlgo_InnerPointsCache)& aCache) ;
+
+  Standard_EXPORT
+    const Handle(GEOMAlgo_InnerPointsCache)& InnerPointsCache() const;
+
   Standard_EXPORT
     virtual  void Perform() ;
 
@@ -98,9 +110,22 @@ class GEOMAlgo_FinderShapeOn2  : public GEOMAlgo_ShapeAlgo
     const GEOMAlgo_IndexedDataMapOfShapeState& MSS() const;
 
 protected:
+  //! The result of the computation of the state of one shape <br>
+  enum ShapeStatus {
+    ShapeSkipped,
+    ShapeTaken,
+    ShapeNoMesh,
+    ShapeError
+  };
+
+  friend class GEOMAlgo_FinderShapeOn2Functor;
+
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    void ProcessBoxes() ;
+
   Standard_EXPORT
     void ProcessVertices() ;
 
@@ -113,30 +138,78 @@ protected:
   Standard_EXPORT
     void ProcessSolids() ;
 
+  //! Computes the states of the edges or of the faces of myShape <br>
+  //! and adds them to myMSS. If myRunParallel is set the shapes are <br>
+  //! processed in parallel, each thread has its own copy of myClsf. <br>
+  Standard_EXPORT
+    void ProcessShapes(const TopAbs_ShapeEnum aType) ;
+
+  //! Computes the state aSt of the edge or of the face aS using the <br>
+  //! classifier aClsf and the context aCtx. If bMeshOnly is set, the <br>
+  //! shape is not meshed and ShapeNoMesh is returned if the shape <br>
+  //! has no mesh. <br>
+  //! Returns the status of the shape, iErr is set for ShapeError. <br>
+  Standard_EXPORT
+    Standard_Integer ShapeState(const TopoDS_Shape& aS,
+                                const Handle(GEOMAlgo_Clsf)& aClsf,
+                                const Handle(IntTools_Context)& aCtx,
+                                const Standard_Boolean bMeshOnly,
+                                TopAbs_State& aSt,
+                                Standard_Integer& iErr,
+                                Standard_Integer& aNbClsfCalls) ;
+
   Standard_EXPORT
     void InnerPoints(const TopoDS_Face& aF,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) ;
 
   Standard_EXPORT
     void InnerPoints(const TopoDS_Edge& aE,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) ;
+
+  //! Computes myNbPntsMin points inside the face aF using <br>
+  //! the hatcher of aCtx. Returns 42 if the hatching fails. <br>
+  Standard_EXPORT
+    Standard_Integer HatchInnerPoints(const TopoDS_Face& aF,
+                                      const Handle(IntTools_Context)& aCtx,
+                                      GEOMAlgo_ArrayOfPnt& aLP) const;
 
   Standard_EXPORT
     void InnerPoints(const TopoDS_Edge& aE,
                      const Standard_Integer aNbPnts,
-                     GEOMAlgo_ListOfPnt& aLP) ;
+                     GEOMAlgo_ArrayOfPnt& aLP) const;
+
+  Standard_EXPORT
+    Standard_Integer StatusOfState(const TopAbs_ShapeEnum aType,
+                                   const TopAbs_State aSt) const;
+
+  Standard_EXPORT
+    Standard_Boolean MeshInnerPoints(const TopoDS_Face& aF,
+                                     GEOMAlgo_ArrayOfPnt& aLP) const;
+
+  Standard_EXPORT
+    Standard_Boolean MeshInnerPoints(const TopoDS_Edge& aE,
+                                     GEOMAlgo_ArrayOfPnt& aLP) const;
 
   Standard_EXPORT
     Standard_Boolean BuildTriangulation(const TopoDS_Shape& aS) ;
 
+  Standard_EXPORT
+    Standard_Integer ClassifyPoints(const Handle(GEOMAlgo_Clsf)& aClsf,
+                                    const GEOMAlgo_ArrayOfPnt& aLP,
+                                    GEOMAlgo_StateCollector& aSC,
+                                    Standard_Integer& aNbClsfCalls) const;
+
 
   TopAbs_ShapeEnum myShapeType;
   GEOMAlgo_State myState;
   Standard_Integer myNbPntsMin;
   Standard_Integer myNbPntsMax;
   Handle(GEOMAlgo_Clsf) myClsf;
+  Handle(GEOMAlgo_InnerPointsCache) myInnerPointsCache;
   TopTools_ListOfShape myLS;
   GEOMAlgo_IndexedDataMapOfShapeState myMSS;
+  // the states of the shapes found by the bounding boxes
+  GEOMAlgo_IndexedDataMapOfShapeState myMBoxStates;
 };
 
 #endif
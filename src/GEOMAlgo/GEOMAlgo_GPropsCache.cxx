@@ -0,0 +1,279 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_GPropsCache.cxx
+//
+#include <GEOMAlgo_GPropsCache.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
+
+#include <TopAbs_Orientation.hxx>
+#include <GProp_GProps.hxx>
+#include <BRepGProp.hxx>
+
+#include <OSD_Parallel.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_GPropsCache, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_GPropsCacheFunctor
+//purpose  : computes the properties of the chunk of the shapes
+//=======================================================================
+class GEOMAlgo_GPropsCacheFunctor
+{
+ public:
+  GEOMAlgo_GPropsCacheFunctor(GEOMAlgo_GPropsCache& theCache,
+                              const TopTools_IndexedMapOfShape& theMS,
+                              const Standard_Integer theDim,
+                              const Standard_Real theEps,
+                              const Standard_Integer theNbChunks)
+  :
+    myCache(theCache),
+    myMS(theMS),
+    myDim(theDim),
+    myEps(theEps),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    Standard_Real aMass;
+    gp_Pnt aCG;
+    //
+    aNb=myMS.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myCache.Properties(myMS(i), myDim, myEps, aMass, aCG);
+    }
+  }
+  //
+ protected:
+  GEOMAlgo_GPropsCache& myCache;
+  const TopTools_IndexedMapOfShape& myMS;
+  Standard_Integer myDim;
+  Standard_Real myEps;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//function : GEOMAlgo_GPropsCache
+//purpose  :
+//=======================================================================
+GEOMAlgo_GPropsCache::GEOMAlgo_GPropsCache()
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_GPropsCache::~GEOMAlgo_GPropsCache()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::Clear()
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  myMap.Clear();
+}
+//=======================================================================
+//function : Remove
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::Remove(const TopoDS_Shape& aS)
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  myMap.UnBind(aS);
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GPropsCache::Extent() const
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  return myMap.Extent();
+}
+//=======================================================================
+//function : Properties
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GPropsCache::Properties(const TopoDS_Shape& aS,
+                                                  const Standard_Integer aDim,
+                                                  const Standard_Real aEps,
+                                                  Standard_Real& aMass,
+                                                  gp_Pnt& aCG)
+{
+  TopAbs_Orientation aOr;
+  //
+  if (aDim<1 || aDim>3) {
+    return Standard_False;
+  }
+  //
+  aOr=aS.Orientation();
+  if (!(aOr==TopAbs_FORWARD || aOr==TopAbs_REVERSED)) {
+    return Compute(aS, aDim, aEps, aMass, aCG);
+  }
+  //
+  if (!Find(aS, aDim, aEps, aMass, aCG)) {
+    // computed out of the lock, a concurrent computation of
+    // the same shape gives the same values
+    Compute(aS.Oriented(TopAbs_FORWARD), aDim, aEps, aMass, aCG);
+    Add(aS, aDim, aEps, aMass, aCG);
+  }
+  //
+  if (aDim==3 && aOr==TopAbs_REVERSED) {
+    aMass=-aMass;
+  }
+  return Standard_True;
+}
+//=======================================================================
+//function : Fill
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::Fill(const TopTools_IndexedMapOfShape& aMS,
+                                const Standard_Integer aDim,
+                                const Standard_Real aEps,
+                                const Standard_Boolean bRunParallel)
+{
+  Standard_Integer aNb, aNbChunks;
+  //
+  aNb=aMS.Extent();
+  if (!aNb) {
+    return;
+  }
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, bRunParallel);
+  //
+  GEOMAlgo_GPropsCacheFunctor aFunctor(*this, aMS, aDim, aEps, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+}
+//=======================================================================
+//function : Compute
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GPropsCache::Compute(const TopoDS_Shape& aS,
+                                               const Standard_Integer aDim,
+                                               const Standard_Real aEps,
+                                               Standard_Real& aMass,
+                                               gp_Pnt& aCG)
+{
+  Standard_Boolean bOnlyClosed;
+  GProp_GProps aGProps;
+  //
+  bOnlyClosed=Standard_False;
+  if (aDim==1) {
+    BRepGProp::LinearProperties(aS, aGProps);
+  }
+  else if (aDim==2) {
+    if (aEps>0.) {
+      BRepGProp::SurfaceProperties(aS, aGProps, aEps);
+    }
+    else {
+      BRepGProp::SurfaceProperties(aS, aGProps);
+    }
+  }
+  else if (aDim==3) {
+    if (aEps>0.) {
+      BRepGProp::VolumeProperties(aS, aGProps, aEps, bOnlyClosed);
+    }
+    else {
+      BRepGProp::VolumeProperties(aS, aGProps, bOnlyClosed);
+    }
+  }
+  else {
+    return Standard_False;
+  }
+  //
+  aMass=aGProps.Mass();
+  aCG=aGProps.CentreOfMass();
+  return Standard_True;
+}
+//=======================================================================
+//function : Dimension
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GPropsCache::Dimension(const TopAbs_ShapeEnum aType)
+{
+  Standard_Integer iDim;
+  //
+  iDim=-1;
+  switch (aType) {
+    case TopAbs_VERTEX:
+      iDim=0;
+      break;
+    case TopAbs_EDGE:
+    case TopAbs_WIRE:
+      iDim=1;
+      break;
+    case TopAbs_FACE:
+    case TopAbs_SHELL:
+      iDim=2;
+      break;
+    case TopAbs_SOLID:
+    case TopAbs_COMPSOLID:
+      iDim=3;
+      break;
+    default:
+      break;
+  }
+  return iDim;
+}
+//=======================================================================
+//function : Find
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GPropsCache::Find(const TopoDS_Shape& aS,
+                                            const Standard_Integer aDim,
+                                            const Standard_Real aEps,
+                                            Standard_Real& aMass,
+                                            gp_Pnt& aCG) const
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  //
+  const Entry* pEntry=myMap.Seek(aS);
+  if (!pEntry || !pEntry->myDone[aDim] || pEntry->myEps[aDim]!=aEps) {
+    return Standard_False;
+  }
+  aMass=pEntry->myMass[aDim];
+  aCG=pEntry->myCG[aDim];
+  return Standard_True;
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GPropsCache::Add(const TopoDS_Shape& aS,
+                               const Standard_Integer aDim,
+                               const Standard_Real aEps,
+                               const Standard_Real aMass,
+                               const gp_Pnt& aCG)
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  //
+  Entry* pEntry=myMap.ChangeSeek(aS);
+  if (!pEntry) {
+    pEntry=myMap.Bound(aS, Entry());
+  }
+  pEntry->myDone[aDim]=Standard_True;
+  pEntry->myEps[aDim]=aEps;
+  pEntry->myMass[aDim]=aMass;
+  pEntry->myCG[aDim]=aCG;
+}
@@ -0,0 +1,141 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_GPropsCache.hxx
+//
+#ifndef _GEOMAlgo_GPropsCache_HeaderFile
+#define _GEOMAlgo_GPropsCache_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Mutex.hxx>
+#include <gp_Pnt.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <NCollection_DataMap.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_GPropsCache, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_GPropsCache
+//purpose  : The global properties (length, area or volume and the
+//           centre of mass) of the shapes computed by BRepGProp,
+//           kept to be reused by GetInPlace, GetInPlaceAPI and
+//           ShapeInfoFiller working on the same shapes.
+//           The properties are keyed by the shape (TShape and Location)
+//           and by the dimension (1 - length, 2 - area, 3 - volume);
+//           they are stored for the forward shape, the volume of a
+//           reversed shape is negated when it is returned.
+//           The properties computed with one precision of the
+//           integration are not returned for another one.
+//           The cache can be used by several threads at once.
+//=======================================================================
+class GEOMAlgo_GPropsCache : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_GPropsCache();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_GPropsCache();
+
+  //! Removes all properties <br>
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Removes the properties of the shape aS, e.g. after aS <br>
+  //!          was modified in place <br>
+  Standard_EXPORT
+    void Remove(const TopoDS_Shape& aS) ;
+
+  //! Returns the number of the shapes in the cache <br>
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns the properties of the dimension aDim (1, 2 or 3) <br>
+  //!          of the shape aS computed with the precision aEps <br>
+  //!          (0. - the default integration of BRepGProp). <br>
+  //!          Computes and stores them if they are not in the cache. <br>
+  //!          Returns False if aDim is not supported. <br>
+  Standard_EXPORT
+    Standard_Boolean Properties(const TopoDS_Shape& aS,
+                                const Standard_Integer aDim,
+                                const Standard_Real aEps,
+                                Standard_Real& aMass,
+                                gp_Pnt& aCG) ;
+
+  //! Computes in parallel the missing properties of the dimension <br>
+  //!          aDim of the shapes aMS <br>
+  Standard_EXPORT
+    void Fill(const TopTools_IndexedMapOfShape& aMS,
+              const Standard_Integer aDim,
+              const Standard_Real aEps,
+              const Standard_Boolean bRunParallel) ;
+
+  //! Computes the properties of the dimension aDim of the shape aS <br>
+  //!          without the cache <br>
+  Standard_EXPORT
+    static Standard_Boolean Compute(const TopoDS_Shape& aS,
+                                    const Standard_Integer aDim,
+                                    const Standard_Real aEps,
+                                    Standard_Real& aMass,
+                                    gp_Pnt& aCG) ;
+
+  //! Returns the dimension of the properties of the shape type: <br>
+  //!          0 - vertex, 1 - edge, wire, 2 - face, shell, <br>
+  //!          3 - solid, compsolid, -1 - compound <br>
+  Standard_EXPORT
+    static Standard_Integer Dimension(const TopAbs_ShapeEnum aType) ;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_GPropsCache, Standard_Transient)
+
+ protected:
+  Standard_Boolean Find(const TopoDS_Shape& aS,
+                        const Standard_Integer aDim,
+                        const Standard_Real aEps,
+                        Standard_Real& aMass,
+                        gp_Pnt& aCG) const;
+
+  void Add(const TopoDS_Shape& aS,
+           const Standard_Integer aDim,
+           const Standard_Real aEps,
+           const Standard_Real aMass,
+           const gp_Pnt& aCG) ;
+
+  struct Entry {
+    Entry() {
+      myDone[0]=myDone[1]=myDone[2]=myDone[3]=Standard_False;
+    }
+    Standard_Boolean myDone[4];
+    Standard_Real myEps[4];
+    Standard_Real myMass[4];
+    gp_Pnt myCG[4];
+  };
+  typedef NCollection_DataMap<TopoDS_Shape, Entry,
+                              TopTools_ShapeMapHasher> DataMapOfShapeEntry;
+
+  DataMapOfShapeEntry myMap;
+  mutable Standard_Mutex myMutex;
+};
+#endif
@@ -81,6 +81,7 @@ GEOMAlgo_GetInPlace::GEOMAlgo_GetInPlace()
   myTolCG=0.0001;
   myFound=Standard_False;
   myCheckGeometry=Standard_True;
+  myMakeInnerPoints=Standard_False;
 }
 //=======================================================================
 //function : ~
@@ -146,6 +147,58 @@ const TopoDS_Shape& GEOMAlgo_GetInPlace::ShapeWhere()const
   return myShapeWhere;
 }
 //=======================================================================
+//function : SetInnerPoints
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::SetInnerPoints
+  (const Handle(GEOMAlgo_InnerPointsTable)& theTable)
+{
+  myInnerPoints=theTable;
+}
+//=======================================================================
+//function : SetMakeInnerPoints
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::SetMakeInnerPoints(const Standard_Boolean theFlag)
+{
+  myMakeInnerPoints=theFlag;
+}
+//=======================================================================
+//function : MakeInnerPoints
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GetInPlace::MakeInnerPoints()const
+{
+  return myMakeInnerPoints;
+}
+//=======================================================================
+//function : InnerPoints
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_InnerPointsTable)&
+  GEOMAlgo_GetInPlace::InnerPoints()const
+{
+  return myInnerPoints;
+}
+//=======================================================================
+//function : SetGPropsCache
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::SetGPropsCache
+  (const Handle(GEOMAlgo_GPropsCache)& theCache)
+{
+  myGPropsCache=theCache;
+}
+//=======================================================================
+//function : GPropsCache
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_GPropsCache)&
+  GEOMAlgo_GetInPlace::GPropsCache()const
+{
+  return myGPropsCache;
+}
+//=======================================================================
 //function : ShapesIn
 //purpose  :
 //=======================================================================
@@ -204,6 +257,8 @@ void GEOMAlgo_GetInPlace::Perform()
   // Initialize the context
   GEOMAlgo_GluerAlgo::Perform();
   //
+  PrepareInnerPoints();
+  //
   Intersect();
   if (myErrorStatus) {
     return;
@@ -281,6 +336,28 @@ void GEOMAlgo_GetInPlace::Perform()
   }
 }
 //=======================================================================
+//function : PrepareInnerPoints
+//purpose  :
+//=======================================================================
+void GEOMAlgo_GetInPlace::PrepareInnerPoints()
+{
+  if (myInnerPoints.IsNull()) {
+    if (!myMakeInnerPoints) {
+      // the points are computed for the candidate pairs only
+      return;
+    }
+  }
+  else if (myInnerPoints->IsValidFor(myShapeWhere, myTolerance)) {
+    return;
+  }
+  //
+  myInnerPoints=new GEOMAlgo_InnerPointsTable;
+  myInnerPoints->SetShape(myShapeWhere);
+  myInnerPoints->SetTolerance(myTolerance);
+  myInnerPoints->SetRunParallel(myRunParallel);
+  myInnerPoints->Perform();
+}
+//=======================================================================
 //function : CheckData
 //purpose  :
 //=======================================================================
@@ -443,7 +520,8 @@ void GEOMAlgo_GetInPlace::FillEdgesOn(const TopoDS_Shape &theShape)
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformVE()
 {
-  Standard_Boolean bFound;
+  GEOMAlgo_CoupleOfShapes aCSX;
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -462,14 +540,11 @@ void GEOMAlgo_GetInPlace::PerformVE()
       }
     }
     //
-    bFound=CheckCoincidence(aE1, aV2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aE1, aV2);
-    }
+    aCSX.SetShapes(aE1, aV2);
+    aVCS.Append(aCSX);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformEE
@@ -477,6 +552,8 @@ void GEOMAlgo_GetInPlace::PerformVE()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformEE()
 {
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -486,29 +563,25 @@ void GEOMAlgo_GetInPlace::PerformEE()
     const TopoDS_Shape& aE1=aCS.Shape1();
     const TopoDS_Shape& aE2=aCS.Shape2();
 
-    PerformEE(aE1, aE2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformEE(aE2, aE1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformEE(aE1, aE2, aVCS);
+    PerformEE(aE2, aE1, aVCS);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformEE
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GetInPlace::PerformEE(const TopoDS_Shape &theE1,
-                                    const TopoDS_Shape &theE2)
+void GEOMAlgo_GetInPlace::PerformEE
+  (const TopoDS_Shape &theE1,
+   const TopoDS_Shape &theE2,
+   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS)
 {
   Standard_Boolean bHasOn, bHasIn, bFound;
   TopoDS_Iterator aIt;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_CoupleOfShapes aCSX;
   //
   bHasOn=myShapesOn.IsBound(theE1);
   bHasIn=myShapesIn.IsBound(theE1);
@@ -528,13 +601,8 @@ void GEOMAlgo_GetInPlace::PerformEE(const TopoDS_Shape &theE1,
     return;
   }
   //
-  bFound=CheckCoincidence(theE1, theE2);
-  if (myErrorStatus) {
-    return;
-  }
-  if (bFound) {
-    FillShapesIn(theE1, theE2);
-  }
+  aCSX.SetShapes(theE1, theE2);
+  theVCS.Append(aCSX);
 }
 //=======================================================================
 //function : PerformVF
@@ -546,6 +614,8 @@ void GEOMAlgo_GetInPlace::PerformVF()
   Standard_Integer i, aNbE;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aME;
+  GEOMAlgo_CoupleOfShapes aCSX;
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -581,14 +651,11 @@ void GEOMAlgo_GetInPlace::PerformVF()
       continue;
     }
     //
-    bFound=CheckCoincidence(aF1, aV2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aF1, aV2);
-    }
+    aCSX.SetShapes(aF1, aV2);
+    aVCS.Append(aCSX);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : FillFacesOn
@@ -644,6 +711,8 @@ void GEOMAlgo_GetInPlace::PerformEF()
   Standard_Boolean  bFound, bHasOnF, bHasInF;
   TopoDS_Iterator aIt;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_CoupleOfShapes aCSX;
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -678,14 +747,11 @@ void GEOMAlgo_GetInPlace::PerformEF()
       continue;
     }
     //------------------------------
-    bFound=CheckCoincidence(aF1, aE2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aF1, aE2);
-    }
+    aCSX.SetShapes(aF1, aE2);
+    aVCS.Append(aCSX);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformFF
@@ -693,6 +759,8 @@ void GEOMAlgo_GetInPlace::PerformEF()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformFF()
 {
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -702,30 +770,26 @@ void GEOMAlgo_GetInPlace::PerformFF()
     const TopoDS_Shape& aF1=aCS.Shape1();
     const TopoDS_Shape& aF2=aCS.Shape2();
 
-    PerformFF(aF1, aF2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformFF(aF2, aF1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformFF(aF1, aF2, aVCS);
+    PerformFF(aF2, aF1, aVCS);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformFF
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GetInPlace::PerformFF(const TopoDS_Shape &theF1,
-                                    const TopoDS_Shape &theF2)
+void GEOMAlgo_GetInPlace::PerformFF
+  (const TopoDS_Shape &theF1,
+   const TopoDS_Shape &theF2,
+   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS)
 {
   Standard_Boolean  bFound, bHasOnF, bHasInF;
   Standard_Integer i, aNbS2;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aMS2;
+  GEOMAlgo_CoupleOfShapes aCSX;
   //
   bHasOnF=myShapesOn.IsBound(theF1);
   const TopTools_MapOfShape& aMSOnF=(bHasOnF) ? myShapesOn.Find(theF1) : aMSX;
@@ -751,13 +815,8 @@ void GEOMAlgo_GetInPlace::PerformFF(const TopoDS_Shape &theF1,
     return;
   }
   //
-  bFound=CheckCoincidence(theF1, theF2);
-  if (myErrorStatus) {
-    return;
-  }
-  if (bFound) {
-    FillShapesIn(theF1, theF2);
-  }
+  aCSX.SetShapes(theF1, theF2);
+  theVCS.Append(aCSX);
 }
 //=======================================================================
 //function : FillSolidsOn
@@ -809,6 +868,8 @@ void GEOMAlgo_GetInPlace::PerformZF()
 {
   Standard_Boolean  bFound, bHasOnF;
   TopTools_MapOfShape aMSX;
+  GEOMAlgo_CoupleOfShapes aCSX;
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
   //
   myErrorStatus=0;
   myWarningStatus=0;
@@ -826,14 +887,11 @@ void GEOMAlgo_GetInPlace::PerformZF()
       continue;
     }
     //------------------------------
-    bFound=CheckCoincidence(aSo1, aF2);
-    if (myErrorStatus) {
-      return;
-    }
-    if (bFound) {
-      FillShapesIn(aSo1, aF2);
-    }
+    aCSX.SetShapes(aSo1, aF2);
+    aVCS.Append(aCSX);
   }
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformZZ
@@ -841,6 +899,8 @@ void GEOMAlgo_GetInPlace::PerformZF()
 //=======================================================================
 void GEOMAlgo_GetInPlace::PerformZZ()
 {
+  NCollection_Vector<GEOMAlgo_CoupleOfShapes> aVCS;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
@@ -850,30 +910,26 @@ void GEOMAlgo_GetInPlace::PerformZZ()
     const TopoDS_Shape& aSo1=aCS.Shape1();
     const TopoDS_Shape& aSo2=aCS.Shape2();
 
-    PerformZZ(aSo1, aSo2);
-
-    if (myErrorStatus) {
-      return;
-    }
-
-    PerformZZ(aSo2, aSo1);
-
-    if (myErrorStatus) {
-      return;
-    }
+    PerformZZ(aSo1, aSo2, aVCS);
+    PerformZZ(aSo2, aSo1, aVCS);
   }// for (; myIterator.More(); myIterator.Next()) {
+  //
+  CheckCoincidences(aVCS);
 }
 //=======================================================================
 //function : PerformZZ
 //purpose  :
 //=======================================================================
-void GEOMAlgo_GetInPlace::PerformZZ(const TopoDS_Shape &theSo1,
-                                    const TopoDS_Shape &theSo2)
+void GEOMAlgo_GetInPlace::PerformZZ
+  (const TopoDS_Shape &theSo1,
+   const TopoDS_Shape &theSo2,
+   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS)
 {
   Standard_Boolean bFound, bHasOn, bHasIn;
   Standard_Integer i, aNbS2, iCntOn, iCntIn, iCntOut;
   TopTools_MapOfShape aMSX;
   TopTools_IndexedMapOfShape aMS2;
+  GEOMAlgo_CoupleOfShapes aCSX;
   //
   bHasOn=myShapesOn.IsBound(theSo1);
   const TopTools_MapOfShape& aMSOn=(bHasOn) ? myShapesOn.Find(theSo1) : aMSX;
@@ -911,14 +967,12 @@ void GEOMAlgo_GetInPlace::PerformZZ(const TopoDS_Shape &theSo1,
   }
   //
   if (!iCntIn) {
-    bFound=CheckCoincidence(theSo1, theSo2);
-    if (myErrorStatus) {
-      return;
-    }
-  }
-  if (bFound) {
-    FillShapesIn(theSo1, theSo2);
+    // to check
+    aCSX.SetShapes(theSo1, theSo2);
+    theVCS.Append(aCSX);
+    return;
   }
+  FillShapesIn(theSo1, theSo2);
 }
 //=======================================================================
 //function : FillImages
@@ -45,6 +45,11 @@
 #include <GEOMAlgo_DataMapOfShapePnt.hxx>
 #include <TopTools_DataMapOfShapeInteger.hxx>
 #include <TopTools_DataMapOfShapeShape.hxx>
+#include <NCollection_Vector.hxx>
+#include <IntTools_Context.hxx>
+#include <gp_Pnt.hxx>
+#include <GEOMAlgo_InnerPointsTable.hxx>
+#include <GEOMAlgo_GPropsCache.hxx>
 
 
 //=======================================================================
@@ -167,6 +172,65 @@ class GEOMAlgo_GetInPlace  : public GEOMAlgo_GluerAlgo,
   Standard_EXPORT
     const TopoDS_Shape& ShapeWhere() const;
 
+  /**
+   * Modifier. Sets the table of the inner points of the shape [Where].
+   * Perform makes the table again if it is not valid for the shape
+   * [Where] and the tolerance, so the same table can be shared by
+   * the runs with the same shape [Where] and different arguments [What].
+   * If no table is set, the inner points are computed only for
+   * the shapes of the candidate pairs (see SetMakeInnerPoints).
+   * @param theTable
+   *   The table of the inner points.
+   */
+  Standard_EXPORT
+    void SetInnerPoints(const Handle(GEOMAlgo_InnerPointsTable)& theTable) ;
+
+  /**
+   * Modifier. If theFlag is Standard_True, Perform makes the table of
+   * the inner points of all sub-shapes of [Where] when no table is set,
+   * to be shared by the next runs (see InnerPoints).
+   * By default the table is not made.
+   * @param theFlag
+   *   The flag.
+   */
+  Standard_EXPORT
+    void SetMakeInnerPoints(const Standard_Boolean theFlag) ;
+
+  /**
+   * Selector. Returns the flag set by SetMakeInnerPoints.
+   * @return
+   *   The flag.
+   */
+  Standard_EXPORT
+    Standard_Boolean MakeInnerPoints() const;
+
+  /**
+   * Selector. Returns the table of the inner points of the shape [Where].
+   * @return
+   *   The table of the inner points.
+   */
+  Standard_EXPORT
+    const Handle(GEOMAlgo_InnerPointsTable)& InnerPoints() const;
+
+  /**
+   * Modifier. Sets the cache of the global properties used to compare
+   * the argument [What] with its images. The cache is made by Perform
+   * if it is not set; the same cache can be shared by the runs on
+   * the same shapes and by other algorithms.
+   * @param theCache
+   *   The cache of the global properties.
+   */
+  Standard_EXPORT
+    void SetGPropsCache(const Handle(GEOMAlgo_GPropsCache)& theCache) ;
+
+  /**
+   * Selector. Returns the cache of the global properties.
+   * @return
+   *   The cache of the global properties.
+   */
+  Standard_EXPORT
+    const Handle(GEOMAlgo_GPropsCache)& GPropsCache() const;
+
   /**
    * Modifier. Sets the tolerance of mass.
    * @param theTol
@@ -263,6 +327,22 @@ class GEOMAlgo_GetInPlace  : public GEOMAlgo_GluerAlgo,
    */
   Standard_EXPORT
     const TopoDS_Shape &Result();
+
+  /**
+   * Computes the point inside the shape.
+   * @param theS
+   *   The vertex, edge, face or solid.
+   * @param theTol
+   *   The tolerance used for the solids.
+   * @param theP
+   *   The point.
+   * @return
+   *   0 in case of success.
+   */
+  Standard_EXPORT
+    static Standard_Integer PntInShape(const TopoDS_Shape& theS,
+                                       const Standard_Real theTol,
+                                       gp_Pnt& theP);
     
 protected:
   Standard_EXPORT
@@ -277,7 +357,8 @@ protected:
   Standard_EXPORT
     void PerformEE() ;
 
-    void PerformEE(const TopoDS_Shape &theE1, const TopoDS_Shape &theE2);
+    void PerformEE(const TopoDS_Shape &theE1, const TopoDS_Shape &theE2,
+                   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS);
 
   Standard_EXPORT
     void PerformVF() ;
@@ -288,7 +369,8 @@ protected:
   Standard_EXPORT
     void PerformFF() ;
 
-    void PerformFF(const TopoDS_Shape &theF1, const TopoDS_Shape &theF2);
+    void PerformFF(const TopoDS_Shape &theF1, const TopoDS_Shape &theF2,
+                   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS);
 
   Standard_EXPORT
     void FillEdgesOn(const TopoDS_Shape &theShape);
@@ -305,7 +387,8 @@ protected:
   Standard_EXPORT
     void PerformZZ() ;
 
-    void PerformZZ(const TopoDS_Shape &theSo1, const TopoDS_Shape &theSo2);
+    void PerformZZ(const TopoDS_Shape &theSo1, const TopoDS_Shape &theSo2,
+                   NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS);
 
   Standard_EXPORT
     void FillImages(const TopoDS_Shape &theShape,
@@ -336,6 +419,67 @@ protected:
   Standard_EXPORT
     Standard_Boolean CheckCoincidence(const TopoDS_Shape& theS1,
                                       const TopoDS_Shape& theS2);
+
+  /**
+   * Checks the pairs (Shape1 [What], Shape2 [Where]) of theVCS
+   * and fills the map of shapes IN for the coinciding ones.
+   * If the parallel mode is on, the pairs are checked by the threads,
+   * each with its own context; the map is filled in the order
+   * of the pairs.
+   * @param theVCS
+   *   The pairs to check.
+   */
+  Standard_EXPORT
+    void CheckCoincidences
+      (const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS);
+
+  /**
+   * Computes in parallel the points of the shapes Shape2 of theVCS
+   * that are not yet in myMapShapePnt.
+   * @param theVCS
+   *   The pairs to check.
+   */
+  Standard_EXPORT
+    void FillPoints
+      (const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS);
+
+  /**
+   * Returns the point of the shape [Where] theS taken from
+   * the table of the inner points or from myMapShapePnt.
+   * @param theS
+   *   The sub-shape of the shape [Where].
+   * @param theP
+   *   The point.
+   * @return
+   *   0 if the point is found, 1 if it is not computed yet,
+   *   2 if it can not be computed.
+   */
+  Standard_EXPORT
+    Standard_Integer FindPnt(const TopoDS_Shape& theS,
+                             gp_Pnt& theP) const;
+
+  /**
+   * Makes the table of the inner points of the shape [Where] if
+   * the table that is set is not valid for it, or if no table is
+   * set and the table is requested by SetMakeInnerPoints.
+   */
+  Standard_EXPORT
+    void PrepareInnerPoints() ;
+
+  /**
+   * Checks if the point is on the edge, on the face or
+   * inside the solid theS.
+   * @param theS
+   *   The edge, face or solid.
+   * @param theP
+   *   The point.
+   * @param theCtx
+   *   The context to use.
+   */
+  Standard_EXPORT
+    Standard_Boolean IsPntOnShape(const TopoDS_Shape& theS,
+                                  const gp_Pnt& theP,
+                                  const Handle(IntTools_Context)& theCtx) const;
   
   Standard_EXPORT
     Standard_Integer CheckGProps(const TopoDS_Shape& theS);
@@ -358,10 +502,14 @@ protected:
   Standard_Boolean myFound;
   GEOMAlgo_DataMapOfShapePnt myMapShapePnt;
   TopTools_DataMapOfShapeInteger myChecked;
+  Handle(GEOMAlgo_InnerPointsTable) myInnerPoints;
+  Standard_Boolean myMakeInnerPoints;
+  Handle(GEOMAlgo_GPropsCache) myGPropsCache;
   //
   TopoDS_Shape myResult;
 
 private:
+  friend class GEOMAlgo_GetInPlaceCheckFunctor;
 };
 
 
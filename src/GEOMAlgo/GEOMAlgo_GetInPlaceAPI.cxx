@@ -26,6 +26,7 @@
 
 #include <GEOMAlgo_GetInPlaceAPI.hxx>
 #include <GEOMAlgo_GetInPlace.hxx>
+#include <GEOMAlgo_GetInPlaceOld.hxx>
 #include <GEOM_Object.hxx>
 #include <GEOMUtils.hxx>
 
@@ -115,190 +116,12 @@ Standard_Boolean GEOMAlgo_GetInPlaceAPI::GetInPlace
 Standard_Integer GEOMAlgo_GetInPlaceAPI::GetInPlaceOld
             (const TopoDS_Shape         &theWhere,
              const TopoDS_Shape         &theWhat,
-                   TopTools_ListOfShape &theShapesInPlace)
+                   TopTools_ListOfShape &theShapesInPlace,
+             const Standard_Boolean      theRunParallel,
+             const Handle(GEOMAlgo_GPropsCache) &theGPropsCache)
 {
-  theShapesInPlace.Clear();
-
-  if (theWhere.IsNull() || theWhat.IsNull()) {
-    // Error: aWhere and aWhat TopoDS_Shape are Null.
-    return 1;
-  }
-
-  // Check shape type.
-  TopAbs_ShapeEnum iType = GEOMUtils::GetTypeOfSimplePart(theWhat);
-
-  if (iType == TopAbs_SHAPE) {
-    // Error: An attempt to extract a shape of not supported type.
-    return 2;
-  }
-
-  // Compute confusion tolerance.
-  Standard_Real    aTolConf = Precision::Confusion();
-  Standard_Integer i;
-
-  for (i = 0; i < 2; ++i) {
-    TopExp_Explorer anExp(i == 0 ? theWhere : theWhat, TopAbs_VERTEX);
-
-    for (; anExp.More(); anExp.Next()) {
-      const TopoDS_Vertex aVtx = TopoDS::Vertex(anExp.Current());
-      const Standard_Real aTolVtx = BRep_Tool::Tolerance(aVtx);
-
-      if (aTolVtx > aTolConf) {
-        aTolConf = aTolVtx;
-      }
-    }
-  }
-
-  // Compute mass tolerance.
-  Bnd_Box       aBoundingBox;
-  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
-  Standard_Real aMassTol;
-
-  BRepBndLib::Add(theWhere, aBoundingBox);
-  BRepBndLib::Add(theWhat,  aBoundingBox);
-  aBoundingBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
-  aMassTol = Max(aXmax - aXmin, aYmax - aYmin);
-  aMassTol = Max(aMassTol, aZmax - aZmin);
-  aMassTol *= aTolConf;
-
-  // Compute the result.
-  TopExp_Explorer     Exp_aWhat  (theWhat,  iType);
-  TopExp_Explorer     Exp_aWhere (theWhere, iType);
-  Standard_Real       tab_aWhat[4], tab_aWhere[4];
-  gp_Pnt              aPnt, aPnt_aWhat;
-  TopoDS_Shape        aPntShape;
-  TopoDS_Vertex       aVertex;
-  bool                isFound = false;
-  TopTools_MapOfShape map_aWhere;
-
-  for (; Exp_aWhere.More(); Exp_aWhere.Next()) {
-    if (!map_aWhere.Add(Exp_aWhere.Current()))
-      continue; // skip repeated shape to avoid mass addition
-    GetShapeProperties( Exp_aWhere.Current(), tab_aWhere, aPnt );
-    for ( Exp_aWhat.ReInit(); Exp_aWhat.More(); Exp_aWhat.Next() ) {
-      GetShapeProperties( Exp_aWhat.Current(), tab_aWhat, aPnt_aWhat );
-      if (fabs(tab_aWhat[3] - tab_aWhere[3]) <= aMassTol && aPnt_aWhat.Distance(aPnt) <= aTolConf)
-        isFound = true;
-      else {
-        if (tab_aWhat[3] > tab_aWhere[3]) {
-          aPntShape = BRepBuilderAPI_MakeVertex( aPnt ).Shape();
-          aVertex   = TopoDS::Vertex( aPntShape );
-          BRepExtrema_DistShapeShape aWhereDistance ( aVertex, Exp_aWhere.Current() );
-          BRepExtrema_DistShapeShape aWhatDistance  ( aVertex, Exp_aWhat.Current() );
-          if (aWhereDistance.IsDone() && aWhatDistance.IsDone() &&
-              fabs(aWhereDistance.Value() - aWhatDistance.Value()) <= aTolConf)
-          {
-            // 0020162: "EDF 961 GEOM : Getinplace is getting additional orthogonal faces"
-            // aVertex must be projected to the same point on Where and on What
-            gp_Pnt pOnWhat  = aWhatDistance.PointOnShape2(1);
-            gp_Pnt pOnWhere = aWhereDistance.PointOnShape2(1);
-            isFound = (pOnWhat.Distance(pOnWhere) <= aTolConf);
-            if ( isFound && iType == TopAbs_FACE )
-            {
-              // check normals at pOnWhat and pOnWhere
-              const double angleTol = M_PI/180.;
-              gp_Vec normToWhat  = GetNormal( TopoDS::Face(Exp_aWhat.Current()), aWhatDistance);
-              gp_Vec normToWhere = GetNormal( TopoDS::Face(Exp_aWhere.Current()), aWhereDistance);
-              if ( normToWhat * normToWhere < 0 )
-                normToWhat.Reverse();
-              isFound = ( normToWhat.Angle( normToWhere ) < angleTol );
-            }
-          }
-        }
-      }
-      if ( isFound ) {
-        theShapesInPlace.Append(Exp_aWhere.Current());
-        //aWhere_Mass += tab_aWhere[3];
-        isFound = false;
-        break;
-      }
-    }
-  }
-
-  if (theShapesInPlace.Extent() == 0) {
-    // Not found any Results
-    return 3;
-  }
-
-  return 0;
-}
-
-//=======================================================================
-//function : GetNormal
-//purpose  : 
-//=======================================================================
-gp_Vec GEOMAlgo_GetInPlaceAPI::GetNormal
-                         (const TopoDS_Face                &theFace,
-                          const BRepExtrema_DistShapeShape &theExtrema)
-{
-  gp_Vec defaultNorm(1,0,0); // to have same normals on different faces
-  try {
-    // get UV at extrema point
-    Standard_Real u,v, f,l;
-    switch ( theExtrema.SupportTypeShape2(1) ) {
-    case BRepExtrema_IsInFace: {
-      theExtrema.ParOnFaceS2(1, u, v );
-      break;
-    }
-    case BRepExtrema_IsOnEdge: {
-      TopoDS_Edge edge = TopoDS::Edge( theExtrema.SupportOnShape2(1));
-      Handle(Geom2d_Curve) pcurve =
-        BRep_Tool::CurveOnSurface(edge, theFace, f,l);
-
-      theExtrema.ParOnEdgeS2( 1, u );
-      gp_Pnt2d uv = pcurve->Value( u );
-      u = uv.Coord(1);
-      v = uv.Coord(2);
-      break;
-    }
-    case BRepExtrema_IsVertex: return defaultNorm;
-    }
-    // get derivatives
-    BRepAdaptor_Surface surface( theFace, false );
-    gp_Vec du, dv; gp_Pnt p;
-    surface.D1( u, v, p, du, dv );
-
-    return du ^ dv;
-
-  } catch (Standard_Failure ) {
-  }
-  return defaultNorm;
-}
-
-//=======================================================================
-//function : GetShapeProperties
-//purpose  : 
-//=======================================================================
-void GEOMAlgo_GetInPlaceAPI::GetShapeProperties(const TopoDS_Shape  &theShape,
-                                                      Standard_Real  theTab[],
-                                                      gp_Pnt        &theVertex)
-{
-  GProp_GProps  aProps;
-  gp_Pnt        aCenterMass;
-  Standard_Real aShapeSize;
-
-  if    (theShape.ShapeType() == TopAbs_VERTEX) {
-    aCenterMass = BRep_Tool::Pnt(TopoDS::Vertex(theShape));
-  } else if (theShape.ShapeType() == TopAbs_EDGE) {
-    BRepGProp::LinearProperties(theShape,  aProps);
-  } else if (theShape.ShapeType() == TopAbs_FACE) {
-    BRepGProp::SurfaceProperties(theShape, aProps);
-  } else {
-    BRepGProp::VolumeProperties(theShape,  aProps);
-  }
-
-  if (theShape.ShapeType() == TopAbs_VERTEX) {
-    aShapeSize = 1;
-  } else {
-    aCenterMass = aProps.CentreOfMass();
-    aShapeSize  = aProps.Mass();
-  }
-
-  theVertex = aCenterMass;
-  theTab[0] = theVertex.X();
-  theTab[1] = theVertex.Y();
-  theTab[2] = theVertex.Z();
-  theTab[3] = aShapeSize;
+  return GEOMAlgo_GetInPlaceOld::Perform(theWhere, theWhat, theShapesInPlace,
+                                         theRunParallel, theGPropsCache);
 }
 
 //=======================================================================
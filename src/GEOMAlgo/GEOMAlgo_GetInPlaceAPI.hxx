@@ -32,11 +32,11 @@
 #include <TopTools_ListOfShape.hxx>
 #include <gp_Vec.hxx>
 
+#include <GEOMAlgo_GetInPlaceOld.hxx>
+
 #include <vector>
 
 class GEOMAlgo_GetInPlace;
-class BRepExtrema_DistShapeShape;
-class TopoDS_Face;
 class TopoDS_Shape;
 
 /**
@@ -62,7 +62,8 @@ public:
                              GEOMAlgo_GetInPlace &theGIP);
 
   /*!
-   *  \brief Old implementation of GetInPlace algorithm.
+   *  \brief Old implementation of GetInPlace algorithm,
+   *  see GEOMAlgo_GetInPlaceOld::Perform.
    *  This method searches among sub shapes of the shape theWhere parts that are
    *  coincident with the shape theWhat. The result list of shape is returned as
    *  an output parameter. It returns the error code with the following possible
@@ -71,11 +72,19 @@ public:
    *    1 - theWhere and/or theWhat TopoDS_Shape are Null;
    *    2 - An attempt to extract a shape of not supported type;
    *    3 - Not found any Results.
+   *  The properties are computed once per sub-shape and only the pairs
+   *  of sub-shapes with intersecting bounding boxes are compared;
+   *  if theRunParallel is true, the properties and the pairs are
+   *  computed in parallel. If theGPropsCache is not null, the
+   *  properties are taken from it and stored in it.
    */
   Standard_EXPORT static Standard_Integer GetInPlaceOld
             (const TopoDS_Shape         &theWhere,
              const TopoDS_Shape         &theWhat,
-                   TopTools_ListOfShape &theShapesInPlace);
+                   TopTools_ListOfShape &theShapesInPlace,
+             const Standard_Boolean      theRunParallel = Standard_False,
+             const Handle(GEOMAlgo_GPropsCache) &theGPropsCache =
+                                         Handle(GEOMAlgo_GPropsCache)());
 
 
   /**
@@ -99,22 +108,6 @@ public:
                        const TopoDS_Shape                &theWhat,
                        std::vector< std::vector< int > > &theResVec);
 
-protected:
-
-  /*!
-   * \brief Return normal to face at extrema point
-   */
-  static gp_Vec GetNormal(const TopoDS_Face                &theFace,
-                          const BRepExtrema_DistShapeShape &theExtrema);
-
-  /*!
-   * Return the global properties of the shape: center of mass and
-   * a size (length, area or volume depending on the shape type).
-   */
-  static void GetShapeProperties(const TopoDS_Shape  &theShape,
-                                       Standard_Real  theTab[],
-                                       gp_Pnt        &theVertex);
-
 };
 
 
@@ -0,0 +1,492 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:     GEOMAlgo_GetInPlaceOld.cxx
+// Created:
+// Author:   Sergey KHROMOV
+
+#include <GEOMAlgo_GetInPlaceOld.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
+
+#include <Bnd_Box.hxx>
+#include <BRepAdaptor_Surface.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepGProp.hxx>
+#include <BRep_Tool.hxx>
+#include <Geom2d_Curve.hxx>
+#include <GProp_GProps.hxx>
+#include <gp_Pnt.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopoDS_Vertex.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TColStd_ListIteratorOfListOfInteger.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_UBTreeFiller.hxx>
+#include <OSD_Parallel.hxx>
+
+#include <GEOMAlgo_BoxBndTree.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_GetInPlaceOldPropsFunctor
+//purpose  : computes the properties of the chunk of the shapes
+//=======================================================================
+class GEOMAlgo_GetInPlaceOldPropsFunctor
+{
+ public:
+  GEOMAlgo_GetInPlaceOldPropsFunctor
+    (const TopTools_IndexedMapOfShape& theMS,
+     const Handle(GEOMAlgo_GPropsCache)& theCache,
+     NCollection_Array1<gp_Pnt>& theCG,
+     NCollection_Array1<Standard_Real>& theMass,
+     const Standard_Integer theNbChunks)
+  :
+    myMS(theMS),
+    myCache(theCache),
+    myCG(theCG),
+    myMass(theMass),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    Standard_Real aTab[4];
+    //
+    aNb=myMS.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      GEOMAlgo_GetInPlaceOld::GetShapeProperties(myMS(i), aTab, myCG(i),
+                                                 myCache);
+      myMass(i)=aTab[3];
+    }
+  }
+  //
+ protected:
+  const TopTools_IndexedMapOfShape& myMS;
+  Handle(GEOMAlgo_GPropsCache) myCache;
+  NCollection_Array1<gp_Pnt>& myCG;
+  NCollection_Array1<Standard_Real>& myMass;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_GetInPlaceOldFunctor
+//purpose  : compares the chunk of the sub-shapes [Where] with
+//           their candidate sub-shapes [What]
+//=======================================================================
+class GEOMAlgo_GetInPlaceOldFunctor
+{
+ public:
+  GEOMAlgo_GetInPlaceOldFunctor
+    (const TopTools_IndexedMapOfShape& theMWhere,
+     const NCollection_Array1<gp_Pnt>& theCGWhere,
+     const NCollection_Array1<Standard_Real>& theMassWhere,
+     const TopTools_IndexedMapOfShape& theMWhat,
+     const NCollection_Array1<gp_Pnt>& theCGWhat,
+     const NCollection_Array1<Standard_Real>& theMassWhat,
+     const NCollection_Array1<TColStd_ListOfInteger>& theCands,
+     const TopAbs_ShapeEnum theType,
+     const Standard_Real theTolConf,
+     const Standard_Real theMassTol,
+     NCollection_Array1<Standard_Boolean>& theFound,
+     const Standard_Integer theNbChunks)
+  :
+    myMWhere(theMWhere),
+    myCGWhere(theCGWhere),
+    myMassWhere(theMassWhere),
+    myMWhat(theMWhat),
+    myCGWhat(theCGWhat),
+    myMassWhat(theMassWhat),
+    myCands(theCands),
+    myType(theType),
+    myTolConf(theTolConf),
+    myMassTol(theMassTol),
+    myFound(theFound),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    //
+    aNb=myMWhere.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myFound(i)=IsFound(i);
+    }
+  }
+  //
+ protected:
+  Standard_Boolean IsFound(const Standard_Integer theWhere) const
+  {
+    Standard_Boolean isFound, isWhereDone;
+    Standard_Integer j;
+    TopoDS_Vertex aVertex;
+    BRepExtrema_DistShapeShape aWhereDistance;
+    TColStd_ListIteratorOfListOfInteger aIt;
+    //
+    const TopoDS_Shape& aWhere=myMWhere(theWhere);
+    const gp_Pnt& aPnt=myCGWhere(theWhere);
+    const Standard_Real aMassWhere=myMassWhere(theWhere);
+    //
+    isFound=Standard_False;
+    isWhereDone=Standard_False;
+    aIt.Initialize(myCands(theWhere));
+    for (; aIt.More() && !isFound; aIt.Next()) {
+      j=aIt.Value();
+      const TopoDS_Shape& aWhat=myMWhat(j);
+      const gp_Pnt& aPnt_aWhat=myCGWhat(j);
+      //
+      if (fabs(myMassWhat(j) - aMassWhere) <= myMassTol &&
+          aPnt_aWhat.Distance(aPnt) <= myTolConf) {
+        isFound = Standard_True;
+        break;
+      }
+      //
+      if (myMassWhat(j) <= aMassWhere) {
+        continue;
+      }
+      //
+      // the distance to [Where] does not depend on [What]
+      if (!isWhereDone) {
+        aVertex = TopoDS::Vertex(BRepBuilderAPI_MakeVertex(aPnt).Shape());
+        aWhereDistance.LoadS1(aVertex);
+        aWhereDistance.LoadS2(aWhere);
+        aWhereDistance.Perform();
+        isWhereDone = Standard_True;
+      }
+      //
+      BRepExtrema_DistShapeShape aWhatDistance(aVertex, aWhat);
+      if (aWhereDistance.IsDone() && aWhatDistance.IsDone() &&
+          fabs(aWhereDistance.Value() - aWhatDistance.Value()) <= myTolConf)
+      {
+        // 0020162: "EDF 961 GEOM : Getinplace is getting additional orthogonal faces"
+        // aVertex must be projected to the same point on Where and on What
+        gp_Pnt pOnWhat  = aWhatDistance.PointOnShape2(1);
+        gp_Pnt pOnWhere = aWhereDistance.PointOnShape2(1);
+        isFound = (pOnWhat.Distance(pOnWhere) <= myTolConf);
+        if ( isFound && myType == TopAbs_FACE )
+        {
+          // check normals at pOnWhat and pOnWhere
+          const double angleTol = M_PI/180.;
+          gp_Vec normToWhat  =
+            GEOMAlgo_GetInPlaceOld::GetNormal(TopoDS::Face(aWhat), aWhatDistance);
+          gp_Vec normToWhere =
+            GEOMAlgo_GetInPlaceOld::GetNormal(TopoDS::Face(aWhere), aWhereDistance);
+          if ( normToWhat * normToWhere < 0 )
+            normToWhat.Reverse();
+          isFound = ( normToWhat.Angle( normToWhere ) < angleTol );
+        }
+      }
+    }
+    return isFound;
+  }
+  //
+  const TopTools_IndexedMapOfShape& myMWhere;
+  const NCollection_Array1<gp_Pnt>& myCGWhere;
+  const NCollection_Array1<Standard_Real>& myMassWhere;
+  const TopTools_IndexedMapOfShape& myMWhat;
+  const NCollection_Array1<gp_Pnt>& myCGWhat;
+  const NCollection_Array1<Standard_Real>& myMassWhat;
+  const NCollection_Array1<TColStd_ListOfInteger>& myCands;
+  TopAbs_ShapeEnum myType;
+  Standard_Real myTolConf;
+  Standard_Real myMassTol;
+  NCollection_Array1<Standard_Boolean>& myFound;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//function : Perform
+//purpose  : 
+//=======================================================================
+Standard_Integer GEOMAlgo_GetInPlaceOld::Perform
+            (const TopoDS_Shape         &theWhere,
+             const TopoDS_Shape         &theWhat,
+                   TopTools_ListOfShape &theShapesInPlace,
+             const Standard_Boolean      theRunParallel,
+             const Handle(GEOMAlgo_GPropsCache) &theGPropsCache)
+{
+  theShapesInPlace.Clear();
+
+  if (theWhere.IsNull() || theWhat.IsNull()) {
+    // Error: aWhere and aWhat TopoDS_Shape are Null.
+    return 1;
+  }
+
+  // Check shape type.
+  TopAbs_ShapeEnum iType = GetTypeOfSimplePart(theWhat);
+
+  if (iType == TopAbs_SHAPE) {
+    // Error: An attempt to extract a shape of not supported type.
+    return 2;
+  }
+
+  // Compute confusion tolerance.
+  Standard_Real    aTolConf = Precision::Confusion();
+  Standard_Integer i;
+
+  for (i = 0; i < 2; ++i) {
+    TopExp_Explorer anExp(i == 0 ? theWhere : theWhat, TopAbs_VERTEX);
+
+    for (; anExp.More(); anExp.Next()) {
+      const TopoDS_Vertex aVtx = TopoDS::Vertex(anExp.Current());
+      const Standard_Real aTolVtx = BRep_Tool::Tolerance(aVtx);
+
+      if (aTolVtx > aTolConf) {
+        aTolConf = aTolVtx;
+      }
+    }
+  }
+
+  // Compute mass tolerance.
+  Bnd_Box       aBoundingBox;
+  Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  Standard_Real aMassTol;
+
+  BRepBndLib::Add(theWhere, aBoundingBox);
+  BRepBndLib::Add(theWhat,  aBoundingBox);
+  aBoundingBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  aMassTol = Max(aXmax - aXmin, aYmax - aYmin);
+  aMassTol = Max(aMassTol, aZmax - aZmin);
+  aMassTol *= aTolConf;
+
+  // Compute the result.
+  // 1. The sub-shapes, each one once, and their properties.
+  //    The repeated sub-shapes [Where] are skipped to avoid
+  //    mass addition.
+  TopTools_IndexedMapOfShape aMWhere, aMWhat;
+  Standard_Integer j, aNbWhere, aNbWhat, aNbChunks;
+
+  TopExp::MapShapes(theWhere, iType, aMWhere);
+  TopExp::MapShapes(theWhat,  iType, aMWhat);
+  aNbWhere = aMWhere.Extent();
+  aNbWhat  = aMWhat.Extent();
+  if (!aNbWhere || !aNbWhat) {
+    // Not found any Results
+    return 3;
+  }
+
+  NCollection_Array1<gp_Pnt>        aCGWhere(1, aNbWhere), aCGWhat(1, aNbWhat);
+  NCollection_Array1<Standard_Real> aMassWhere(1, aNbWhere), aMassWhat(1, aNbWhat);
+
+  for (i = 0; i < 2; ++i) {
+    const TopTools_IndexedMapOfShape& aMS = (i == 0) ? aMWhere : aMWhat;
+    NCollection_Array1<gp_Pnt>& aCG = (i == 0) ? aCGWhere : aCGWhat;
+    NCollection_Array1<Standard_Real>& aMass = (i == 0) ? aMassWhere : aMassWhat;
+
+    aNbChunks = GEOMAlgo_AlgoTools::NbChunks(aMS.Extent(), theRunParallel);
+    GEOMAlgo_GetInPlaceOldPropsFunctor aFunctor(aMS, theGPropsCache,
+                                                aCG, aMass, aNbChunks);
+    OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks == 1);
+  }
+
+  // 2. The candidate pairs: a coincidence needs a common point
+  //    within aTolConf, so the boxes enlarged by aTolConf intersect.
+  GEOMAlgo_BoxBndTreeSelector aSelector;
+  GEOMAlgo_BoxBndTree         aBBTree;
+  NCollection_UBTreeFiller <Standard_Integer, Bnd_Box> aTreeFiller(aBBTree);
+  NCollection_Array1<TColStd_ListOfInteger> aCands(1, aNbWhere);
+
+  for (j = 1; j <= aNbWhat; ++j) {
+    Bnd_Box aBox;
+    BRepBndLib::Add(aMWhat(j), aBox);
+    aBox.Enlarge(aTolConf);
+    aTreeFiller.Add(j, aBox);
+  }
+  aTreeFiller.Fill();
+
+  for (i = 1; i <= aNbWhere; ++i) {
+    Bnd_Box aBox;
+    BRepBndLib::Add(aMWhere(i), aBox);
+    aBox.Enlarge(aTolConf);
+
+    aSelector.Clear();
+    aSelector.SetBox(aBox);
+    if (aBBTree.Select(aSelector)) {
+      aCands(i) = aSelector.Indices();
+    }
+  }
+
+  // 3. The pairs
+  NCollection_Array1<Standard_Boolean> aFound(1, aNbWhere);
+  aFound.Init(Standard_False);
+
+  aNbChunks = GEOMAlgo_AlgoTools::NbChunks(aNbWhere, theRunParallel);
+  GEOMAlgo_GetInPlaceOldFunctor aFunctor(aMWhere, aCGWhere, aMassWhere,
+                                         aMWhat, aCGWhat, aMassWhat,
+                                         aCands, iType, aTolConf, aMassTol,
+                                         aFound, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks == 1);
+
+  for (i = 1; i <= aNbWhere; ++i) {
+    if (aFound(i)) {
+      theShapesInPlace.Append(aMWhere(i));
+    }
+  }
+
+  if (theShapesInPlace.Extent() == 0) {
+    // Not found any Results
+    return 3;
+  }
+
+  return 0;
+}
+
+//=======================================================================
+//function : GetNormal
+//purpose  : 
+//=======================================================================
+gp_Vec GEOMAlgo_GetInPlaceOld::GetNormal
+                         (const TopoDS_Face                &theFace,
+                          const BRepExtrema_DistShapeShape &theExtrema)
+{
+  gp_Vec defaultNorm(1,0,0); // to have same normals on different faces
+  try {
+    // get UV at extrema point
+    Standard_Real u,v, f,l;
+    switch ( theExtrema.SupportTypeShape2(1) ) {
+    case BRepExtrema_IsInFace: {
+      theExtrema.ParOnFaceS2(1, u, v );
+      break;
+    }
+    case BRepExtrema_IsOnEdge: {
+      TopoDS_Edge edge = TopoDS::Edge( theExtrema.SupportOnShape2(1));
+      Handle(Geom2d_Curve) pcurve =
+        BRep_Tool::CurveOnSurface(edge, theFace, f,l);
+
+      theExtrema.ParOnEdgeS2( 1, u );
+      gp_Pnt2d uv = pcurve->Value( u );
+      u = uv.Coord(1);
+      v = uv.Coord(2);
+      break;
+    }
+    case BRepExtrema_IsVertex: return defaultNorm;
+    }
+    // get derivatives
+    BRepAdaptor_Surface surface( theFace, false );
+    gp_Vec du, dv; gp_Pnt p;
+    surface.D1( u, v, p, du, dv );
+
+    return du ^ dv;
+
+  } catch (Standard_Failure ) {
+  }
+  return defaultNorm;
+}
+
+//=======================================================================
+//function : GetShapeProperties
+//purpose  : 
+//=======================================================================
+void GEOMAlgo_GetInPlaceOld::GetShapeProperties(const TopoDS_Shape  &theShape,
+                                                      Standard_Real  theTab[],
+                                                      gp_Pnt        &theVertex)
+{
+  GProp_GProps  aProps;
+  gp_Pnt        aCenterMass;
+  Standard_Real aShapeSize;
+
+  if    (theShape.ShapeType() == TopAbs_VERTEX) {
+    aCenterMass = BRep_Tool::Pnt(TopoDS::Vertex(theShape));
+  } else if (theShape.ShapeType() == TopAbs_EDGE) {
+    BRepGProp::LinearProperties(theShape,  aProps);
+  } else if (theShape.ShapeType() == TopAbs_FACE) {
+    BRepGProp::SurfaceProperties(theShape, aProps);
+  } else {
+    BRepGProp::VolumeProperties(theShape,  aProps);
+  }
+
+  if (theShape.ShapeType() == TopAbs_VERTEX) {
+    aShapeSize = 1;
+  } else {
+    aCenterMass = aProps.CentreOfMass();
+    aShapeSize  = aProps.Mass();
+  }
+
+  theVertex = aCenterMass;
+  theTab[0] = theVertex.X();
+  theTab[1] = theVertex.Y();
+  theTab[2] = theVertex.Z();
+  theTab[3] = aShapeSize;
+}
+
+//=======================================================================
+//function : GetShapeProperties
+//purpose  : 
+//=======================================================================
+void GEOMAlgo_GetInPlaceOld::GetShapeProperties
+                   (const TopoDS_Shape  &theShape,
+                          Standard_Real  theTab[],
+                          gp_Pnt        &theVertex,
+                    const Handle(GEOMAlgo_GPropsCache) &theCache)
+{
+  Standard_Integer aDim;
+  Standard_Real    aShapeSize;
+
+  if (theCache.IsNull() || theShape.ShapeType() == TopAbs_VERTEX) {
+    GetShapeProperties(theShape, theTab, theVertex);
+    return;
+  }
+
+  if (theShape.ShapeType() == TopAbs_EDGE) {
+    aDim = 1;
+  } else if (theShape.ShapeType() == TopAbs_FACE) {
+    aDim = 2;
+  } else {
+    aDim = 3;
+  }
+  theCache->Properties(theShape, aDim, 0., aShapeSize, theVertex);
+
+  theTab[0] = theVertex.X();
+  theTab[1] = theVertex.Y();
+  theTab[2] = theVertex.Z();
+  theTab[3] = aShapeSize;
+}
+
+//=======================================================================
+//function : GetTypeOfSimplePart
+//purpose  : 
+//=======================================================================
+TopAbs_ShapeEnum GEOMAlgo_GetInPlaceOld::GetTypeOfSimplePart
+                      (const TopoDS_Shape &theShape)
+{
+  TopAbs_ShapeEnum aType = theShape.ShapeType();
+  if      (aType == TopAbs_VERTEX)                             return TopAbs_VERTEX;
+  else if (aType == TopAbs_EDGE  || aType == TopAbs_WIRE)      return TopAbs_EDGE;
+  else if (aType == TopAbs_FACE  || aType == TopAbs_SHELL)     return TopAbs_FACE;
+  else if (aType == TopAbs_SOLID || aType == TopAbs_COMPSOLID) return TopAbs_SOLID;
+  else if (aType == TopAbs_COMPOUND) {
+    // Only the type of the first shape in the compound is taken into account
+    TopoDS_Iterator It (theShape, Standard_False, Standard_False);
+    if (It.More()) {
+      return GetTypeOfSimplePart(It.Value());
+    }
+  }
+  return TopAbs_SHAPE;
+}
@@ -0,0 +1,115 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// Copyright (C) 2003-2007  OPEN CASCADE, EADS/CCR, LIP6, CEA/DEN,
+// CEDRAT, EDF R&D, LEG, PRINCIPIA R&D, BUREAU VERITAS
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_GetInPlaceOld.hxx
+// Created:
+// Author:      Sergey KHROMOV
+
+#ifndef _GEOMAlgo_GetInPlaceOld_HeaderFile
+#define _GEOMAlgo_GetInPlaceOld_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopTools_ListOfShape.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Vec.hxx>
+
+#include <GEOMAlgo_GPropsCache.hxx>
+
+class BRepExtrema_DistShapeShape;
+class TopoDS_Face;
+class TopoDS_Shape;
+
+/**
+ * The old GetInPlace algorithm. It does not depend on the data model
+ * of GEOM, GEOMAlgo_GetInPlaceAPI::GetInPlaceOld calls it.
+ */
+class GEOMAlgo_GetInPlaceOld
+{
+
+public:
+
+  /*!
+   *  \brief Searches among sub shapes of the shape theWhere parts that are
+   *  coincident with the shape theWhat. The result list of shape is returned
+   *  as an output parameter. It returns the error code with the following
+   *  possible values:
+   *    0 - Success;
+   *    1 - theWhere and/or theWhat TopoDS_Shape are Null;
+   *    2 - An attempt to extract a shape of not supported type;
+   *    3 - Not found any Results.
+   *  The properties are computed once per sub-shape and only the pairs
+   *  of sub-shapes with intersecting bounding boxes are compared;
+   *  if theRunParallel is true, the properties and the pairs are
+   *  computed in parallel. If theGPropsCache is not null, the
+   *  properties are taken from it and stored in it.
+   */
+  Standard_EXPORT static Standard_Integer Perform
+            (const TopoDS_Shape         &theWhere,
+             const TopoDS_Shape         &theWhat,
+                   TopTools_ListOfShape &theShapesInPlace,
+             const Standard_Boolean      theRunParallel = Standard_False,
+             const Handle(GEOMAlgo_GPropsCache) &theGPropsCache =
+                                         Handle(GEOMAlgo_GPropsCache)());
+
+  /*!
+   * Return the global properties of the shape: center of mass and
+   * a size (length, area or volume depending on the shape type).
+   */
+  Standard_EXPORT static void GetShapeProperties
+                      (const TopoDS_Shape  &theShape,
+                             Standard_Real  theTab[],
+                             gp_Pnt        &theVertex);
+
+  /*!
+   * The same, the properties are taken from theCache if it is not null.
+   */
+  Standard_EXPORT static void GetShapeProperties
+                      (const TopoDS_Shape  &theShape,
+                             Standard_Real  theTab[],
+                             gp_Pnt        &theVertex,
+                       const Handle(GEOMAlgo_GPropsCache) &theCache);
+
+  /*!
+   * Return the type of the simple parts of the shape: vertex, edge,
+   * face or solid (the type of the first sub-shape for a compound);
+   * TopAbs_SHAPE if it is not defined. The same as
+   * GEOMUtils::GetTypeOfSimplePart.
+   */
+  Standard_EXPORT static TopAbs_ShapeEnum GetTypeOfSimplePart
+                      (const TopoDS_Shape &theShape);
+
+protected:
+
+  /*!
+   * \brief Return normal to face at extrema point
+   */
+  static gp_Vec GetNormal(const TopoDS_Face                &theFace,
+                          const BRepExtrema_DistShapeShape &theExtrema);
+
+  friend class GEOMAlgo_GetInPlaceOldFunctor;
+};
+
+#endif
@@ -59,6 +59,11 @@
 
 #include <IntTools_Tools.hxx>
 
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <OSD_Parallel.hxx>
+#include <NCollection_Array1.hxx>
+
 #include <GEOMAlgo_AlgoTools.hxx>
 
 
@@ -83,6 +88,112 @@ static
                               gp_Pnt& aP);
 
 
+//=======================================================================
+//class    : GEOMAlgo_GetInPlacePntFunctor
+//purpose  : computes the points on the chunk of the shapes theMS
+//=======================================================================
+class GEOMAlgo_GetInPlacePntFunctor
+{
+ public:
+  GEOMAlgo_GetInPlacePntFunctor
+    (const TopTools_IndexedMapOfShape& theMS,
+     const Standard_Real theTol,
+     NCollection_Array1<gp_Pnt>& thePnts,
+     NCollection_Array1<Standard_Integer>& theErrs,
+     const Standard_Integer theNbChunks)
+  :
+    myMS(theMS),
+    myTol(theTol),
+    myPnts(thePnts),
+    myErrs(theErrs),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    //
+    aNb=myMS.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myErrs(i)=GEOMAlgo_GetInPlace::PntInShape(myMS(i), myTol, myPnts(i));
+    }
+  }
+  //
+ protected:
+  const TopTools_IndexedMapOfShape& myMS;
+  Standard_Real myTol;
+  NCollection_Array1<gp_Pnt>& myPnts;
+  NCollection_Array1<Standard_Integer>& myErrs;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//class    : GEOMAlgo_GetInPlaceCheckFunctor
+//purpose  : checks the chunk of the pairs theVCS;
+//           each chunk takes the context of a free slot of the pool,
+//           the pool has one slot per thread
+//=======================================================================
+class GEOMAlgo_GetInPlaceCheckFunctor
+{
+ public:
+  GEOMAlgo_GetInPlaceCheckFunctor
+    (const GEOMAlgo_GetInPlace& theAlgo,
+     const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS,
+     const Handle(GEOMAlgo_ContextPool)& thePool,
+     NCollection_Array1<Standard_Boolean>& theFound,
+     NCollection_Array1<Standard_Integer>& theErrs,
+     const Standard_Integer theNbChunks)
+  :
+    myAlgo(theAlgo),
+    myVCS(theVCS),
+    myPool(thePool),
+    myFound(theFound),
+    myErrs(theErrs),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb, iSlot;
+    gp_Pnt aP2;
+    Handle(IntTools_Context) aCtx;
+    //
+    // the context of the free slot of the pool, a local one
+    // if there is no free slot
+    iSlot=myPool->Acquire();
+    if (iSlot<0) {
+      aCtx=new IntTools_Context;
+    }
+    else {
+      aCtx=myPool->Context(iSlot);
+    }
+    //
+    aNb=myVCS.Length();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 0, aNb-1, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      const GEOMAlgo_CoupleOfShapes& aCS=myVCS(i);
+      if (myAlgo.FindPnt(aCS.Shape2(), aP2)) {
+        myErrs(i)=50; // the point can not be computed
+        continue;
+      }
+      myFound(i)=myAlgo.IsPntOnShape(aCS.Shape1(), aP2, aCtx);
+    }
+    //
+    if (iSlot>=0) {
+      myPool->Release(iSlot);
+    }
+  }
+  //
+ protected:
+  const GEOMAlgo_GetInPlace& myAlgo;
+  const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& myVCS;
+  Handle(GEOMAlgo_ContextPool) myPool;
+  NCollection_Array1<Standard_Boolean>& myFound;
+  NCollection_Array1<Standard_Integer>& myErrs;
+  Standard_Integer myNbChunks;
+};
+
 //=======================================================================
 //function : CheckCoincidence
 //purpose  :
@@ -92,64 +203,224 @@ Standard_Boolean GEOMAlgo_GetInPlace::CheckCoincidence(const TopoDS_Shape& aS1,
 {
   Standard_Boolean bOk;
   Standard_Integer iErr;
-  //Standard_Real aTol2;
-  TopAbs_ShapeEnum aType1, aType2;
-  TopAbs_State aState;
-  gp_Pnt aP1, aP2;
+  gp_Pnt aP2;
   //
   myErrorStatus=0;
   //
-  iErr=0;
   bOk=Standard_False;
-  //aTol2=myTolerance*myTolerance;
-  aType1=aS1.ShapeType();
-  aType2=aS2.ShapeType();
   //
   // 1. A point on shape #2 -> aP2
-  if (myMapShapePnt.IsBound(aS2)) {
-    aP2=myMapShapePnt.Find(aS2);
+  iErr=FindPnt(aS2, aP2);
+  if (iErr==1) {
+    iErr=PntInShape(aS2, myTolerance, aP2);
+    if (!iErr) {
+      myMapShapePnt.Bind(aS2, aP2);
+    }
   }
-  else {//else 1
-    if (aType2==TopAbs_VERTEX) {
-      const TopoDS_Vertex& aV2=*((TopoDS_Vertex*)&aS2);
-      aP2=BRep_Tool::Pnt(aV2);
+  if (iErr) {
+    myErrorStatus=50;
+    return bOk;
+  }
+  //
+  // 2. Project the point aP2 on shape #1 and check
+  bOk=IsPntOnShape(aS1, aP2, myContext);
+  //
+  return bOk;
+}
+//=======================================================================
+//function : CheckCoincidences
+//purpose  : checks the pairs of theVCS and fills myShapesIn in the
+//           order of the pairs; in the parallel mode the points of
+//           the shapes #2 are computed first, then the pairs are
+//           checked by the threads, each with its own context
+//=======================================================================
+void GEOMAlgo_GetInPlace::CheckCoincidences
+  (const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS)
+{
+  Standard_Boolean bFound;
+  Standard_Integer i, aNb, aNbChunks;
+  //
+  myErrorStatus=0;
+  //
+  aNb=theVCS.Length();
+  if (!aNb) {
+    return;
+  }
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, myRunParallel);
+  //
+  if (aNbChunks==1) {
+    for (i=0; i<aNb; ++i) {
+      const GEOMAlgo_CoupleOfShapes& aCS=theVCS(i);
+      bFound=CheckCoincidence(aCS.Shape1(), aCS.Shape2());
+      if (myErrorStatus) {
+        return;
+      }
+      if (bFound) {
+        FillShapesIn(aCS.Shape1(), aCS.Shape2());
+      }
     }
-    //
-    else if (aType2==TopAbs_EDGE) {
-      const TopoDS_Edge& aE2=*((TopoDS_Edge*)&aS2);
-      iErr=PntInEdge(aE2, aP2);
+    return;
+  }
+  //
+  // 1. the points
+  FillPoints(theVCS);
+  //
+  // 2. the checks
+  NCollection_Array1<Standard_Boolean> aFound(0, aNb-1);
+  NCollection_Array1<Standard_Integer> aErrs(0, aNb-1);
+  aFound.Init(Standard_False);
+  aErrs.Init(0);
+  //
+  const Handle(GEOMAlgo_ContextPool)& aPool=ContextPool();
+  aPool->Reserve(GEOMAlgo_AlgoTools::NbSlots(aNbChunks));
+  //
+  GEOMAlgo_GetInPlaceCheckFunctor aFunctor(*this, theVCS, aPool,
+                                           aFound, aErrs, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor);
+  //
+  // 3. merge
+  for (i=0; i<aNb; ++i) {
+    if (aErrs(i)) {
+      myErrorStatus=aErrs(i);
+      return;
     }
-    //
-    else if (aType2==TopAbs_FACE) {
-      const TopoDS_Face& aF2=*((TopoDS_Face*)&aS2);
-      iErr=PntInFace(aF2, aP2);
+    if (aFound(i)) {
+      const GEOMAlgo_CoupleOfShapes& aCS=theVCS(i);
+      FillShapesIn(aCS.Shape1(), aCS.Shape2());
     }
-    //
-    else if (aType2==TopAbs_SOLID) {
-      const TopoDS_Solid& aZ2=*((TopoDS_Solid*)&aS2);
-      iErr=PntInSolid(aZ2, myTolerance, aP2);
+  }
+}
+//=======================================================================
+//function : FillPoints
+//purpose  : computes in parallel the points of the shapes #2 of
+//           theVCS that are neither in the table of the inner points
+//           nor in myMapShapePnt
+//=======================================================================
+void GEOMAlgo_GetInPlace::FillPoints
+  (const NCollection_Vector<GEOMAlgo_CoupleOfShapes>& theVCS)
+{
+  Standard_Integer i, aNb, aNbChunks;
+  gp_Pnt aP2;
+  TopTools_IndexedMapOfShape aMS;
+  //
+  aNb=theVCS.Length();
+  for (i=0; i<aNb; ++i) {
+    const TopoDS_Shape& aS2=theVCS(i).Shape2();
+    if (FindPnt(aS2, aP2)==1) {
+      aMS.Add(aS2);
     }
-    //
-    else {
-      iErr=1;
+  }
+  //
+  aNb=aMS.Extent();
+  if (!aNb) {
+    return;
+  }
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, Standard_True);
+  //
+  NCollection_Array1<gp_Pnt> aPnts(1, aNb);
+  NCollection_Array1<Standard_Integer> aErrs(1, aNb);
+  aErrs.Init(0);
+  //
+  GEOMAlgo_GetInPlacePntFunctor aFunctor(aMS, myTolerance, aPnts, aErrs,
+                                         aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+  //
+  for (i=1; i<=aNb; ++i) {
+    if (!aErrs(i)) {
+      myMapShapePnt.Bind(aMS(i), aPnts(i));
     }
-    //
-    if (iErr) {
-      myErrorStatus=50;
-      return bOk;
+  }
+}
+//=======================================================================
+//function : FindPnt
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GetInPlace::FindPnt(const TopoDS_Shape& aS2,
+                                              gp_Pnt& aP2) const
+{
+  Standard_Integer i;
+  //
+  if (!myInnerPoints.IsNull() && myInnerPoints->IsDone()) {
+    i=myInnerPoints->Index(aS2);
+    if (i) {
+      if (myInnerPoints->Status(i)) {
+        return 2;
+      }
+      aP2=myInnerPoints->Pnt(i);
+      return 0;
     }
-    //
-    myMapShapePnt.Bind(aS2, aP2);
-  } //else 1
+  }
+  //
+  const gp_Pnt* pP2=myMapShapePnt.Seek(aS2);
+  if (!pP2) {
+    return 1;
+  }
+  aP2=*pP2;
+  return 0;
+}
+//=======================================================================
+//function : PntInShape
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_GetInPlace::PntInShape(const TopoDS_Shape& aS2,
+                                                 const Standard_Real aTol,
+                                                 gp_Pnt& aP2)
+{
+  Standard_Integer iErr;
+  TopAbs_ShapeEnum aType2;
+  //
+  iErr=0;
+  aType2=aS2.ShapeType();
+  if (aType2==TopAbs_VERTEX) {
+    const TopoDS_Vertex& aV2=*((TopoDS_Vertex*)&aS2);
+    aP2=BRep_Tool::Pnt(aV2);
+  }
+  //
+  else if (aType2==TopAbs_EDGE) {
+    const TopoDS_Edge& aE2=*((TopoDS_Edge*)&aS2);
+    iErr=PntInEdge(aE2, aP2);
+  }
+  //
+  else if (aType2==TopAbs_FACE) {
+    const TopoDS_Face& aF2=*((TopoDS_Face*)&aS2);
+    iErr=PntInFace(aF2, aP2);
+  }
+  //
+  else if (aType2==TopAbs_SOLID) {
+    const TopoDS_Solid& aZ2=*((TopoDS_Solid*)&aS2);
+    iErr=PntInSolid(aZ2, aTol, aP2);
+  }
+  //
+  else {
+    iErr=1;
+  }
+  return iErr;
+}
+//=======================================================================
+//function : IsPntOnShape
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_GetInPlace::IsPntOnShape
+  (const TopoDS_Shape& aS1,
+   const gp_Pnt& aP2,
+   const Handle(IntTools_Context)& aCtx) const
+{
+  Standard_Boolean bOk;
+  TopAbs_ShapeEnum aType1;
+  TopAbs_State aState;
+  //
+  bOk=Standard_False;
+  aType1=aS1.ShapeType();
   //
-  // 2. Project the point aP2 on shape #1 and check
   if (aType1==TopAbs_EDGE) {
     Standard_Integer aNbPoints;
     Standard_Real aDmin, aT, aT1, aT2, dT;
     //
     const TopoDS_Edge& aE1=*((TopoDS_Edge*)&aS1);
     //
-    GeomAPI_ProjectPointOnCurve& aPPC=myContext->ProjPC(aE1);
+    GeomAPI_ProjectPointOnCurve& aPPC=aCtx->ProjPC(aE1);
     aPPC.Perform(aP2);
     aNbPoints=aPPC.NbPoints();
     if (aNbPoints) {
@@ -163,30 +434,23 @@ Standard_Boolean GEOMAlgo_GetInPlace::CheckCoincidence(const TopoDS_Shape& aS1,
         }
       }
     }
-    //else {
-    // iErr=2;
-    //}
   }//if (aType1==TopAbs_EDGE) {
   //
   else if (aType1==TopAbs_FACE) {
     const TopoDS_Face& aF1=*((TopoDS_Face*)&aS1);
     //
-    bOk=myContext->IsValidPointForFace(aP2, aF1, myTolerance);
+    bOk=aCtx->IsValidPointForFace(aP2, aF1, myTolerance);
   }
   //
   else if (aType1==TopAbs_SOLID) {
     const TopoDS_Solid& aZ1=*((TopoDS_Solid*)&aS1);
     //
-    BRepClass3d_SolidClassifier& aSC=myContext->SolidClassifier(aZ1);
+    BRepClass3d_SolidClassifier& aSC=aCtx->SolidClassifier(aZ1);
     aSC.Perform(aP2, myTolerance);
     aState=aSC.State();
     bOk=(aState==TopAbs_IN);
   }
   //
-  if (iErr) {
-    myErrorStatus=50;
-  }
-  //
   return bOk;
 }
 //=======================================================================
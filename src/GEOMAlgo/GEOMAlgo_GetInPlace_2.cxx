@@ -41,11 +41,12 @@
 #include <TopTools_MapIteratorOfMapOfShape.hxx>
 #include <TopTools_ListOfShape.hxx>
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_DataMapOfShapeShape.hxx>
+#include <TopTools_DataMapOfShapeListOfShape.hxx>
 
 #include <TopExp.hxx>
 
 #include <GProp_GProps.hxx>
-#include <BRepGProp.hxx>
 
 
 static
@@ -53,6 +54,20 @@ static
 static
   void PointProperties(const TopoDS_Shape& aS,
                        GProp_GProps& aGProps);
+static
+  void CachedProperties(const Handle(GEOMAlgo_GPropsCache)& aCache,
+                        const TopoDS_Shape& aS,
+                        const Standard_Integer iDim,
+                        GProp_GProps& aGProps);
+static
+  void CollectGProps(const TopoDS_Shape& aS,
+                     const TopTools_DataMapOfShapeListOfShape& aImages,
+                     const TopTools_DataMapOfShapeShape& aInclusive,
+                     TopTools_IndexedMapOfShape aMS[4]);
+static
+  void AddGProps(const TopoDS_Shape& aS,
+                 const TopTools_DataMapOfShapeListOfShape& aImages,
+                 TopTools_IndexedMapOfShape aMS[4]);
 
 //=======================================================================
 //function : CheckGProps
@@ -60,7 +75,20 @@ static
 //=======================================================================
 void GEOMAlgo_GetInPlace::CheckGProps()
 {
+  Standard_Integer iDim;
+  TopTools_IndexedMapOfShape aMS[4];
+  //
   myFound=Standard_True;
+  //
+  // the properties of the shapes to compare, in parallel
+  if (myGPropsCache.IsNull()) {
+    myGPropsCache=new GEOMAlgo_GPropsCache;
+  }
+  CollectGProps(myArgument, myImages, myShapesInclusive, aMS);
+  for (iDim=1; iDim<=3; ++iDim) {
+    myGPropsCache->Fill(aMS[iDim], iDim, 0., myRunParallel);
+  }
+  //
   CheckGProps(myArgument);
 }
 //=======================================================================
@@ -180,41 +208,34 @@ Standard_Boolean GEOMAlgo_GetInPlace::CompareGProps
                          const TopTools_ListOfShape &theListShape2) const
 {
   Standard_Boolean                   aResult = Standard_True;
-  TopoDS_Compound                    aComp2;
-  BRep_Builder                       aBuilder;
   TopTools_ListIteratorOfListOfShape anIt(theListShape2);
 
-  aBuilder.MakeCompound(aComp2);
-
-  for (; anIt.More(); anIt.Next()) {
-    const TopoDS_Shape &aShape2 = anIt.Value();
-
-    aBuilder.Add(aComp2, aShape2);
-  }
-
   // Compute General Properties.
+  // The properties of the compound of the images are the sum of
+  // the properties of the images, taken from the cache.
   GProp_GProps           aG1;
   GProp_GProps           aG2;
   const Standard_Real    aTolCG2     = myTolCG*myTolCG;
-  Standard_Boolean       bOnlyClosed = Standard_False;
   const TopAbs_ShapeEnum aType       = theShape1.ShapeType();
   const Standard_Integer iDim        = Dimension(aType);
 
   if (iDim == 0) {
+    TopoDS_Compound aComp2;
+    BRep_Builder    aBuilder;
+
+    aBuilder.MakeCompound(aComp2);
+    for (; anIt.More(); anIt.Next()) {
+      aBuilder.Add(aComp2, anIt.Value());
+    }
+
     PointProperties(theShape1, aG1);
     PointProperties(aComp2,    aG2);
   }
-  else if (iDim == 1) {
-    BRepGProp::LinearProperties(theShape1, aG1);
-    BRepGProp::LinearProperties(aComp2,    aG2);
-  }
-  else if (iDim == 2) {
-    BRepGProp::SurfaceProperties(theShape1, aG1);
-    BRepGProp::SurfaceProperties(aComp2,    aG2);
-  }
-  else if (iDim == 3) {
-    BRepGProp::VolumeProperties(theShape1, aG1, bOnlyClosed);
-    BRepGProp::VolumeProperties(aComp2,    aG2, bOnlyClosed);
+  else if (iDim >= 1 && iDim <= 3) {
+    CachedProperties(myGPropsCache, theShape1, iDim, aG1);
+    for (; anIt.More(); anIt.Next()) {
+      CachedProperties(myGPropsCache, anIt.Value(), iDim, aG2);
+    }
   } else {
     return Standard_False;
   }
@@ -307,6 +328,83 @@ class GEOMAlgo_GProps : public GProp_GProps {
   }
 };
 //=======================================================================
+//function : CachedProperties
+//purpose  : adds the properties of aS to aGProps
+//=======================================================================
+void CachedProperties(const Handle(GEOMAlgo_GPropsCache)& aCache,
+                      const TopoDS_Shape& aS,
+                      const Standard_Integer iDim,
+                      GProp_GProps& aGProps)
+{
+  Standard_Real aMass, aDensity;
+  gp_Pnt aCG;
+  GEOMAlgo_GProps aGPropsX;
+  //
+  aDensity=1.;
+  //
+  if (aCache.IsNull()) {
+    GEOMAlgo_GPropsCache::Compute(aS, iDim, 0., aMass, aCG);
+  }
+  else {
+    aCache->Properties(aS, iDim, 0., aMass, aCG);
+  }
+  aGPropsX.SetMass(aMass);
+  aGPropsX.SetCG(aCG);
+  aGProps.Add(aGPropsX, aDensity);
+}
+//=======================================================================
+//function : CollectGProps
+//purpose  : collects the shapes compared by CheckGProps
+//=======================================================================
+void CollectGProps(const TopoDS_Shape& aS,
+                   const TopTools_DataMapOfShapeListOfShape& aImages,
+                   const TopTools_DataMapOfShapeShape& aInclusive,
+                   TopTools_IndexedMapOfShape aMS[4])
+{
+  TopAbs_ShapeEnum aType;
+  TopoDS_Iterator aIt;
+  //
+  if (aS.ShapeType()!=TopAbs_COMPOUND) {
+    AddGProps(aS, aImages, aMS);
+    return;
+  }
+  //
+  aIt.Initialize(aS);
+  for(; aIt.More(); aIt.Next()) {
+    const TopoDS_Shape& aSx=aIt.Value();
+    aType=aSx.ShapeType();
+    if (aType!=TopAbs_COMPOUND && aInclusive.IsBound(aSx)) {
+      // a part of a whole
+      AddGProps(aInclusive.Find(aSx), aImages, aMS);
+    }
+    else {
+      CollectGProps(aSx, aImages, aInclusive, aMS);
+    }
+  }
+}
+//=======================================================================
+//function : AddGProps
+//purpose  : adds aS and its images to the map of its dimension
+//=======================================================================
+void AddGProps(const TopoDS_Shape& aS,
+               const TopTools_DataMapOfShapeListOfShape& aImages,
+               TopTools_IndexedMapOfShape aMS[4])
+{
+  Standard_Integer iDim;
+  TopTools_ListIteratorOfListOfShape aItLS;
+  //
+  iDim=Dimension(aS.ShapeType());
+  if (iDim<1 || !aImages.IsBound(aS)) {
+    return;
+  }
+  //
+  aMS[iDim].Add(aS);
+  aItLS.Initialize(aImages.Find(aS));
+  for (; aItLS.More(); aItLS.Next()) {
+    aMS[iDim].Add(aItLS.Value());
+  }
+}
+//=======================================================================
 //function : PointProperties
 //purpose  :
 //=======================================================================
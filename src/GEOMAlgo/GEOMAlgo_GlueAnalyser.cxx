@@ -160,17 +160,12 @@
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, i, aNbV, aIndex, aNbVSD;
-  TColStd_ListIteratorOfListOfInteger aIt;
-  Handle(Bnd_HArray1OfBox) aHAB;
-  Bnd_BoundSortBox aBSB;
-  TopoDS_Shape aSTmp, aVF;
-  TopoDS_Vertex aVnew;
-  TopTools_IndexedMapOfShape aMV, aMVProcessed;
+  Standard_Integer j, k, aNbV, aNbChains;
+  TopoDS_Shape aVF;
+  TopTools_IndexedMapOfShape aMV;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBox aMSB;
+  NCollection_Array1<Standard_Integer> aOffsets, aMembers;
   //
   TopExp::MapShapes(myShape, TopAbs_VERTEX, aMV);
   aNbV=aMV.Extent();
@@ -179,49 +174,17 @@
     return;
   }
   //
-  aHAB=new Bnd_HArray1OfBox(1, aNbV);
+  // Images
+  GEOMAlgo_AlgoTools::FindSDVertices(aMV, myTol, myRunParallel,
+                                     aNbChains, aOffsets, aMembers);
   //
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
-    Bnd_Box aBox;
-    //
-    aBox.SetGap(myTol);
-    BRepBndLib::Add(aV, aBox);
-    aHAB->SetValue(i, aBox);
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
-  }
-  //
-  aBSB.Initialize(aHAB);
-  //
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
-    //
-    if (aMVProcessed.Contains(aV)) {
-      continue;
-    }
-    //
-    const Bnd_Box& aBoxV=aMSB.FindFromKey(aV);
-    const TColStd_ListOfInteger& aLI=aBSB.Compare(aBoxV);
-    aNbVSD=aLI.Extent();
-    if (!aNbVSD) {
-      myErrorStatus=3; // it must not be
-      return;
-    }
-    //
-    // Images
+  for (k=1; k<=aNbChains; ++k) {
     TopTools_ListOfShape aLVSD;
     //
-    aIt.Initialize(aLI);
-    for (j=0; aIt.More(); aIt.Next(), ++j) {
-      aIndex=aIt.Value();
-      const TopoDS_Shape& aVx=aMIS.FindFromKey(aIndex);
-      if(!j) {
-        aVF=aVx;
-      }
-      aLVSD.Append(aVx);
-      aMVProcessed.Add(aVx);
+    for (j=aOffsets(k); j<aOffsets(k+1); ++j) {
+      aLVSD.Append(aMV(aMembers(j)));
     }
+    aVF=aLVSD.First();
     myImages.Bind(aVF, aLVSD);
   }
   // Origins
@@ -303,7 +266,8 @@
   }
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext); //XX
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, ContextPool(),
+                                            myRunParallel); //XX
     if (iErr) {
       myErrorStatus=200;
       return;
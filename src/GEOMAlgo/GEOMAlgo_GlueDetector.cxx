@@ -108,6 +108,7 @@ void GEOMAlgo_GlueDetector::Perform()
   myErrorStatus=0;
   myWarningStatus=0;
   myStickedShapes.Clear();
+  ClearPhases();
   //
   CheckData();
   if (myErrorStatus) {
@@ -117,16 +118,21 @@ void GEOMAlgo_GlueDetector::Perform()
   // Initialize the context
   GEOMAlgo_GluerAlgo::Perform();
   //
+  BeginPhase("DetectVertices");
   DetectVertices();
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("CheckDetected");
   CheckDetected();
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  // the phases DetectEdges/RefineSDEdges are recorded by DetectShapes()
   DetectEdges();
   if (myErrorStatus) {
     return;
@@ -143,21 +149,12 @@ void GEOMAlgo_GlueDetector::Perform()
 //=======================================================================
 void GEOMAlgo_GlueDetector::DetectVertices()
 {
-  Standard_Integer j, i, aNbV, aNbVSD;
-  Standard_Real aTolV;
-  gp_Pnt aPV;
-  TColStd_ListIteratorOfListOfInteger aIt;
+  Standard_Integer j, k, aNbV, aNbChains;
   TopoDS_Shape aVF;
   TopTools_IndexedMapOfShape aMV;
-  TopTools_MapOfShape aMVProcessed;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
-  TopTools_DataMapOfShapeListOfShape aMVV;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBndSphere aMSB;
-  GEOMAlgo_BndSphereTreeSelector aSelector;
-  GEOMAlgo_BndSphereTree aBBTree;
-  NCollection_UBTreeFiller <Standard_Integer, GEOMAlgo_BndSphere> aTreeFiller(aBBTree);
+  NCollection_Array1<Standard_Integer> aOffsets, aMembers;
   //
   myErrorStatus=0;
   //
@@ -167,113 +164,27 @@ void GEOMAlgo_GlueDetector::DetectVertices()
     myErrorStatus=2; // no vertices in source shape
     return;
   }
-  //
-  for (i=1; i<=aNbV; ++i) {
-    GEOMAlgo_BndSphere aBox;
-    //
-    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    aPV=BRep_Tool::Pnt(aV);
-    aTolV=BRep_Tool::Tolerance(aV);
-    //
-    aBox.SetGap(myTolerance);
-    aBox.SetCenter(aPV);
-    aBox.SetRadius(aTolV);
-    //
-    aTreeFiller.Add(i, aBox);
-    //
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
-  }
-  //
-  aTreeFiller.Fill();
+  AddPhaseShapes(aNbV);
   //
   //---------------------------------------------------
   // Chains
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Shape& aV=aMV(i);
-    //
-    if (aMVProcessed.Contains(aV)) {
-      continue;
-    }
-    //
-    Standard_Integer aNbIP, aIP, aNbIP1, aIP1;
+  GEOMAlgo_AlgoTools::FindSDVertices(aMV, myTolerance, myRunParallel,
+                                     aNbChains, aOffsets, aMembers);
+  AddPhaseTreeQueries(aNbV);
+  //
+  for (k=1; k<=aNbChains; ++k) {
     TopTools_ListOfShape aLVSD;
-    TColStd_MapOfInteger aMIP, aMIP1, aMIPC;
-    TColStd_MapIteratorOfMapOfInteger aIt1;
     //
-    aMIP.Add(i);
-    for(;;) {
-      aNbIP=aMIP.Extent();
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        if (aMIPC.Contains(aIP)) {
-          continue;
-        }
-        //
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        const GEOMAlgo_BndSphere& aBoxVP=aMSB.FindFromKey(aVP);
-        //
-        aSelector.Clear();
-        aSelector.SetBox(aBoxVP);
-        //
-        aNbVSD=aBBTree.Select(aSelector);
-        if (!aNbVSD) {
-          continue;  // it should not be so [at least IP itself]
-        }
-        //
-        const TColStd_ListOfInteger& aLI=aSelector.Indices();
-        aIt.Initialize(aLI);
-        for (; aIt.More(); aIt.Next()) {
-          aIP1=aIt.Value();
-          if (aMIP.Contains(aIP1)) {
-            continue;
-          }
-          aMIP1.Add(aIP1);
-        } //for (; aIt.More(); aIt.Next()) {
-      }//for(; aIt1.More(); aIt1.Next()) {
-      //
-      aNbIP1=aMIP1.Extent();
-      if (!aNbIP1) {
-        break;
-      }
-      //
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIPC.Add(aIP);
-      }
-      //
-      aMIP.Clear();
-      aIt1.Initialize(aMIP1);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIP.Add(aIP);
-      }
-      aMIP1.Clear();
-    }// while(1)
-    //
-    // Fill myImages
-    aNbIP=aMIPC.Extent();
-    //
-    if (!aNbIP) {// no SD vertices is found
-      aMVProcessed.Add(aV);
-      continue;
+    if (aOffsets(k+1)-aOffsets(k)<2) {
+      continue; // no SD vertices is found
     }
-    //else { // SD vertices founded [ aMIPC ]
-    aIt1.Initialize(aMIPC);
-    for(j=0; aIt1.More(); aIt1.Next(), ++j) {
-      aIP=aIt1.Key();
-      const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-      if (!j) {
-        aVF=aVP;
-      }
-      aLVSD.Append(aVP);
-      aMVProcessed.Add(aVP);
+    //
+    for (j=aOffsets(k); j<aOffsets(k+1); ++j) {
+      aLVSD.Append(aMV(aMembers(j)));
     }
-    //}
+    aVF=aLVSD.First();
     myImages.Bind(aVF, aLVSD);
-  }// for (i=1; i<=aNbV; ++i) {
+  }
   //------------------------------
   // Origins
   aItIm.Initialize(myImages);
@@ -320,9 +231,12 @@ void GEOMAlgo_GlueDetector::DetectShapes(const TopAbs_ShapeEnum aType)
   //
   myErrorStatus=0;
   //
+  BeginPhase((aType==TopAbs_FACE) ? "DetectFaces" : "DetectEdges");
+  //
   TopExp::MapShapes(myArgument, aType, aMF);
   //
   aNbF=aMF.Extent();
+  AddPhaseShapes(aNbF);
   for (i=1; i<=aNbF; ++i) {
     const TopoDS_Shape& aS=aMF(i);
     //
@@ -336,6 +250,7 @@ void GEOMAlgo_GlueDetector::DetectShapes(const TopAbs_ShapeEnum aType)
     }
     //
     if (myErrorStatus) {
+      EndPhase();
       return;
     }
     //
@@ -350,9 +265,15 @@ void GEOMAlgo_GlueDetector::DetectShapes(const TopAbs_ShapeEnum aType)
       aMPKLF.Add(aPKF, aLSDF);
     }
   }
+  EndPhase();
+  //
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTolerance, myContext);
+    BeginPhase((aType==TopAbs_FACE) ? "RefineSDFaces" : "RefineSDEdges");
+    AddPhaseShapes(aMPKLF.Extent());
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTolerance, ContextPool(),
+                                            myRunParallel);
+    EndPhase();
     if (iErr) {
       myErrorStatus=200;
       return;
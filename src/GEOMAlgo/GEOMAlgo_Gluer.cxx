@@ -197,9 +197,18 @@ void GEOMAlgo_Gluer::Perform()
     &GEOMAlgo_Gluer::MakeFaces,       &GEOMAlgo_Gluer::MakeShells,
     &GEOMAlgo_Gluer::MakeSolids,      &GEOMAlgo_Gluer::CheckResult
   };
+  const Standard_CString aNames[aNb]={
+    "CheckData",    "InnerTolerance",
+    "MakeVertices", "MakeEdges",
+    "MakeFaces",    "MakeShells",
+    "MakeSolids",   "CheckResult"
+  };
   //
+  ClearPhases();
   for (i=0; i<aNb; ++i) {
+    BeginPhase(aNames[i]);
     (this->*pF[i])();
+    EndPhase();
     if (myErrorStatus) {
       return;
     }
@@ -214,22 +223,14 @@ void GEOMAlgo_Gluer::MakeVertices()
 {
   myErrorStatus=0;
   //
-  Standard_Integer j, i, aNbV, aNbVSD;
-  Standard_Real aTolV;
-  gp_Pnt aPV;
-  TColStd_ListIteratorOfListOfInteger aIt;
+  Standard_Integer j, k, i, aNbV, aNbVSD, aNbChains;
   TopoDS_Shape aVF;
   TopoDS_Vertex aVnew;
-  TopTools_IndexedMapOfShape aMV, aMVProcessed;
+  TopTools_IndexedMapOfShape aMV;
   TopTools_ListIteratorOfListOfShape aItS;
   TopTools_DataMapIteratorOfDataMapOfShapeListOfShape aItIm;
   TopTools_DataMapOfShapeListOfShape aMVV;
-  GEOMAlgo_IndexedDataMapOfIntegerShape aMIS;
-  GEOMAlgo_IndexedDataMapOfShapeBndSphere aMSB;
-  //
-  GEOMAlgo_BndSphereTreeSelector aSelector;
-  GEOMAlgo_BndSphereTree aBBTree;
-  NCollection_UBTreeFiller <Standard_Integer, GEOMAlgo_BndSphere> aTreeFiller(aBBTree);
+  NCollection_Array1<Standard_Integer> aOffsets, aMembers;
   //
   TopExp::MapShapes(myShape, TopAbs_VERTEX, aMV);
   aNbV=aMV.Extent();
@@ -238,114 +239,20 @@ void GEOMAlgo_Gluer::MakeVertices()
     return;
   }
   //
-  for (i=1; i<=aNbV; ++i) {
-    GEOMAlgo_BndSphere aBox;
-    //
-    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    aPV=BRep_Tool::Pnt(aV);
-    aTolV=BRep_Tool::Tolerance(aV);
-    //
-    aBox.SetGap(myTol);
-    aBox.SetCenter(aPV);
-    aBox.SetRadius(aTolV);
-    //
-    aTreeFiller.Add(i, aBox);
-    //
-    aMIS.Add(i, aV);
-    aMSB.Add(aV, aBox);
-  }
-  //
-  aTreeFiller.Fill();
-  //
   //------------------------------
   // Chains
-  for (i=1; i<=aNbV; ++i) {
-    const TopoDS_Vertex& aV=*((TopoDS_Vertex*)&aMV(i));
-    //
-    if (aMVProcessed.Contains(aV)) {
-      continue;
-    }
-    //
-    Standard_Integer aNbIP, aIP, aNbIP1, aIP1;
+  GEOMAlgo_AlgoTools::FindSDVertices(aMV, myTol, myRunParallel,
+                                     aNbChains, aOffsets, aMembers);
+  //
+  for (k=1; k<=aNbChains; ++k) {
     TopTools_ListOfShape aLVSD;
-    TColStd_MapOfInteger aMIP, aMIP1, aMIPC;
-    TColStd_MapIteratorOfMapOfInteger aIt1;
     //
-    aMIP.Add(i);
-    for(;;) {
-      aNbIP=aMIP.Extent();
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        if (aMIPC.Contains(aIP)) {
-          continue;
-        }
-        //
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        const GEOMAlgo_BndSphere& aBoxVP=aMSB.FindFromKey(aVP);
-        //
-        aSelector.Clear();
-        aSelector.SetBox(aBoxVP);
-        //
-        aNbVSD=aBBTree.Select(aSelector);
-        if (!aNbVSD) {
-          continue;  // it must not be
- }
-        //
-        const TColStd_ListOfInteger& aLI=aSelector.Indices();
-        //
-        aIt.Initialize(aLI);
-        for (; aIt.More(); aIt.Next()) {
-          aIP1=aIt.Value();
-          if (aMIP.Contains(aIP1)) {
-            continue;
-          }
-          aMIP1.Add(aIP1);
-        } //for (; aIt.More(); aIt.Next()) {
-      }//for(; aIt1.More(); aIt1.Next()) {
-      //
-      aNbIP1=aMIP1.Extent();
-      if (!aNbIP1) {
-        break;
-      }
-      //
-      aIt1.Initialize(aMIP);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIPC.Add(aIP);
-      }
-      //
-      aMIP.Clear();
-      aIt1.Initialize(aMIP1);
-      for(; aIt1.More(); aIt1.Next()) {
-        aIP=aIt1.Key();
-        aMIP.Add(aIP);
-      }
-      aMIP1.Clear();
-    }// while(1)
-    //
-    // Fill myImages
-    aNbIP=aMIPC.Extent();
-    //
-    if (!aNbIP) {// no SD vertices founded
-      aVF=aV;
-      aLVSD.Append(aV);
-      aMVProcessed.Add(aV);
-    }
-    else { // SD vertices founded [ aMIPC ]
-      aIt1.Initialize(aMIPC);
-      for(j=0; aIt1.More(); aIt1.Next(), ++j) {
-        aIP=aIt1.Key();
-        const TopoDS_Shape& aVP=aMIS.FindFromKey(aIP);
-        if (!j) {
-          aVF=aVP;
-        }
-        aLVSD.Append(aVP);
-        aMVProcessed.Add(aVP);
-      }
+    for (j=aOffsets(k); j<aOffsets(k+1); ++j) {
+      aLVSD.Append(aMV(aMembers(j)));
     }
+    aVF=aLVSD.First();
     myImages.Bind(aVF, aLVSD);
-  }// for (i=1; i<=aNbV; ++i) {
+  }
   //------------------------------
   //
   // Make new vertices
@@ -632,7 +539,8 @@ void GEOMAlgo_Gluer::MakeShapes(const TopAbs_ShapeEnum aType)
   }
   // check geometric coincidence
   if (myCheckGeometry) {
-    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, myContext);
+    iErr=GEOMAlgo_AlgoTools::RefineSDShapes(aMPKLF, myTol, ContextPool(),
+                                            myRunParallel);
     if (iErr) {
       myErrorStatus=200;
       return;
@@ -150,9 +150,21 @@ const TopTools_DataMapOfShapeListOfShape& GEOMAlgo_Gluer2::ImagesToWork()const
 //=======================================================================
 void GEOMAlgo_Gluer2::Perform()
 {
+  Standard_Integer aNbI;
+  //
   myErrorStatus=0;
   myWarningStatus=0;
   //
+  // the phases of the last Detect() open the phases of the glue,
+  // the phases of the previous runs are dropped
+  ClearPhases();
+  if (myTimingEnabled) {
+    GEOMAlgo_VectorOfPhaseInfo::Iterator aItPh(myDetector.Phases());
+    for (; aItPh.More(); aItPh.Next()) {
+      myPhases.Append(aItPh.Value());
+    }
+  }
+  //
   CheckData();
   if (myErrorStatus) {
     return;
@@ -161,7 +173,9 @@ void GEOMAlgo_Gluer2::Perform()
   // Initialize the context
   GEOMAlgo_GluerAlgo::Perform();
   //
+  BeginPhase("PerformShapesToWork");
   PerformShapesToWork();
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
@@ -171,57 +185,95 @@ void GEOMAlgo_Gluer2::Perform()
     return;
   }
   //
+  BeginPhase("FillVertices");
+  aNbI=myImages.Extent();
   FillVertices();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillEdges");
+  aNbI=myImages.Extent();
   FillEdges();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillWires");
+  aNbI=myImages.Extent();
   FillWires();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillFaces");
+  aNbI=myImages.Extent();
   FillFaces();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillShells");
+  aNbI=myImages.Extent();
   FillShells();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillSolids");
+  aNbI=myImages.Extent();
   FillSolids();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillCompSolids");
+  aNbI=myImages.Extent();
   FillCompSolids();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("FillCompounds");
+  aNbI=myImages.Extent();
   FillCompounds();
+  AddPhaseShapes(myImages.Extent()-aNbI);
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("BuildResult");
   BuildResult();
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("PrepareHistory");
   PrepareHistory();
+  EndPhase();
   if (myErrorStatus) {
     return;
   }
   //
+  BeginPhase("SameParameter");
   BRepLib::SameParameter(myShape, myTolerance, Standard_True);
+  EndPhase();
 }
 //=======================================================================
 //function : CheckData
@@ -75,6 +75,9 @@ public:
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  //! Detects the coincident sub-shapes of the argument. <br>
+  //!          If the timing is enabled the phases of the detector <br>
+  //!          are recorded ahead of the phases of Perform(). <br>
   Standard_EXPORT
     void Detect() ;
 
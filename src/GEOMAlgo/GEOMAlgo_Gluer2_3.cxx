@@ -85,8 +85,20 @@ void GEOMAlgo_Gluer2::Detect()
   myDetector.SetArgument(myArgument);
   myDetector.SetTolerance(myTolerance);
   myDetector.SetCheckGeometry(bCheckGeometry);
+  myDetector.SetRunParallel(myRunParallel);
+  myDetector.SetTimingEnabled(myTimingEnabled);
   //
   myDetector.Perform();
+  //
+  // the phases of the detector open the phases of the glue
+  ClearPhases();
+  if (myTimingEnabled) {
+    GEOMAlgo_VectorOfPhaseInfo::Iterator aItPh(myDetector.Phases());
+    for (; aItPh.More(); aItPh.Next()) {
+      myPhases.Append(aItPh.Value());
+    }
+  }
+  //
   iErr=myDetector.ErrorStatus();
   if (iErr) {
     // Detector is failed
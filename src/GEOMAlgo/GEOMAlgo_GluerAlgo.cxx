@@ -109,6 +109,20 @@ const Handle(IntTools_Context)& GEOMAlgo_GluerAlgo::Context()
   return myContext;
 }
 //=======================================================================
+//function : ContextPool
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_ContextPool)& GEOMAlgo_GluerAlgo::ContextPool()
+{
+  if (myContext.IsNull()) {
+    myContext=new IntTools_Context;
+  }
+  if (myContextPool.IsNull() || myContextPool->MainContext()!=myContext) {
+    myContextPool=new GEOMAlgo_ContextPool(myContext);
+  }
+  return myContextPool;
+}
+//=======================================================================
 //function : Images
 //purpose  :
 //=======================================================================
@@ -32,6 +32,7 @@
 #include <Standard_Real.hxx>
 #include <Standard_Boolean.hxx>
 #include <IntTools_Context.hxx>
+#include <GEOMAlgo_ContextPool.hxx>
 #include <TopTools_DataMapOfShapeListOfShape.hxx>
 #include <TopTools_DataMapOfShapeShape.hxx>
 
@@ -78,6 +79,11 @@ public:
   Standard_EXPORT
     const Handle(IntTools_Context)& Context() ;
 
+  //! Returns the contexts for the parallel workers, <br>
+  //!          the slot 0 of the pool is Context() <br>
+  Standard_EXPORT
+    const Handle(GEOMAlgo_ContextPool)& ContextPool() ;
+
   Standard_EXPORT
     const TopTools_DataMapOfShapeListOfShape& Images() const;
 
@@ -89,6 +95,7 @@ protected:
   Standard_Real myTolerance;
   Standard_Boolean myCheckGeometry;
   Handle(IntTools_Context) myContext;
+  Handle(GEOMAlgo_ContextPool) myContextPool;
   TopTools_DataMapOfShapeListOfShape myImages;
   TopTools_DataMapOfShapeShape myOrigins;
 
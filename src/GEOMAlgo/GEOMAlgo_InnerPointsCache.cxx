@@ -0,0 +1,92 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_InnerPointsCache.cxx
+//
+#include <GEOMAlgo_InnerPointsCache.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_InnerPointsCache, Standard_Transient);
+
+//=======================================================================
+//function : GEOMAlgo_InnerPointsCache
+//purpose  :
+//=======================================================================
+GEOMAlgo_InnerPointsCache::GEOMAlgo_InnerPointsCache()
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_InnerPointsCache::~GEOMAlgo_InnerPointsCache()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsCache::Clear()
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  myMap.Clear();
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_InnerPointsCache::Extent() const
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  return myMap.Extent();
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsCache::Add(const TopoDS_Shape& aS,
+                                    const Standard_Integer aNbPntsMin,
+                                    const GEOMAlgo_ArrayOfPnt& aLP)
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  //
+  Entry* pEntry=myMap.ChangeSeek(aS);
+  if (!pEntry) {
+    pEntry=myMap.Bound(aS, Entry());
+  }
+  pEntry->myNbPntsMin=aNbPntsMin;
+  pEntry->myLP=aLP;
+}
+//=======================================================================
+//function : Find
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_InnerPointsCache::Find
+  (const TopoDS_Shape& aS,
+   const Standard_Integer aNbPntsMin,
+   GEOMAlgo_ArrayOfPnt& aLP) const
+{
+  Standard_Mutex::Sentry aSentry(myMutex);
+  //
+  const Entry* pEntry=myMap.Seek(aS);
+  if (!pEntry || pEntry->myNbPntsMin!=aNbPntsMin) {
+    return Standard_False;
+  }
+  aLP=pEntry->myLP;
+  return Standard_True;
+}
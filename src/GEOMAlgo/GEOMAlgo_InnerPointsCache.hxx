@@ -0,0 +1,93 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_InnerPointsCache.hxx
+//
+#ifndef _GEOMAlgo_InnerPointsCache_HeaderFile
+#define _GEOMAlgo_InnerPointsCache_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Mutex.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_ShapeMapHasher.hxx>
+#include <NCollection_DataMap.hxx>
+#include <GEOMAlgo_ArrayOfPnt.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_InnerPointsCache, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_InnerPointsCache
+//purpose  : The inner points of the edges and of the faces computed
+//           by GEOMAlgo_FinderShapeOn2, kept to be reused by other
+//           finders working on the same shapes.
+//           The points are keyed by the shape (TShape and Location),
+//           so a modified shape (new TShape) is never found in the
+//           cache. The points computed for one number of the sample
+//           points (NbPntsMin of the finder) are not returned for
+//           another one.
+//           The cache can be used by several threads at once.
+//=======================================================================
+class GEOMAlgo_InnerPointsCache : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_InnerPointsCache();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_InnerPointsCache();
+
+  //! Removes all points <br>
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Returns the number of the shapes in the cache <br>
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Stores the points aLP of the shape aS computed with aNbPntsMin <br>
+  Standard_EXPORT
+    void Add(const TopoDS_Shape& aS,
+             const Standard_Integer aNbPntsMin,
+             const GEOMAlgo_ArrayOfPnt& aLP) ;
+
+  //! Copies the points of the shape aS computed with aNbPntsMin <br>
+  //!          to aLP. Returns False if there are no such points. <br>
+  Standard_EXPORT
+    Standard_Boolean Find(const TopoDS_Shape& aS,
+                          const Standard_Integer aNbPntsMin,
+                          GEOMAlgo_ArrayOfPnt& aLP) const;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_InnerPointsCache, Standard_Transient)
+
+ protected:
+  struct Entry {
+    Standard_Integer myNbPntsMin;
+    GEOMAlgo_ArrayOfPnt myLP;
+  };
+  typedef NCollection_DataMap<TopoDS_Shape, Entry,
+                              TopTools_ShapeMapHasher> DataMapOfShapeEntry;
+
+  DataMapOfShapeEntry myMap;
+  mutable Standard_Mutex myMutex;
+};
+#endif
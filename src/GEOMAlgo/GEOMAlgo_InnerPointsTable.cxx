@@ -0,0 +1,273 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_InnerPointsTable.cxx
+//
+#include <GEOMAlgo_InnerPointsTable.hxx>
+
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Edge.hxx>
+#include <TopExp.hxx>
+#include <BRep_Tool.hxx>
+
+#include <OSD_Parallel.hxx>
+
+#include <GEOMAlgo_GetInPlace.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_InnerPointsTable, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_InnerPointsTableFunctor
+//purpose  : computes the points of the chunk of the sub-shapes
+//=======================================================================
+class GEOMAlgo_InnerPointsTableFunctor
+{
+ public:
+  GEOMAlgo_InnerPointsTableFunctor
+    (const TopTools_IndexedMapOfShape& theShapes,
+     const Standard_Real theTol,
+     NCollection_Array1<gp_Pnt>& thePnts,
+     NCollection_Array1<Standard_Integer>& theStatus,
+     const Standard_Integer theNbChunks)
+  :
+    myShapes(theShapes),
+    myTol(theTol),
+    myPnts(thePnts),
+    myStatus(theStatus),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    //
+    aNb=myShapes.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myStatus(i)=GEOMAlgo_GetInPlace::PntInShape(myShapes(i), myTol,
+                                                  myPnts(i));
+    }
+  }
+  //
+ protected:
+  const TopTools_IndexedMapOfShape& myShapes;
+  Standard_Real myTol;
+  NCollection_Array1<gp_Pnt>& myPnts;
+  NCollection_Array1<Standard_Integer>& myStatus;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+//function : GEOMAlgo_InnerPointsTable
+//purpose  :
+//=======================================================================
+GEOMAlgo_InnerPointsTable::GEOMAlgo_InnerPointsTable()
+:
+  myTolerance(0.0001),
+  myRunParallel(Standard_False),
+  myIsDone(Standard_False)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_InnerPointsTable::~GEOMAlgo_InnerPointsTable()
+{
+}
+//=======================================================================
+//function : SetShape
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsTable::SetShape(const TopoDS_Shape& theShape)
+{
+  myShape=theShape;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : Shape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_InnerPointsTable::Shape() const
+{
+  return myShape;
+}
+//=======================================================================
+//function : SetTolerance
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsTable::SetTolerance(const Standard_Real theTol)
+{
+  myTolerance=theTol;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : Tolerance
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_InnerPointsTable::Tolerance() const
+{
+  return myTolerance;
+}
+//=======================================================================
+//function : SetRunParallel
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsTable::SetRunParallel(const Standard_Boolean theFlag)
+{
+  myRunParallel=theFlag;
+}
+//=======================================================================
+//function : RunParallel
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_InnerPointsTable::RunParallel() const
+{
+  return myRunParallel;
+}
+//=======================================================================
+//function : IsDone
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_InnerPointsTable::IsDone() const
+{
+  return myIsDone;
+}
+//=======================================================================
+//function : IsValidFor
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_InnerPointsTable::IsValidFor
+  (const TopoDS_Shape& theShape,
+   const Standard_Real theTol) const
+{
+  return myIsDone && myShape.IsSame(theShape) && myTolerance==theTol;
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+void GEOMAlgo_InnerPointsTable::Perform()
+{
+  Standard_Integer i, aNb, aNbE, aNbChunks;
+  TopTools_IndexedMapOfShape aME;
+  //
+  myIsDone=Standard_False;
+  myShapes.Clear();
+  if (myShape.IsNull()) {
+    return;
+  }
+  //
+  // 1. the sub-shapes, in the order of the dimension
+  TopExp::MapShapes(myShape, TopAbs_VERTEX, myShapes);
+  //
+  TopExp::MapShapes(myShape, TopAbs_EDGE, aME);
+  aNbE=aME.Extent();
+  for (i=1; i<=aNbE; ++i) {
+    const TopoDS_Edge& aE=*((TopoDS_Edge*)&aME(i));
+    if (!BRep_Tool::Degenerated(aE)) {
+      myShapes.Add(aE);
+    }
+  }
+  //
+  TopExp::MapShapes(myShape, TopAbs_FACE, myShapes);
+  TopExp::MapShapes(myShape, TopAbs_SOLID, myShapes);
+  //
+  aNb=myShapes.Extent();
+  if (!aNb) {
+    myIsDone=Standard_True;
+    return;
+  }
+  //
+  // 2. the points
+  myPnts.Resize(1, aNb, Standard_False);
+  myStatus.Resize(1, aNb, Standard_False);
+  myStatus.Init(0);
+  //
+  aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, myRunParallel);
+  //
+  GEOMAlgo_InnerPointsTableFunctor aFunctor(myShapes, myTolerance,
+                                            myPnts, myStatus, aNbChunks);
+  OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+  //
+  myIsDone=Standard_True;
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_InnerPointsTable::Extent() const
+{
+  return myShapes.Extent();
+}
+//=======================================================================
+//function : Index
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_InnerPointsTable::Index
+  (const TopoDS_Shape& theS) const
+{
+  return myShapes.FindIndex(theS);
+}
+//=======================================================================
+//function : SubShape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_InnerPointsTable::SubShape
+  (const Standard_Integer theIndex) const
+{
+  return myShapes(theIndex);
+}
+//=======================================================================
+//function : Status
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_InnerPointsTable::Status
+  (const Standard_Integer theIndex) const
+{
+  return myStatus(theIndex);
+}
+//=======================================================================
+//function : Pnt
+//purpose  :
+//=======================================================================
+const gp_Pnt& GEOMAlgo_InnerPointsTable::Pnt
+  (const Standard_Integer theIndex) const
+{
+  return myPnts(theIndex);
+}
+//=======================================================================
+//function : FindPnt
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_InnerPointsTable::FindPnt(const TopoDS_Shape& theS,
+                                                    gp_Pnt& theP) const
+{
+  Standard_Integer i;
+  //
+  if (!myIsDone) {
+    return Standard_False;
+  }
+  i=myShapes.FindIndex(theS);
+  if (!i || myStatus(i)) {
+    return Standard_False;
+  }
+  theP=myPnts(i);
+  return Standard_True;
+}
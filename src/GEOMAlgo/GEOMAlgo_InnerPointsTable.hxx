@@ -0,0 +1,126 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_InnerPointsTable.hxx
+//
+#ifndef _GEOMAlgo_InnerPointsTable_HeaderFile
+#define _GEOMAlgo_InnerPointsTable_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Boolean.hxx>
+#include <gp_Pnt.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <NCollection_Array1.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_InnerPointsTable, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_InnerPointsTable
+//purpose  : The points inside the sub-shapes (vertices, non-degenerated
+//           edges, faces and solids) of the shape [Where] of
+//           GEOMAlgo_GetInPlace, one point per sub-shape.
+//           The points are computed at once, in parallel if required,
+//           and kept in an array aligned with the map of the sub-shapes.
+//           The table is shared by the runs of GetInPlace with the
+//           same shape [Where] and different arguments [What].
+//           It is read only after Perform, so the threads can use it.
+//=======================================================================
+class GEOMAlgo_InnerPointsTable : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_InnerPointsTable();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_InnerPointsTable();
+
+  //! Sets the shape [Where] <br>
+  Standard_EXPORT
+    void SetShape(const TopoDS_Shape& theShape) ;
+
+  Standard_EXPORT
+    const TopoDS_Shape& Shape() const;
+
+  //! Sets the tolerance used to compute the points in solids <br>
+  Standard_EXPORT
+    void SetTolerance(const Standard_Real theTol) ;
+
+  Standard_EXPORT
+    Standard_Real Tolerance() const;
+
+  Standard_EXPORT
+    void SetRunParallel(const Standard_Boolean theFlag) ;
+
+  Standard_EXPORT
+    Standard_Boolean RunParallel() const;
+
+  //! Maps the sub-shapes and computes their points <br>
+  Standard_EXPORT
+    void Perform() ;
+
+  Standard_EXPORT
+    Standard_Boolean IsDone() const;
+
+  //! Returns true if the points are computed for the shape <br>
+  //!          theShape with the tolerance theTol <br>
+  Standard_EXPORT
+    Standard_Boolean IsValidFor(const TopoDS_Shape& theShape,
+                                const Standard_Real theTol) const;
+
+  //! Returns the number of the sub-shapes <br>
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns the index of the sub-shape theS, 0 if it is not mapped <br>
+  Standard_EXPORT
+    Standard_Integer Index(const TopoDS_Shape& theS) const;
+
+  //! Returns the sub-shape theIndex, 1 <= theIndex <= Extent() <br>
+  Standard_EXPORT
+    const TopoDS_Shape& SubShape(const Standard_Integer theIndex) const;
+
+  //! Returns 0 if the point of the sub-shape theIndex is computed <br>
+  Standard_EXPORT
+    Standard_Integer Status(const Standard_Integer theIndex) const;
+
+  //! Returns the point of the sub-shape theIndex <br>
+  Standard_EXPORT
+    const gp_Pnt& Pnt(const Standard_Integer theIndex) const;
+
+  //! Returns true if theS is mapped and its point is computed <br>
+  Standard_EXPORT
+    Standard_Boolean FindPnt(const TopoDS_Shape& theS,
+                             gp_Pnt& theP) const;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_InnerPointsTable, Standard_Transient)
+
+ protected:
+  TopoDS_Shape myShape;
+  Standard_Real myTolerance;
+  Standard_Boolean myRunParallel;
+  Standard_Boolean myIsDone;
+  TopTools_IndexedMapOfShape myShapes;
+  NCollection_Array1<gp_Pnt> myPnts;
+  NCollection_Array1<Standard_Integer> myStatus;
+};
+#endif
@@ -0,0 +1,198 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_PackedPlanes.cxx
+//
+#include <GEOMAlgo_PackedPlanes.hxx>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define GEOMAlgo_PACKEDPLANES_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || \
+  (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GEOMAlgo_PACKEDPLANES_SSE2
+#endif
+
+//=======================================================================
+//function : GEOMAlgo_PackedPlanes
+//purpose  :
+//=======================================================================
+GEOMAlgo_PackedPlanes::GEOMAlgo_PackedPlanes()
+{
+  Clear();
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PackedPlanes::Clear()
+{
+  Standard_Integer j;
+  //
+  myNbPlanes=0;
+  for (j=0; j<NbMaxPlanes; ++j) {
+    myA[j]=0.;
+    myB[j]=0.;
+    myC[j]=0.;
+    myD[j]=0.;
+  }
+}
+//=======================================================================
+//function : Add
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_PackedPlanes::Add(const gp_Pln& thePln)
+{
+  if (myNbPlanes==NbMaxPlanes) {
+    return Standard_False;
+  }
+  // the same coefficients as IntSurf_Quadric::SetValue(gp_Pln) takes
+  thePln.Coefficients(myA[myNbPlanes], myB[myNbPlanes],
+                      myC[myNbPlanes], myD[myNbPlanes]);
+  ++myNbPlanes;
+  return Standard_True;
+}
+//=======================================================================
+//function : Kernel
+//purpose  :
+//=======================================================================
+const char* GEOMAlgo_PackedPlanes::Kernel()
+{
+#if defined(GEOMAlgo_PACKEDPLANES_AVX)
+  return "avx";
+#elif defined(GEOMAlgo_PACKEDPLANES_SSE2)
+  return "sse2";
+#else
+  return "scalar";
+#endif
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PackedPlanes::Perform(const gp_Pnt* thePnts,
+                                    const Standard_Size theNbPnts,
+                                    const Standard_Real theTol,
+                                    Standard_Integer* theMaskIn,
+                                    Standard_Integer* theMaskOut) const
+{
+  Standard_Integer j, aIn, aOut;
+  Standard_Size i;
+  Standard_Real aDp;
+  //
+  i=0;
+#if defined(GEOMAlgo_PACKEDPLANES_AVX)
+  {
+    Standard_Integer k, aMIn, aMOut;
+    __m256d aA[NbMaxPlanes], aB[NbMaxPlanes], aC[NbMaxPlanes], aD[NbMaxPlanes];
+    //
+    const __m256d aTP=_mm256_set1_pd(theTol);
+    const __m256d aTM=_mm256_set1_pd(-theTol);
+    for (j=0; j<myNbPlanes; ++j) {
+      aA[j]=_mm256_set1_pd(myA[j]);
+      aB[j]=_mm256_set1_pd(myB[j]);
+      aC[j]=_mm256_set1_pd(myC[j]);
+      aD[j]=_mm256_set1_pd(myD[j]);
+    }
+    for (; i+4<=theNbPnts; i+=4) {
+      const gp_Pnt* pP=thePnts+i;
+      const __m256d aX=_mm256_set_pd(pP[3].X(), pP[2].X(), pP[1].X(), pP[0].X());
+      const __m256d aY=_mm256_set_pd(pP[3].Y(), pP[2].Y(), pP[1].Y(), pP[0].Y());
+      const __m256d aZ=_mm256_set_pd(pP[3].Z(), pP[2].Z(), pP[1].Z(), pP[0].Z());
+      //
+      for (k=0; k<4; ++k) {
+        theMaskIn[i+k]=0;
+        theMaskOut[i+k]=0;
+      }
+      for (j=0; j<myNbPlanes; ++j) {
+        __m256d aDist;
+        //
+        aDist=_mm256_add_pd(_mm256_mul_pd(aA[j], aX), _mm256_mul_pd(aB[j], aY));
+        aDist=_mm256_add_pd(aDist, _mm256_mul_pd(aC[j], aZ));
+        aDist=_mm256_add_pd(aDist, aD[j]);
+        //
+        aMOut=_mm256_movemask_pd(_mm256_cmp_pd(aDist, aTP, _CMP_GT_OQ));
+        aMIn=_mm256_movemask_pd(_mm256_cmp_pd(aDist, aTM, _CMP_LT_OQ));
+        for (k=0; k<4; ++k) {
+          theMaskOut[i+k]|=((aMOut>>k)&1)<<j;
+          theMaskIn[i+k]|=((aMIn>>k)&1)<<j;
+        }
+      }
+    }
+  }
+#elif defined(GEOMAlgo_PACKEDPLANES_SSE2)
+  {
+    Standard_Integer aMIn, aMOut;
+    __m128d aA[NbMaxPlanes], aB[NbMaxPlanes], aC[NbMaxPlanes], aD[NbMaxPlanes];
+    //
+    const __m128d aTP=_mm_set1_pd(theTol);
+    const __m128d aTM=_mm_set1_pd(-theTol);
+    for (j=0; j<myNbPlanes; ++j) {
+      aA[j]=_mm_set1_pd(myA[j]);
+      aB[j]=_mm_set1_pd(myB[j]);
+      aC[j]=_mm_set1_pd(myC[j]);
+      aD[j]=_mm_set1_pd(myD[j]);
+    }
+    for (; i+2<=theNbPnts; i+=2) {
+      const gp_Pnt* pP=thePnts+i;
+      const __m128d aX=_mm_set_pd(pP[1].X(), pP[0].X());
+      const __m128d aY=_mm_set_pd(pP[1].Y(), pP[0].Y());
+      const __m128d aZ=_mm_set_pd(pP[1].Z(), pP[0].Z());
+      //
+      theMaskIn[i]=0;
+      theMaskOut[i]=0;
+      theMaskIn[i+1]=0;
+      theMaskOut[i+1]=0;
+      for (j=0; j<myNbPlanes; ++j) {
+        __m128d aDist;
+        //
+        aDist=_mm_add_pd(_mm_mul_pd(aA[j], aX), _mm_mul_pd(aB[j], aY));
+        aDist=_mm_add_pd(aDist, _mm_mul_pd(aC[j], aZ));
+        aDist=_mm_add_pd(aDist, aD[j]);
+        //
+        aMOut=_mm_movemask_pd(_mm_cmpgt_pd(aDist, aTP));
+        aMIn=_mm_movemask_pd(_mm_cmplt_pd(aDist, aTM));
+        theMaskOut[i]|=(aMOut&1)<<j;
+        theMaskOut[i+1]|=((aMOut>>1)&1)<<j;
+        theMaskIn[i]|=(aMIn&1)<<j;
+        theMaskIn[i+1]|=((aMIn>>1)&1)<<j;
+      }
+    }
+  }
+#endif
+  //
+  // the rest of the points
+  for (; i<theNbPnts; ++i) {
+    const gp_Pnt& aP=thePnts[i];
+    //
+    aIn=0;
+    aOut=0;
+    for (j=0; j<myNbPlanes; ++j) {
+      aDp=myA[j]*aP.X() + myB[j]*aP.Y() + myC[j]*aP.Z() + myD[j];
+      if (aDp > theTol) {
+        aOut|=1<<j;
+      }
+      else if (aDp < -theTol) {
+        aIn|=1<<j;
+      }
+    }
+    theMaskIn[i]=aIn;
+    theMaskOut[i]=aOut;
+  }
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_PackedPlanes.hxx
+//
+#ifndef _GEOMAlgo_PackedPlanes_HeaderFile
+#define _GEOMAlgo_PackedPlanes_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Size.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Pln.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_PackedPlanes
+//purpose  : Coefficients A, B, C, D of up to NbMaxPlanes planes
+//           stored by components for the signed distance tests
+//           A*X+B*Y+C*Z+D of many points at once.
+//           The points are processed by AVX (4 points) or SSE2
+//           (2 points) registers when the compiler targets them,
+//           the rest by the scalar code. The distances are computed
+//           in the same order of operations as IntSurf_Quadric does,
+//           so the states are the same as GEOMAlgo_SurfaceTools::GetState()
+//           gives for the planes.
+//=======================================================================
+class GEOMAlgo_PackedPlanes
+{
+ public:
+  enum { NbMaxPlanes = 8 };
+
+  Standard_EXPORT
+    GEOMAlgo_PackedPlanes();
+
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Appends the plane thePln. <br>
+  //!          Returns False if there are NbMaxPlanes planes already <br>
+  Standard_EXPORT
+    Standard_Boolean Add(const gp_Pln& thePln) ;
+
+  Standard_Integer NbPlanes() const {
+    return myNbPlanes;
+  }
+
+  //! For each point thePnts[i], i=0..theNbPnts-1, sets the bit j <br>
+  //!          of theMaskIn[i] if the signed distance to the plane j <br>
+  //!          is less than -theTol and the bit j of theMaskOut[i] <br>
+  //!          if it is greater than theTol. <br>
+  Standard_EXPORT
+    void Perform(const gp_Pnt* thePnts,
+                 const Standard_Size theNbPnts,
+                 const Standard_Real theTol,
+                 Standard_Integer* theMaskIn,
+                 Standard_Integer* theMaskOut) const;
+
+  //! Returns the name of the kernel used: "avx", "sse2" or "scalar" <br>
+  Standard_EXPORT
+    static const char* Kernel() ;
+
+ protected:
+  Standard_Integer myNbPlanes;
+  Standard_Real myA[NbMaxPlanes];
+  Standard_Real myB[NbMaxPlanes];
+  Standard_Real myC[NbMaxPlanes];
+  Standard_Real myD[NbMaxPlanes];
+};
+#endif
@@ -27,18 +27,19 @@
 //
 #include <GEOMAlgo_PassKey.hxx>
 
-#include <stdio.h>
 #include <string.h>
+#include <algorithm>
+
 #include <TColStd_ListIteratorOfListOfInteger.hxx>
 #include <TColStd_ListOfInteger.hxx>
-
-#ifdef WIN32
-#pragma warning( disable : 4101)
-#endif
+#include <NCollection_Array1.hxx>
 
 static
-  Standard_Integer NormalizedId(const Standard_Integer aId,
-                                const Standard_Integer aDiv);
+  Standard_Integer SortUnique(Standard_Integer* pIds,
+                              const Standard_Integer aNbIds);
+static
+  Standard_Integer MixedHash(const Standard_Integer* pIds,
+                             const Standard_Integer aNbIds);
 
 //=======================================================================
 //function :
@@ -54,9 +55,7 @@ static
 //=======================================================================
   GEOMAlgo_PassKey::GEOMAlgo_PassKey(const GEOMAlgo_PassKey& aOther)
 {
-  myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  Assign(aOther);
 }
 //=======================================================================
 //function :Assign
@@ -65,8 +64,10 @@ static
   GEOMAlgo_PassKey& GEOMAlgo_PassKey::Assign(const GEOMAlgo_PassKey& aOther)
 {
   myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  myHash=aOther.myHash;
+  memcpy(myIds, aOther.myIds, sizeof(myIds));
+  // the array is never modified after SetIds(), it can be shared
+  myExtIds=aOther.myExtIds;
   return *this;
 }
 //=======================================================================
@@ -83,8 +84,9 @@ static
   void GEOMAlgo_PassKey::Clear()
 {
   myNbIds=0;
-  mySum=0;
-  myMap.Clear();
+  myHash=0;
+  memset(myIds, 0, sizeof(myIds));
+  myExtIds.Nullify();
 }
 //=======================================================================
 //function :SetIds
@@ -93,10 +95,7 @@ static
   void GEOMAlgo_PassKey::SetIds(const Standard_Integer aId1)
 
 {
-  Clear();
-  myNbIds=1;
-  myMap.Add(aId1);
-  mySum=NormalizedId(aId1, myNbIds);
+  SetSortedIds(&aId1, 1);
 }
 //=======================================================================
 //function :SetIds
@@ -105,11 +104,11 @@ static
   void GEOMAlgo_PassKey::SetIds(const Standard_Integer aId1,
                                 const Standard_Integer aId2)
 {
-  TColStd_ListOfInteger aLI;
+  Standard_Integer aIds[2];
   //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  SetIds(aLI);
+  aIds[0]=aId1;
+  aIds[1]=aId2;
+  SetSortedIds(aIds, SortUnique(aIds, 2));
 }
 //=======================================================================
 //function :SetIds
@@ -119,12 +118,12 @@ static
                                 const Standard_Integer aId2,
                                 const Standard_Integer aId3)
 {
-  TColStd_ListOfInteger aLI;
+  Standard_Integer aIds[3];
   //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  aLI.Append(aId3);
-  SetIds(aLI);
+  aIds[0]=aId1;
+  aIds[1]=aId2;
+  aIds[2]=aId3;
+  SetSortedIds(aIds, SortUnique(aIds, 3));
 }
 //=======================================================================
 //function :SetIds
@@ -135,13 +134,13 @@ static
                                 const Standard_Integer aId3,
                                 const Standard_Integer aId4)
 {
-  TColStd_ListOfInteger aLI;
+  Standard_Integer aIds[4];
   //
-  aLI.Append(aId1);
-  aLI.Append(aId2);
-  aLI.Append(aId3);
-  aLI.Append(aId4);
-  SetIds(aLI);
+  aIds[0]=aId1;
+  aIds[1]=aId2;
+  aIds[2]=aId3;
+  aIds[3]=aId4;
+  SetSortedIds(aIds, SortUnique(aIds, 4));
 }
 //=======================================================================
 //function :SetIds
@@ -149,21 +148,44 @@ static
 //=======================================================================
   void GEOMAlgo_PassKey::SetIds(const TColStd_ListOfInteger& aLI)
 {
-  Standard_Integer i, aId, aIdN;
+  Standard_Integer i, aNb;
   TColStd_ListIteratorOfListOfInteger aIt;
   //
-  Clear();
+  aNb=aLI.Extent();
+  if (!aNb) {
+    Clear();
+    return;
+  }
+  //
+  NCollection_Array1<Standard_Integer> aIds(0, aNb-1);
+  //
   aIt.Initialize(aLI);
-  for (; aIt.More(); aIt.Next()) {
-    aId=aIt.Value();
-    myMap.Add(aId);
+  for (i=0; aIt.More(); aIt.Next(), ++i) {
+    aIds(i)=aIt.Value();
+  }
+  SetSortedIds(&aIds(0), SortUnique(&aIds(0), aNb));
+}
+//=======================================================================
+//function :SetSortedIds
+//purpose  : pIds are sorted and unique
+//=======================================================================
+  void GEOMAlgo_PassKey::SetSortedIds(const Standard_Integer* pIds,
+                                      const Standard_Integer aNbIds)
+{
+  Standard_Integer i;
+  //
+  Clear();
+  myNbIds=aNbIds;
+  if (myNbIds>NbInlineIds) {
+    myExtIds=new TColStd_HArray1OfInteger(1, myNbIds);
+    for (i=0; i<myNbIds; ++i) {
+      myExtIds->SetValue(i+1, pIds[i]);
+    }
   }
-  myNbIds=myMap.Extent();
-  for(i=1; i<=myNbIds; ++i) {
-    aId=myMap(i);
-    aIdN=NormalizedId(aId, myNbIds);
-    mySum+=aIdN;
+  else {
+    memcpy(myIds, pIds, myNbIds*sizeof(Standard_Integer));
   }
+  myHash=MixedHash(pIds, myNbIds);
 }
 //=======================================================================
 //function :NbIds
@@ -175,14 +197,14 @@ static
 }
 //=======================================================================
 //function :Id
-//purpose  :
+//purpose  : the ids are returned in the ascending order
 //=======================================================================
   Standard_Integer GEOMAlgo_PassKey::Id(const Standard_Integer aIndex) const
 {
   if (aIndex<1 || aIndex>myNbIds) {
     return -1;
   }
-  return myMap(aIndex);
+  return Ids()[aIndex-1];
 }
 //=======================================================================
 //function :IsEqual
@@ -190,21 +212,10 @@ static
 //=======================================================================
   Standard_Boolean GEOMAlgo_PassKey::IsEqual(const GEOMAlgo_PassKey& aOther) const
 {
-  Standard_Boolean bRet;
-  Standard_Integer i, aId;
-  //
-  bRet=Standard_False;
-  //
-  if (myNbIds!=aOther.myNbIds) {
-    return bRet;
-  }
-  for (i=1; i<=myNbIds; ++i) {
-    aId=myMap(i);
-    if (!aOther.myMap.Contains(aId)) {
-      return bRet;
-    }
+  if (myNbIds!=aOther.myNbIds || myHash!=aOther.myHash) {
+    return Standard_False;
   }
-  return !bRet;
+  return !memcmp(Ids(), aOther.Ids(), myNbIds*sizeof(Standard_Integer));
 }
 //=======================================================================
 //function : HashCode
@@ -212,7 +223,7 @@ static
 //=======================================================================
   Standard_Integer GEOMAlgo_PassKey::HashCode(const Standard_Integer aUpper) const
 {
-  return ::HashCode(mySum, aUpper);
+  return ::HashCode(myHash, aUpper);
 }
 //=======================================================================
 //function : Dump
@@ -222,19 +233,48 @@ static
 {
 }
 //=======================================================================
-// function: NormalizedId
-// purpose :
+// function: SortUnique
+// purpose : sorts pIds in the ascending order, removes the duplicates
+//           and returns the number of the ids left
+//=======================================================================
+Standard_Integer SortUnique(Standard_Integer* pIds,
+                            const Standard_Integer aNbIds)
+{
+  Standard_Integer i, j, aId;
+  //
+  if (aNbIds>GEOMAlgo_PassKey::NbInlineIds) {
+    std::sort(pIds, pIds+aNbIds);
+  }
+  else {
+    for (i=1; i<aNbIds; ++i) {
+      aId=pIds[i];
+      for (j=i; j>0 && pIds[j-1]>aId; --j) {
+        pIds[j]=pIds[j-1];
+      }
+      pIds[j]=aId;
+    }
+  }
+  return (Standard_Integer)(std::unique(pIds, pIds+aNbIds)-pIds);
+}
+//=======================================================================
+// function: MixedHash
+// purpose : order dependent hash of the sorted ids,
+//           each step is the finalizer of MurmurHash3
 //=======================================================================
-Standard_Integer NormalizedId(const Standard_Integer aId,
-                              const Standard_Integer aDiv)
+Standard_Integer MixedHash(const Standard_Integer* pIds,
+                           const Standard_Integer aNbIds)
 {
-  Standard_Integer aMax, aTresh, aIdRet;
+  Standard_Integer i;
+  unsigned int aH;
   //
-  aIdRet=aId;
-  aMax=::IntegerLast();
-  aTresh=aMax/aDiv;
-  if (aId>aTresh) {
-    aIdRet=aId%aTresh;
+  aH=(unsigned int)aNbIds;
+  for (i=0; i<aNbIds; ++i) {
+    aH^=(unsigned int)pIds[i];
+    aH^=aH>>16;
+    aH*=0x85ebca6bU;
+    aH^=aH>>13;
+    aH*=0xc2b2ae35U;
+    aH^=aH>>16;
   }
-  return aIdRet;
+  return (Standard_Integer)(aH & 0x7fffffff);
 }
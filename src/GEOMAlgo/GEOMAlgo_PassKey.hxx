@@ -34,11 +34,15 @@
 #include <Standard_Boolean.hxx>
 
 #include <TColStd_ListOfInteger.hxx>
-#include <TColStd_IndexedMapOfInteger.hxx>
+#include <TColStd_HArray1OfInteger.hxx>
 
 //=======================================================================
 //class : GEOMAlgo_PassKey
-//purpose  :
+//purpose  : unordered set of integer ids.
+//           The ids are kept sorted (ascending) without duplicates.
+//           Up to NbInlineIds ids are stored in the key itself,
+//           a larger set is stored in the shared read-only array.
+//           The hash code is computed once in SetIds().
 //=======================================================================
 class GEOMAlgo_PassKey  {
  public:
@@ -97,9 +101,21 @@ class GEOMAlgo_PassKey  {
   Standard_EXPORT
     void Dump(const Standard_Integer aHex = 0) const;
 
+  enum { NbInlineIds = 4 };
+
+ protected:
+  Standard_EXPORT
+    void SetSortedIds(const Standard_Integer* pIds,
+                      const Standard_Integer aNbIds) ;
+
+  const Standard_Integer* Ids() const {
+    return (myNbIds>NbInlineIds) ? &myExtIds->Value(1) : myIds;
+  }
+
  protected:
   Standard_Integer myNbIds;
-  Standard_Integer mySum;
-  TColStd_IndexedMapOfInteger myMap;
+  Standard_Integer myHash;
+  Standard_Integer myIds[NbInlineIds];
+  Handle(TColStd_HArray1OfInteger) myExtIds;
 };
 #endif
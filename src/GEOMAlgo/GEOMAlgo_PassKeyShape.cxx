@@ -27,20 +27,58 @@
 //
 #include <GEOMAlgo_PassKeyShape.hxx>
 
+#include <algorithm>
+
+#include <TopoDS_TShape.hxx>
+#include <TopLoc_Location.hxx>
 #include <TopTools_ListOfShape.hxx>
 #include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <NCollection_Array1.hxx>
 
+//=======================================================================
+//class    : GEOMAlgo_PassKeyShapeItem
+//purpose  : the shape with its sorting key
+//=======================================================================
+struct GEOMAlgo_PassKeyShapeItem {
+  void Init(const TopoDS_Shape& aS) {
+    myS=&aS;
+    myTS=(Standard_Size)aS.TShape().operator->();
+    myLoc=aS.Location().HashCode(::IntegerLast());
+  }
+  //
+  Standard_Boolean IsTie(const GEOMAlgo_PassKeyShapeItem& aOther) const {
+    return myTS==aOther.myTS && myLoc==aOther.myLoc;
+  }
+  //
+  bool operator<(const GEOMAlgo_PassKeyShapeItem& aOther) const {
+    return myTS<aOther.myTS || (myTS==aOther.myTS && myLoc<aOther.myLoc);
+  }
+  //
+  const TopoDS_Shape* myS;
+  Standard_Size myTS;
+  Standard_Integer myLoc;
+};
 
 static
-  Standard_Integer NormalizedId(const Standard_Integer aId,
-                                const Standard_Integer aDiv);
+  Standard_Integer SortUnique(GEOMAlgo_PassKeyShapeItem* pItems,
+                              const Standard_Integer aNbItems,
+                              const TopoDS_Shape** ppS);
+static
+  Standard_Integer MixedHash(const TopoDS_Shape* pS,
+                             const Standard_Integer aNbS);
+static
+  Standard_Boolean IsEqualTies(const TopoDS_Shape* pS1,
+                               const TopoDS_Shape* pS2,
+                               const Standard_Integer aNbS);
+
 //=======================================================================
 //function :
 //purpose  :
 //=======================================================================
   GEOMAlgo_PassKeyShape::GEOMAlgo_PassKeyShape()
 {
-  myUpper=432123;
+  myNbIds=0;
+  myHash=0;
 }
 //=======================================================================
 //function :
@@ -48,10 +86,7 @@ static
 //=======================================================================
   GEOMAlgo_PassKeyShape::GEOMAlgo_PassKeyShape(const GEOMAlgo_PassKeyShape& aOther)
 {
-  myUpper=432123;
-  myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  Assign(aOther);
 }
 //=======================================================================
 //function :~
@@ -66,10 +101,15 @@ static
 //=======================================================================
   GEOMAlgo_PassKeyShape& GEOMAlgo_PassKeyShape::Assign(const GEOMAlgo_PassKeyShape& aOther)
 {
-  myUpper=432123;
+  Standard_Integer i;
+  //
   myNbIds=aOther.myNbIds;
-  mySum=aOther.mySum;
-  myMap=aOther.myMap;
+  myHash=aOther.myHash;
+  for (i=0; i<NbInlineShapes; ++i) {
+    myShapes[i]=aOther.myShapes[i];
+  }
+  // the array is never modified after SetShapes(), it can be shared
+  myExtShapes=aOther.myExtShapes;
   return *this;
 }
 //=======================================================================
@@ -78,9 +118,14 @@ static
 //=======================================================================
   void GEOMAlgo_PassKeyShape::Clear()
 {
+  Standard_Integer i;
+  //
   myNbIds=0;
-  mySum=0;
-  myMap.Clear();
+  myHash=0;
+  for (i=0; i<NbInlineShapes; ++i) {
+    myShapes[i].Nullify();
+  }
+  myExtShapes.Nullify();
 }
 //=======================================================================
 //function :SetShapes
@@ -89,13 +134,9 @@ static
   void GEOMAlgo_PassKeyShape::SetShapes(const TopoDS_Shape& aS1)
 
 {
-  Standard_Integer aHC;
+  const TopoDS_Shape* pS=&aS1;
   //
-  Clear();
-  myNbIds=1;
-  myMap.Add(aS1);
-  aHC=aS1.HashCode(myUpper);
-  mySum=NormalizedId(aHC, myNbIds);
+  SetSortedShapes(&pS, 1);
 }
 //=======================================================================
 //function :SetShapes
@@ -104,11 +145,12 @@ static
   void GEOMAlgo_PassKeyShape::SetShapes(const TopoDS_Shape& aS1,
                                         const TopoDS_Shape& aS2)
 {
-  TopTools_ListOfShape aLS;
+  GEOMAlgo_PassKeyShapeItem aItems[2];
+  const TopoDS_Shape* pS[2];
   //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  SetShapes(aLS);
+  aItems[0].Init(aS1);
+  aItems[1].Init(aS2);
+  SetSortedShapes(pS, SortUnique(aItems, 2, pS));
 }
 //=======================================================================
 //function :SetShapes
@@ -118,12 +160,13 @@ static
                                         const TopoDS_Shape& aS2,
                                         const TopoDS_Shape& aS3)
 {
-  TopTools_ListOfShape aLS;
+  GEOMAlgo_PassKeyShapeItem aItems[3];
+  const TopoDS_Shape* pS[3];
   //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  aLS.Append(aS3);
-  SetShapes(aLS);
+  aItems[0].Init(aS1);
+  aItems[1].Init(aS2);
+  aItems[2].Init(aS3);
+  SetSortedShapes(pS, SortUnique(aItems, 3, pS));
 }
 //=======================================================================
 //function :SetShapes
@@ -134,13 +177,14 @@ static
                                         const TopoDS_Shape& aS3,
                                         const TopoDS_Shape& aS4)
 {
-  TopTools_ListOfShape aLS;
+  GEOMAlgo_PassKeyShapeItem aItems[4];
+  const TopoDS_Shape* pS[4];
   //
-  aLS.Append(aS1);
-  aLS.Append(aS2);
-  aLS.Append(aS3);
-  aLS.Append(aS4);
-  SetShapes(aLS);
+  aItems[0].Init(aS1);
+  aItems[1].Init(aS2);
+  aItems[2].Init(aS3);
+  aItems[3].Init(aS4);
+  SetSortedShapes(pS, SortUnique(aItems, 4, pS));
 }
 //=======================================================================
 //function :SetShapes
@@ -148,22 +192,47 @@ static
 //=======================================================================
   void GEOMAlgo_PassKeyShape::SetShapes(const TopTools_ListOfShape& aLS)
 {
-  Standard_Integer i, aId, aIdN;
+  Standard_Integer i, aNb;
   TopTools_ListIteratorOfListOfShape aIt;
   //
-  Clear();
+  aNb=aLS.Extent();
+  if (!aNb) {
+    Clear();
+    return;
+  }
+  //
+  NCollection_Array1<GEOMAlgo_PassKeyShapeItem> aItems(0, aNb-1);
+  NCollection_Array1<const TopoDS_Shape*> aPS(0, aNb-1);
+  //
   aIt.Initialize(aLS);
-  for (; aIt.More(); aIt.Next()) {
-    const TopoDS_Shape& aS=aIt.Value();
-    myMap.Add(aS);
+  for (i=0; aIt.More(); aIt.Next(), ++i) {
+    aItems(i).Init(aIt.Value());
+  }
+  SetSortedShapes(&aPS(0), SortUnique(&aItems(0), aNb, &aPS(0)));
+}
+//=======================================================================
+//function :SetSortedShapes
+//purpose  : ppS are sorted and unique
+//=======================================================================
+  void GEOMAlgo_PassKeyShape::SetSortedShapes(const TopoDS_Shape* const* ppS,
+                                              const Standard_Integer aNbS)
+{
+  Standard_Integer i;
+  //
+  Clear();
+  myNbIds=aNbS;
+  if (myNbIds>NbInlineShapes) {
+    myExtShapes=new TopTools_HArray1OfShape(1, myNbIds);
+    for (i=0; i<myNbIds; ++i) {
+      myExtShapes->SetValue(i+1, *ppS[i]);
+    }
   }
-  myNbIds=myMap.Extent();
-  for(i=1; i<=myNbIds; ++i) {
-    const TopoDS_Shape& aS=myMap(i);
-    aId=aS.HashCode(myUpper);
-    aIdN=NormalizedId(aId, myNbIds);
-    mySum+=aIdN;
+  else {
+    for (i=0; i<myNbIds; ++i) {
+      myShapes[i]=*ppS[i];
+    }
   }
+  myHash=MixedHash(Shapes(), myNbIds);
 }
 //=======================================================================
 //function :NbIds
@@ -179,21 +248,28 @@ static
 //=======================================================================
   Standard_Boolean GEOMAlgo_PassKeyShape::IsEqual(const GEOMAlgo_PassKeyShape& aOther) const
 {
-  Standard_Boolean bRet;
   Standard_Integer i;
+  const TopoDS_Shape *pS1, *pS2;
   //
-  bRet=Standard_False;
+  if (myNbIds!=aOther.myNbIds || myHash!=aOther.myHash) {
+    return Standard_False;
+  }
   //
-  if (myNbIds!=aOther.myNbIds) {
-    return bRet;
+  pS1=Shapes();
+  pS2=aOther.Shapes();
+  for (i=0; i<myNbIds; ++i) {
+    if (pS1[i].TShape()!=pS2[i].TShape()) {
+      return Standard_False;
+    }
   }
-  for (i=1; i<=myNbIds; ++i) {
-    const TopoDS_Shape& aS=myMap(i);
-    if (!aOther.myMap.Contains(aS)) {
-      return bRet;
+  for (i=0; i<myNbIds; ++i) {
+    if (!pS1[i].Location().IsEqual(pS2[i].Location())) {
+      // the same TShape with different locations of the same hash
+      // code may be sorted in any order
+      return IsEqualTies(pS1, pS2, myNbIds);
     }
   }
-  return !bRet;
+  return Standard_True;
 }
 //=======================================================================
 //function : HashCode
@@ -201,7 +277,7 @@ static
 //=======================================================================
   Standard_Integer GEOMAlgo_PassKeyShape::HashCode(const Standard_Integer aUpper) const
 {
-  return ::HashCode(mySum, aUpper);
+  return ::HashCode(myHash, aUpper);
 }
 //=======================================================================
 //function : Dump
@@ -211,19 +287,85 @@ static
 {
 }
 //=======================================================================
-// function: NormalizedId
-// purpose :
+// function: SortUnique
+// purpose : sorts pItems, removes the duplicates (IsSame) and
+//           puts the shapes left to ppS; returns their number
+//=======================================================================
+Standard_Integer SortUnique(GEOMAlgo_PassKeyShapeItem* pItems,
+                            const Standard_Integer aNbItems,
+                            const TopoDS_Shape** ppS)
+{
+  Standard_Boolean bFound;
+  Standard_Integer i, j, aNb, aTie;
+  //
+  std::sort(pItems, pItems+aNbItems);
+  //
+  aNb=0;
+  aTie=0;
+  for (i=0; i<aNbItems; ++i) {
+    const GEOMAlgo_PassKeyShapeItem& aItem=pItems[i];
+    if (!i || !aItem.IsTie(pItems[aTie])) {
+      aTie=i;
+    }
+    // the duplicates are in the same run of ties
+    bFound=Standard_False;
+    for (j=aTie; j<i && !bFound; ++j) {
+      bFound=aItem.myS->IsSame(*pItems[j].myS);
+    }
+    if (!bFound) {
+      ppS[aNb++]=aItem.myS;
+    }
+  }
+  return aNb;
+}
+//=======================================================================
+// function: MixedHash
+// purpose : order dependent hash of the sorted shapes,
+//           each step is the finalizer of MurmurHash3
+//=======================================================================
+Standard_Integer MixedHash(const TopoDS_Shape* pS,
+                           const Standard_Integer aNbS)
+{
+  Standard_Integer i, j;
+  unsigned int aH, aV[3];
+  Standard_Size aTS;
+  //
+  aH=(unsigned int)aNbS;
+  for (i=0; i<aNbS; ++i) {
+    aTS=(Standard_Size)pS[i].TShape().operator->();
+    aV[0]=(unsigned int)aTS;
+    aV[1]=(unsigned int)((aTS>>16)>>16);
+    aV[2]=(unsigned int)pS[i].Location().HashCode(::IntegerLast());
+    for (j=0; j<3; ++j) {
+      aH^=aV[j];
+      aH^=aH>>16;
+      aH*=0x85ebca6bU;
+      aH^=aH>>13;
+      aH*=0xc2b2ae35U;
+      aH^=aH>>16;
+    }
+  }
+  return (Standard_Integer)(aH & 0x7fffffff);
+}
+//=======================================================================
+// function: IsEqualTies
+// purpose : compares the sets of the same TShapes by IsSame()
 //=======================================================================
-Standard_Integer NormalizedId(const Standard_Integer aId,
-                              const Standard_Integer aDiv)
+Standard_Boolean IsEqualTies(const TopoDS_Shape* pS1,
+                             const TopoDS_Shape* pS2,
+                             const Standard_Integer aNbS)
 {
-  Standard_Integer aMax, aTresh, aIdRet;
+  Standard_Boolean bFound;
+  Standard_Integer i, j;
   //
-  aIdRet=aId;
-  aMax=::IntegerLast();
-  aTresh=aMax/aDiv;
-  if (aId>aTresh) {
-    aIdRet=aId%aTresh;
+  for (i=0; i<aNbS; ++i) {
+    bFound=Standard_False;
+    for (j=0; j<aNbS && !bFound; ++j) {
+      bFound=pS1[i].IsSame(pS2[j]);
+    }
+    if (!bFound) {
+      return Standard_False;
+    }
   }
-  return aIdRet;
+  return Standard_True;
 }
@@ -32,15 +32,20 @@
 #include <Standard.hxx>
 #include <Standard_Macro.hxx>
 #include <Standard_Integer.hxx>
-#include <TopTools_IndexedMapOfShape.hxx>
 #include <Standard_Boolean.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopTools_ListOfShape.hxx>
+#include <TopTools_HArray1OfShape.hxx>
 
 
 //=======================================================================
 //class    : GEOMAlgo_PassKeyShape
-//purpose  :
+//purpose  : unordered set of shapes compared by IsSame().
+//           The shapes are kept sorted by the address of TShape
+//           (then by the hash code of Location) without duplicates.
+//           Up to NbInlineShapes shapes are stored in the key itself,
+//           a larger set is stored in the shared read-only array.
+//           The hash code is computed once in SetShapes().
 //=======================================================================
 class GEOMAlgo_PassKeyShape  {
  public:
@@ -96,10 +101,21 @@ class GEOMAlgo_PassKeyShape  {
   Standard_EXPORT
     void Dump(const Standard_Integer aHex = 0) const;
 
+  enum { NbInlineShapes = 4 };
+
+protected:
+  Standard_EXPORT
+    void SetSortedShapes(const TopoDS_Shape* const* ppS,
+                         const Standard_Integer aNbS) ;
+
+  const TopoDS_Shape* Shapes() const {
+    return (myNbIds>NbInlineShapes) ? &myExtShapes->Value(1) : myShapes;
+  }
+
 protected:
   Standard_Integer myNbIds;
-  Standard_Integer mySum;
-  Standard_Integer myUpper;
-  TopTools_IndexedMapOfShape myMap;
+  Standard_Integer myHash;
+  TopoDS_Shape myShapes[NbInlineShapes];
+  Handle(TopTools_HArray1OfShape) myExtShapes;
 };
 #endif
@@ -0,0 +1,125 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_PhaseInfo.cxx
+//
+#include <GEOMAlgo_PhaseInfo.hxx>
+
+//=======================================================================
+//function : GEOMAlgo_PhaseInfo
+//purpose  :
+//=======================================================================
+GEOMAlgo_PhaseInfo::GEOMAlgo_PhaseInfo()
+:
+  myTime(0.),
+  myNbShapes(0),
+  myNbTreeQueries(0),
+  myNbClsfCalls(0)
+{}
+//=======================================================================
+//function : GEOMAlgo_PhaseInfo
+//purpose  :
+//=======================================================================
+GEOMAlgo_PhaseInfo::GEOMAlgo_PhaseInfo(const Standard_CString theName)
+:
+  myName(theName),
+  myTime(0.),
+  myNbShapes(0),
+  myNbTreeQueries(0),
+  myNbClsfCalls(0)
+{}
+//=======================================================================
+//function : SetName
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PhaseInfo::SetName(const Standard_CString theName)
+{
+  myName=theName;
+}
+//=======================================================================
+//function : Name
+//purpose  :
+//=======================================================================
+const TCollection_AsciiString& GEOMAlgo_PhaseInfo::Name()const
+{
+  return myName;
+}
+//=======================================================================
+//function : SetTime
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PhaseInfo::SetTime(const Standard_Real theTime)
+{
+  myTime=theTime;
+}
+//=======================================================================
+//function : Time
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_PhaseInfo::Time()const
+{
+  return myTime;
+}
+//=======================================================================
+//function : AddShapes
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PhaseInfo::AddShapes(const Standard_Size theNb)
+{
+  myNbShapes+=theNb;
+}
+//=======================================================================
+//function : NbShapes
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_PhaseInfo::NbShapes()const
+{
+  return myNbShapes;
+}
+//=======================================================================
+//function : AddTreeQueries
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PhaseInfo::AddTreeQueries(const Standard_Size theNb)
+{
+  myNbTreeQueries+=theNb;
+}
+//=======================================================================
+//function : NbTreeQueries
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_PhaseInfo::NbTreeQueries()const
+{
+  return myNbTreeQueries;
+}
+//=======================================================================
+//function : AddClsfCalls
+//purpose  :
+//=======================================================================
+void GEOMAlgo_PhaseInfo::AddClsfCalls(const Standard_Size theNb)
+{
+  myNbClsfCalls+=theNb;
+}
+//=======================================================================
+//function : NbClsfCalls
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_PhaseInfo::NbClsfCalls()const
+{
+  return myNbClsfCalls;
+}
@@ -0,0 +1,87 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_PhaseInfo.hxx
+//
+#ifndef _GEOMAlgo_PhaseInfo_HeaderFile
+#define _GEOMAlgo_PhaseInfo_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Size.hxx>
+#include <TCollection_AsciiString.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_PhaseInfo
+//purpose  : Timing and counters of one phase of an algorithm
+//           (see GEOMAlgo_Algo::SetTimingEnabled())
+//=======================================================================
+class GEOMAlgo_PhaseInfo
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_PhaseInfo();
+
+  Standard_EXPORT
+    GEOMAlgo_PhaseInfo(const Standard_CString theName);
+
+  Standard_EXPORT
+    void SetName(const Standard_CString theName) ;
+
+  //! Returns the name of the phase
+  Standard_EXPORT
+    const TCollection_AsciiString& Name() const;
+
+  Standard_EXPORT
+    void SetTime(const Standard_Real theTime) ;
+
+  //! Returns the elapsed (wall clock) time of the phase, seconds
+  Standard_EXPORT
+    Standard_Real Time() const;
+
+  Standard_EXPORT
+    void AddShapes(const Standard_Size theNb) ;
+
+  //! Returns the number of shapes processed by the phase
+  Standard_EXPORT
+    Standard_Size NbShapes() const;
+
+  Standard_EXPORT
+    void AddTreeQueries(const Standard_Size theNb) ;
+
+  //! Returns the number of queries to the bounding trees
+  Standard_EXPORT
+    Standard_Size NbTreeQueries() const;
+
+  Standard_EXPORT
+    void AddClsfCalls(const Standard_Size theNb) ;
+
+  //! Returns the number of calls of the classifiers
+  Standard_EXPORT
+    Standard_Size NbClsfCalls() const;
+
+protected:
+  TCollection_AsciiString myName;
+  Standard_Real myTime;
+  Standard_Size myNbShapes;
+  Standard_Size myNbTreeQueries;
+  Standard_Size myNbClsfCalls;
+};
+#endif
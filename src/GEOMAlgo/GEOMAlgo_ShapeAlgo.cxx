@@ -63,6 +63,20 @@ const Handle(IntTools_Context)& GEOMAlgo_ShapeAlgo::Context()const
   return myContext;
 }
 //=======================================================================
+//function : ContextPool
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_ContextPool)& GEOMAlgo_ShapeAlgo::ContextPool()
+{
+  if (myContext.IsNull()) {
+    myContext=new IntTools_Context;
+  }
+  if (myContextPool.IsNull() || myContextPool->MainContext()!=myContext) {
+    myContextPool=new GEOMAlgo_ContextPool(myContext);
+  }
+  return myContextPool;
+}
+//=======================================================================
 //function : SetShape
 //purpose  :
 //=======================================================================
@@ -28,6 +28,7 @@
 #include <TopoDS_Shape.hxx>
 #include <Standard_Real.hxx>
 #include <IntTools_Context.hxx>
+#include <GEOMAlgo_ContextPool.hxx>
 #include <GEOMAlgo_Algo.hxx>
 
 //=======================================================================
@@ -46,6 +47,11 @@ public:
   Standard_EXPORT
     const Handle(IntTools_Context)& Context() const;
 
+  //! Returns the contexts for the parallel workers, <br>
+  //!          the slot 0 of the pool is Context() <br>
+  Standard_EXPORT
+    const Handle(GEOMAlgo_ContextPool)& ContextPool() ;
+
   Standard_EXPORT
     void SetShape(const TopoDS_Shape& aS) ;
 
@@ -75,6 +81,7 @@ protected:
   Standard_Real myTolerance;
   TopoDS_Shape myResult;
   Handle(IntTools_Context) myContext;
+  Handle(GEOMAlgo_ContextPool) myContextPool;
 };
 
 #endif
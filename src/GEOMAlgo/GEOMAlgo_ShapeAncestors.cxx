@@ -0,0 +1,215 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_ShapeAncestors.cxx
+//
+#include <GEOMAlgo_ShapeAncestors.hxx>
+
+#include <TopoDS_Iterator.hxx>
+#include <NCollection_Vector.hxx>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_ShapeAncestors, Standard_Transient);
+
+//=======================================================================
+//function : GEOMAlgo_ShapeAncestors
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeAncestors::GEOMAlgo_ShapeAncestors()
+:
+  myIsDone(Standard_False)
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeAncestors::~GEOMAlgo_ShapeAncestors()
+{
+}
+//=======================================================================
+//function : SetShape
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeAncestors::SetShape(const TopoDS_Shape& theShape)
+{
+  myShape=theShape;
+  myIsDone=Standard_False;
+}
+//=======================================================================
+//function : Shape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_ShapeAncestors::Shape() const
+{
+  return myShape;
+}
+//=======================================================================
+//function : IsDone
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeAncestors::IsDone() const
+{
+  return myIsDone;
+}
+//=======================================================================
+//function : IsValidFor
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeAncestors::IsValidFor
+  (const TopoDS_Shape& theShape) const
+{
+  return myIsDone && myShape.IsSame(theShape);
+}
+//=======================================================================
+//function : Perform
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeAncestors::Perform()
+{
+  Standard_Integer i, j, aNb, aNbLinks, aSubId;
+  //
+  myIsDone=Standard_False;
+  myShapes.Clear();
+  if (myShape.IsNull()) {
+    return;
+  }
+  //
+  // 1. the indices; myShapes is the queue of the shapes to visit,
+  //    so each shared sub-shape is visited once
+  myShapes.Add(myShape);
+  for (i=1; i<=myShapes.Extent(); ++i) {
+    TopoDS_Iterator aIt(myShapes(i));
+    for (; aIt.More(); aIt.Next()) {
+      myShapes.Add(aIt.Value());
+    }
+  }
+  aNb=myShapes.Extent();
+  //
+  // 2. the direct sub-shapes; the stamps skip the sub-shapes
+  //    met several times in the same shape
+  NCollection_Array1<Standard_Integer> aStamps(1, aNb);
+  NCollection_Array1<Standard_Integer> aNbAnc(1, aNb);
+  NCollection_Vector<Standard_Integer> aSubIds;
+  //
+  aStamps.Init(0);
+  aNbAnc.Init(0);
+  mySubFirst.Resize(1, aNb+1, Standard_False);
+  for (i=1; i<=aNb; ++i) {
+    TopoDS_Iterator aIt(myShapes(i));
+    //
+    mySubFirst(i)=aSubIds.Length()+1;
+    for (; aIt.More(); aIt.Next()) {
+      aSubId=myShapes.FindIndex(aIt.Value());
+      if (aStamps(aSubId)!=i) {
+        aStamps(aSubId)=i;
+        aSubIds.Append(aSubId);
+        ++aNbAnc(aSubId);
+      }
+    }
+  }
+  //
+  aNbLinks=aSubIds.Length();
+  mySubFirst(aNb+1)=aNbLinks+1;
+  mySubIds.Resize(1, Max(aNbLinks, 1), Standard_False);
+  myAncIds.Resize(1, Max(aNbLinks, 1), Standard_False);
+  for (i=1; i<=aNbLinks; ++i) {
+    mySubIds(i)=aSubIds(i-1);
+  }
+  //
+  // 3. the direct ancestors in the order of their indices
+  myAncFirst.Resize(1, aNb+1, Standard_False);
+  myAncFirst(1)=1;
+  for (i=1; i<=aNb; ++i) {
+    myAncFirst(i+1)=myAncFirst(i)+aNbAnc(i);
+    aStamps(i)=myAncFirst(i);
+  }
+  for (i=1; i<=aNb; ++i) {
+    for (j=mySubFirst(i); j<mySubFirst(i+1); ++j) {
+      aSubId=mySubIds(j);
+      myAncIds(aStamps(aSubId))=i;
+      ++aStamps(aSubId);
+    }
+  }
+  //
+  myIsDone=Standard_True;
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::Extent() const
+{
+  return myShapes.Extent();
+}
+//=======================================================================
+//function : Index
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::Index
+  (const TopoDS_Shape& theS) const
+{
+  return myShapes.FindIndex(theS);
+}
+//=======================================================================
+//function : SubShape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_ShapeAncestors::SubShape
+  (const Standard_Integer theIndex) const
+{
+  return myShapes(theIndex);
+}
+//=======================================================================
+//function : NbSubShapes
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::NbSubShapes
+  (const Standard_Integer theIndex) const
+{
+  return mySubFirst(theIndex+1)-mySubFirst(theIndex);
+}
+//=======================================================================
+//function : SubShapeIndex
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::SubShapeIndex
+  (const Standard_Integer theIndex,
+   const Standard_Integer theK) const
+{
+  return mySubIds(mySubFirst(theIndex)+theK-1);
+}
+//=======================================================================
+//function : NbAncestors
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::NbAncestors
+  (const Standard_Integer theIndex) const
+{
+  return myAncFirst(theIndex+1)-myAncFirst(theIndex);
+}
+//=======================================================================
+//function : Ancestor
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeAncestors::Ancestor
+  (const Standard_Integer theIndex,
+   const Standard_Integer theK) const
+{
+  return myAncIds(myAncFirst(theIndex)+theK-1);
+}
@@ -0,0 +1,117 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_ShapeAncestors.hxx
+//
+#ifndef _GEOMAlgo_ShapeAncestors_HeaderFile
+#define _GEOMAlgo_ShapeAncestors_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Boolean.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <NCollection_Array1.hxx>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_ShapeAncestors, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeAncestors
+//purpose  : The shape and all its sub-shapes numbered once (the shape
+//           gets the index 1), with the direct sub-shapes and the
+//           direct ancestors of each index kept in flat arrays.
+//           Each shared sub-shape is visited once, however many
+//           ancestors it has.
+//           It is read only after Perform, so the threads can use it.
+//=======================================================================
+class GEOMAlgo_ShapeAncestors : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_ShapeAncestors();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_ShapeAncestors();
+
+  Standard_EXPORT
+    void SetShape(const TopoDS_Shape& theShape) ;
+
+  Standard_EXPORT
+    const TopoDS_Shape& Shape() const;
+
+  //! Numbers the sub-shapes and fills the arrays <br>
+  Standard_EXPORT
+    void Perform() ;
+
+  Standard_EXPORT
+    Standard_Boolean IsDone() const;
+
+  //! Returns true if the arrays are filled for the shape theShape <br>
+  Standard_EXPORT
+    Standard_Boolean IsValidFor(const TopoDS_Shape& theShape) const;
+
+  //! Returns the number of the shapes <br>
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns the index of the sub-shape theS, 0 if it is not mapped <br>
+  Standard_EXPORT
+    Standard_Integer Index(const TopoDS_Shape& theS) const;
+
+  //! Returns the sub-shape theIndex, 1 <= theIndex <= Extent() <br>
+  Standard_EXPORT
+    const TopoDS_Shape& SubShape(const Standard_Integer theIndex) const;
+
+  //! Returns the number of the distinct direct sub-shapes <br>
+  //!          of the sub-shape theIndex <br>
+  Standard_EXPORT
+    Standard_Integer NbSubShapes(const Standard_Integer theIndex) const;
+
+  //! Returns the index of the direct sub-shape theK, <br>
+  //!          1 <= theK <= NbSubShapes(theIndex) <br>
+  Standard_EXPORT
+    Standard_Integer SubShapeIndex(const Standard_Integer theIndex,
+                                   const Standard_Integer theK) const;
+
+  //! Returns the number of the direct ancestors <br>
+  //!          of the sub-shape theIndex <br>
+  Standard_EXPORT
+    Standard_Integer NbAncestors(const Standard_Integer theIndex) const;
+
+  //! Returns the index of the direct ancestor theK, <br>
+  //!          1 <= theK <= NbAncestors(theIndex). <br>
+  //!          The ancestors are in the order of their indices <br>
+  Standard_EXPORT
+    Standard_Integer Ancestor(const Standard_Integer theIndex,
+                              const Standard_Integer theK) const;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_ShapeAncestors, Standard_Transient)
+
+ protected:
+  TopoDS_Shape myShape;
+  Standard_Boolean myIsDone;
+  TopTools_IndexedMapOfShape myShapes;
+  NCollection_Array1<Standard_Integer> mySubFirst;
+  NCollection_Array1<Standard_Integer> mySubIds;
+  NCollection_Array1<Standard_Integer> myAncFirst;
+  NCollection_Array1<Standard_Integer> myAncIds;
+};
+#endif
@@ -18,6 +18,7 @@
 //
 
 #include <GEOMAlgo_ShapeInfoFiller.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
 
 #include <Precision.hxx>
 
@@ -54,6 +55,52 @@
 #include <BRepTools.hxx>
 
 #include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
+#include <TopTools_ListIteratorOfListOfShape.hxx>
+#include <TopTools_MapOfShape.hxx>
+
+#include <TopExp_Explorer.hxx>
+
+#include <OSD_Parallel.hxx>
+#include <NCollection_Array1.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoFillerFunctor
+//purpose  : fills the records of the chunk of the shapes theM;
+//           the records are in the map of the filler already
+//=======================================================================
+class GEOMAlgo_ShapeInfoFillerFunctor
+{
+ public:
+  GEOMAlgo_ShapeInfoFillerFunctor
+    (GEOMAlgo_ShapeInfoFiller& theFiller,
+     const TopTools_IndexedMapOfShape& theM,
+     NCollection_Array1<Standard_Integer>& theErrs,
+     const Standard_Integer theNbChunks)
+  :
+    myFiller(theFiller),
+    myM(theM),
+    myErrs(theErrs),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb;
+    //
+    aNb=myM.Extent();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      myErrs(i)=myFiller.FillInfo(myM(i));
+    }
+  }
+  //
+ protected:
+  GEOMAlgo_ShapeInfoFiller& myFiller;
+  const TopTools_IndexedMapOfShape& myM;
+  NCollection_Array1<Standard_Integer>& myErrs;
+  Standard_Integer myNbChunks;
+};
 
 //=======================================================================
 //function :
@@ -127,6 +174,33 @@ const GEOMAlgo_ShapeInfo& GEOMAlgo_ShapeInfoFiller::Info
   }
   return myEmptyInfo;
 }
+//=======================================================================
+//function : MapInfo
+//purpose  :
+//=======================================================================
+const GEOMAlgo_IndexedDataMapOfShapeShapeInfo&
+  GEOMAlgo_ShapeInfoFiller::MapInfo() const
+{
+  return myMapInfo;
+}
+//=======================================================================
+//function : SetGPropsCache
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::SetGPropsCache
+  (const Handle(GEOMAlgo_GPropsCache)& aCache)
+{
+  myGPropsCache=aCache;
+}
+//=======================================================================
+//function : GPropsCache
+//purpose  :
+//=======================================================================
+const Handle(GEOMAlgo_GPropsCache)&
+  GEOMAlgo_ShapeInfoFiller::GPropsCache() const
+{
+  return myGPropsCache;
+}
 
 //=======================================================================
 //function : CheckData
@@ -148,6 +222,7 @@ void GEOMAlgo_ShapeInfoFiller::CheckData()
 void GEOMAlgo_ShapeInfoFiller::Perform()
 {
   myErrorStatus=0;
+  ClearPhases();
   //
   myMapInfo.Clear();
   //
@@ -156,7 +231,224 @@ void GEOMAlgo_ShapeInfoFiller::Perform()
     return;
   }
   //
+  FillShapes();
+}
+//=======================================================================
+//function : Update
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::Update(const TopTools_ListOfShape& aLSModified)
+{
+  myErrorStatus=0;
+  ClearPhases();
+  //
+  CheckData();
+  if (myErrorStatus) {
+    return;
+  }
+  //
+  BeginPhase("KeepInfo");
+  KeepInfo(aLSModified);
+  AddPhaseShapes(myMapInfo.Extent());
+  EndPhase();
+  //
+  FillShapes();
+}
+//=======================================================================
+//function : KeepInfo
+//purpose  : keeps the records of the vertices, edges, faces and solids
+//           of myShape that are not modified, the other records are
+//           removed
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::KeepInfo(const TopTools_ListOfShape& aLSModified)
+{
+  Standard_Boolean bKeep;
+  Standard_Integer i, j, aNb;
+  TopExp_Explorer aExp;
+  TopTools_ListIteratorOfListOfShape aIt;
+  TopTools_MapOfShape aMD;
+  TopTools_IndexedMapOfShape aMS;
+  GEOMAlgo_IndexedDataMapOfShapeShapeInfo aMapInfo;
+  TopAbs_ShapeEnum aTypes[]= {
+    TopAbs_VERTEX,
+    TopAbs_EDGE,
+    TopAbs_FACE
+  };
+  //
+  // 1. the modified shapes and their ancestors
+  if (!aLSModified.IsEmpty()) {
+    TopTools_IndexedDataMapOfShapeListOfShape aMVE, aMEF;
+    //
+    aIt.Initialize(aLSModified);
+    for (; aIt.More(); aIt.Next()) {
+      aMD.Add(aIt.Value());
+    }
+    //
+    TopExp::MapShapesAndAncestors(myShape, TopAbs_VERTEX, TopAbs_EDGE, aMVE);
+    aNb=aMVE.Extent();
+    for (i=1; i<=aNb; ++i) {
+      if (aMD.Contains(aMVE.FindKey(i))) {
+        aIt.Initialize(aMVE(i));
+        for (; aIt.More(); aIt.Next()) {
+          aMD.Add(aIt.Value());
+        }
+      }
+    }
+    //
+    TopExp::MapShapesAndAncestors(myShape, TopAbs_EDGE, TopAbs_FACE, aMEF);
+    aNb=aMEF.Extent();
+    for (i=1; i<=aNb; ++i) {
+      if (aMD.Contains(aMEF.FindKey(i))) {
+        aIt.Initialize(aMEF(i));
+        for (; aIt.More(); aIt.Next()) {
+          aMD.Add(aIt.Value());
+        }
+      }
+    }
+  }
+  //
+  // 2. the vertices, edges and faces
+  for (j=0; j<3; ++j) {
+    aMS.Clear();
+    TopExp::MapShapes(myShape, aTypes[j], aMS);
+    aNb=aMS.Extent();
+    for (i=1; i<=aNb; ++i) {
+      const TopoDS_Shape& aS=aMS(i);
+      if (!aMD.Contains(aS) && myMapInfo.Contains(aS)) {
+        aMapInfo.Add(aS, myMapInfo.FindFromKey(aS));
+      }
+    }
+  }
+  //
+  // 3. the solids whose faces are all kept
+  aMS.Clear();
+  TopExp::MapShapes(myShape, TopAbs_SOLID, aMS);
+  aNb=aMS.Extent();
+  for (i=1; i<=aNb; ++i) {
+    const TopoDS_Shape& aSd=aMS(i);
+    bKeep=(!aMD.Contains(aSd) && myMapInfo.Contains(aSd));
+    //
+    aExp.Init(aSd, TopAbs_FACE);
+    for (; aExp.More() && bKeep; aExp.Next()) {
+      bKeep=aMapInfo.Contains(aExp.Current());
+    }
+    if (bKeep) {
+      aMapInfo.Add(aSd, myMapInfo.FindFromKey(aSd));
+    }
+    else if (!myGPropsCache.IsNull()) {
+      myGPropsCache->Remove(aSd);
+    }
+  }
+  //
+  myMapInfo.Exchange(aMapInfo);
+}
+//=======================================================================
+//function : FillShapes
+//purpose  : fills the records of myShape and its sub-shapes that are
+//           not in myMapInfo
+//=======================================================================
+void GEOMAlgo_ShapeInfoFiller::FillShapes()
+{
+  Standard_Integer iErr;
+  //
+  iErr=0;
+  if (myRunParallel) {
+    BeginPhase("FillShapesParallel");
+    iErr=FillShapesParallel();
+    EndPhase();
+  }
+  //
+  BeginPhase("FillShape");
   FillShape(myShape);
+  AddPhaseShapes(myMapInfo.Extent());
+  EndPhase();
+  //
+  if (iErr) {
+    myErrorStatus=iErr;
+  }
+}
+//=======================================================================
+//function : FillShapesParallel
+//purpose  : fills the records of the vertices, then of the edges, then
+//           of the faces in parallel; the records of the solids and of
+//           the containers are left for FillShape
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillShapesParallel()
+{
+  Standard_Integer i, j, aNb, aNbChunks, iErr;
+  TopTools_IndexedMapOfShape aMS, aM;
+  TopAbs_ShapeEnum aTypes[]= {
+    TopAbs_VERTEX,
+    TopAbs_EDGE,
+    TopAbs_FACE
+  };
+  //
+  iErr=0;
+  for (j=0; j<3; ++j) {
+    aMS.Clear();
+    aM.Clear();
+    TopExp::MapShapes(myShape, aTypes[j], aMS);
+    aNb=aMS.Extent();
+    for (i=1; i<=aNb; ++i) {
+      const TopoDS_Shape& aS=aMS(i);
+      if (!myMapInfo.Contains(aS)) {
+        GEOMAlgo_ShapeInfo aInfoX;
+        //
+        myMapInfo.Add(aS, aInfoX);
+        aM.Add(aS);
+      }
+    }
+    //
+    aNb=aM.Extent();
+    if (!aNb) {
+      continue;
+    }
+    //
+    aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, Standard_True);
+    //
+    NCollection_Array1<Standard_Integer> aErrs(1, aNb);
+    aErrs.Init(0);
+    //
+    GEOMAlgo_ShapeInfoFillerFunctor aFunctor(*this, aM, aErrs, aNbChunks);
+    OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+    //
+    AddPhaseShapes(aNb);
+    for (i=1; i<=aNb && !iErr; ++i) {
+      iErr=aErrs(i);
+    }
+  }
+  return iErr;
+}
+//=======================================================================
+//function : FillInfo
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillInfo(const TopoDS_Shape& aS)
+{
+  Standard_Integer iErr;
+  TopAbs_ShapeEnum aType;
+  //
+  iErr=0;
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
+  //
+  aType=aS.ShapeType();
+  switch(aType) {
+    case TopAbs_VERTEX:
+      iErr=FillVertexInfo(aS, aInfo);
+      break;
+    //
+    case TopAbs_EDGE:
+      iErr=FillEdgeInfo(aS, aInfo);
+      break;
+    //
+    case TopAbs_FACE:
+      iErr=FillFaceInfo(aS, aInfo);
+      break;
+    //
+    default:
+      break;
+  }
+  return iErr;
 }
 //=======================================================================
 //function :FillShape
@@ -292,7 +584,24 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
   if (myMapInfo.Contains(aS)) {
     return;
   }
+  //----------------------------------------------------
+  GEOMAlgo_ShapeInfo aInfoX;
+  myMapInfo.Add(aS, aInfoX);
   //
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
+  //----------------------------------------------------
+  FillSubShapes(aS);
+  //
+  FillFaceInfo(aS, aInfo);
+}
+//=======================================================================
+//function : FillFaceInfo
+//purpose  : the records of the edges of the face are filled already
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillFaceInfo
+  (const TopoDS_Shape& aS,
+   GEOMAlgo_ShapeInfo& aInfo)
+{
   Standard_Boolean bIsAllowedType;
   Standard_Boolean bInf, bInfU1, bInfU2, bInfV1, bInfV2;
   Standard_Real aUMin, aUMax, aVMin, aVMax, aR1, aR2, dV;
@@ -302,18 +611,11 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
   GeomAbs_SurfaceType aST;
   Handle(Geom_Surface) aSurf;
   TopoDS_Face aF;
-  //----------------------------------------------------
-  GEOMAlgo_ShapeInfo aInfoX;
-  myMapInfo.Add(aS, aInfoX);
   //
-  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
-  //----------------------------------------------------
   aInfo.SetType(TopAbs_FACE);
   //
   FillNbSubShapes(aS, aInfo);
   //
-  FillSubShapes(aS);
-  //
   aF=TopoDS::Face(aS);
   //
   aSurf=BRep_Tool::Surface(aF);
@@ -321,7 +623,7 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
   aST=aGAS.GetType();
   bIsAllowedType=GEOMAlgo_ShapeInfoFiller::IsAllowedType(aST);
   if (!bIsAllowedType) {
-    return;
+    return 0;
   }
   //
   //||||||||||||||||||||||||||||||||||||||||||||||||||||||||||
@@ -348,7 +650,7 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
     bInf=(bInfU1 || bInfU2 || bInfV1 || bInfV2);
     if (bInf) {
       aInfo.SetKindOfBounds(GEOMAlgo_KB_INFINITE);
-      return;
+      return 0;
     }
     //
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
@@ -403,7 +705,7 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
     bInf=(bInfU1 || bInfU2 || bInfV1 || bInfV2);
     if (bInf) {
       aInfo.SetKindOfBounds(GEOMAlgo_KB_INFINITE);
-      return;
+      return 0;
     }
     //
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
@@ -438,7 +740,7 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
     bInf=(bInfU1 || bInfU2 || bInfV1 || bInfV2);
     if (bInf) {
       aInfo.SetKindOfBounds(GEOMAlgo_KB_INFINITE);
-      return;
+      return 0;
     }
     //
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
@@ -473,6 +775,7 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
     //
     FillDetails(aF, aTorus);
   }
+  return 0;
 }
 //=======================================================================
 //function :FillEdge
@@ -481,7 +784,31 @@ void GEOMAlgo_ShapeInfoFiller::FillFace(const TopoDS_Shape& aS)
 void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
 {
   myErrorStatus=0;
+  //----------------------------------------------------
+  if (myMapInfo.Contains(aS)) {
+    return;
+  }
+  else {
+    GEOMAlgo_ShapeInfo aInfoX;
+    myMapInfo.Add(aS, aInfoX);
+  }
+  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
+  //----------------------------------------------------
+  myErrorStatus=FillEdgeInfo(aS, aInfo);
+  if (myErrorStatus) {
+    return;
+  }
   //
+  FillSubShapes(aS);
+}
+//=======================================================================
+//function : FillEdgeInfo
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillEdgeInfo
+  (const TopoDS_Shape& aS,
+   GEOMAlgo_ShapeInfo& aInfo)
+{
   Standard_Boolean bDegenerated, bIsAllowedType;
   Standard_Integer aNbV;
   Standard_Real aR1, aR2;
@@ -492,16 +819,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
   GeomAbs_CurveType aCT;
   Handle(Geom_Curve) aC3D;
   TopoDS_Edge aE;
-  //----------------------------------------------------
-  if (myMapInfo.Contains(aS)) {
-    return;
-  }
-  else {
-    GEOMAlgo_ShapeInfo aInfoX;
-    myMapInfo.Add(aS, aInfoX);
-  }
-  GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
-  //----------------------------------------------------
+  //
   aInfo.SetType(TopAbs_EDGE);
   //
   FillNbSubShapes(aS, aInfo);
@@ -511,8 +829,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
   bDegenerated=BRep_Tool::Degenerated(aE);
   if (bDegenerated) {
     aInfo.SetKindOfShape(GEOMAlgo_KS_DEGENERATED);
-    FillSubShapes(aS);
-    return;
+    return 0;
   }
   //
   aC3D=BRep_Tool::Curve(aE, aT1, aT2);
@@ -520,8 +837,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
   aCT=aGAC.GetType();
   bIsAllowedType=GEOMAlgo_ShapeInfoFiller::IsAllowedType(aCT);
   if (!bIsAllowedType) {
-    FillSubShapes(aS);
-    return;
+    return 0;
   }
   // BSplineCurve
   if (aCT==GeomAbs_BSplineCurve) {
@@ -535,7 +851,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     aNbPoles=aBSp->NbPoles();
     aDegree =aBSp->Degree();
     if (!(aDegree==1 && aNbKnots==2 && aNbPoles==2)) {
-      return; // unallowed B-Spline curve
+      return 0; // unallowed B-Spline curve
     }
     //
     aInfo.SetKindOfShape(GEOMAlgo_KS_BSPLINE);
@@ -626,8 +942,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     //
     aNbV=aInfo.NbSubShapes(TopAbs_VERTEX);
     if (!aNbV) {
-      myErrorStatus=11; // circle edge without vertices
-      return;
+      return 11; // circle edge without vertices
     }
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
     aGAC.D0(aT1, aP1);
@@ -668,8 +983,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
     //
     aNbV=aInfo.NbSubShapes(TopAbs_VERTEX);
     if (!aNbV) {
-      myErrorStatus=11; // ellipse edge without vertices
-      return;
+      return 11; // ellipse edge without vertices
     }
     aInfo.SetKindOfBounds(GEOMAlgo_KB_TRIMMED);
     aGAC.D0(aT1, aP1);
@@ -691,8 +1005,7 @@ void GEOMAlgo_ShapeInfoFiller::FillEdge(const TopoDS_Shape& aS)
       aInfo.SetPosition(aAx2new);
     }
   }// else if (aCT==GeomAbs_Ellipse) {
-  //
-  FillSubShapes(aS);
+  return 0;
 }
 //=======================================================================
 //function :FillVertex
@@ -702,9 +1015,6 @@ void GEOMAlgo_ShapeInfoFiller::FillVertex(const TopoDS_Shape& aS)
 {
   myErrorStatus=0;
   //
-  gp_Pnt aP;
-  TopoDS_Vertex aV;
-  //
   if (myMapInfo.Contains(aS)) {
     return;
   }
@@ -714,12 +1024,25 @@ void GEOMAlgo_ShapeInfoFiller::FillVertex(const TopoDS_Shape& aS)
   }
   GEOMAlgo_ShapeInfo& aInfo=myMapInfo.ChangeFromKey(aS);
   //
+  FillVertexInfo(aS, aInfo);
+}
+//=======================================================================
+//function : FillVertexInfo
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoFiller::FillVertexInfo
+  (const TopoDS_Shape& aS,
+   GEOMAlgo_ShapeInfo& aInfo)
+{
+  gp_Pnt aP;
+  TopoDS_Vertex aV;
+  //
   aV=TopoDS::Vertex(aS);
   aP=BRep_Tool::Pnt(aV);
   //
   aInfo.SetType(TopAbs_VERTEX);
   aInfo.SetLocation(aP);
-  myMapInfo.Add(aS, aInfo);
+  return 0;
 }
 //=======================================================================
 //function : FillNbSubshapes
@@ -728,8 +1051,6 @@ void GEOMAlgo_ShapeInfoFiller::FillVertex(const TopoDS_Shape& aS)
 void GEOMAlgo_ShapeInfoFiller::FillNbSubShapes(const TopoDS_Shape& aS,
                                                GEOMAlgo_ShapeInfo& aInfo)
 {
-  myErrorStatus=0;
-  //
   Standard_Integer i, aNb, aNbS;
   TopTools_IndexedMapOfShape aM;
   TopAbs_ShapeEnum aST;
@@ -36,10 +36,12 @@
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Face.hxx>
+#include <TopTools_ListOfShape.hxx>
 
 #include <GEOMAlgo_ShapeInfo.hxx>
 #include <GEOMAlgo_IndexedDataMapOfShapeShapeInfo.hxx>
 #include <GEOMAlgo_Algo.hxx>
+#include <GEOMAlgo_GPropsCache.hxx>
 
 //=======================================================================
 //class    : GEOMAlgo_ShapeInfoFiller
@@ -72,13 +74,69 @@ class GEOMAlgo_ShapeInfoFiller  : public GEOMAlgo_Algo
   Standard_EXPORT
     const GEOMAlgo_ShapeInfo& Info(const TopoDS_Shape& aS) const;
 
+  //! Returns the records of all shapes, see also <br>
+  //!          GEOMAlgo_ShapeInfoStore <br>
+  Standard_EXPORT
+    const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& MapInfo() const;
+
+  //! Sets the cache of the volumes and areas of the solids, <br>
+  //!          which can be shared with other algorithms <br>
+  Standard_EXPORT
+    void SetGPropsCache(const Handle(GEOMAlgo_GPropsCache)& aCache) ;
+
+  Standard_EXPORT
+    const Handle(GEOMAlgo_GPropsCache)& GPropsCache() const;
+
+  //! Fills the records of myShape and its sub-shapes. <br>
+  //!          If myRunParallel is set the records of the vertices, <br>
+  //!          edges and faces are filled in parallel first, then <br>
+  //!          the solids and the containers are aggregated. <br>
   Standard_EXPORT
     virtual  void Perform() ;
 
+  //! Re-fills the records after myShape was changed. <br>
+  //!          The records of the vertices, edges, faces and solids <br>
+  //!          of the previous Perform() or Update() are kept if the <br>
+  //!          shapes are still in myShape, are not in aLSModified and <br>
+  //!          do not contain the shapes of aLSModified. <br>
+  //!          aLSModified are the shapes modified in place (e.g. by <br>
+  //!          BRep_Builder), the new shapes are found by itself. <br>
+  Standard_EXPORT
+    void Update(const TopTools_ListOfShape& aLSModified) ;
+
  protected:
+  friend class GEOMAlgo_ShapeInfoFillerFunctor;
+
   Standard_EXPORT
     virtual  void CheckData() ;
 
+  Standard_EXPORT
+    void KeepInfo(const TopTools_ListOfShape& aLSModified) ;
+
+  Standard_EXPORT
+    void FillShapes() ;
+
+  Standard_EXPORT
+    Standard_Integer FillShapesParallel() ;
+
+  //! Fills the record of the vertex, edge or face aS that is in <br>
+  //!          myMapInfo already. Does not change the map and <br>
+  //!          myErrorStatus, returns the error code. <br>
+  Standard_EXPORT
+    Standard_Integer FillInfo(const TopoDS_Shape& aS) ;
+
+  Standard_EXPORT
+    Standard_Integer FillVertexInfo(const TopoDS_Shape& aS,
+                                    GEOMAlgo_ShapeInfo& aInfo) ;
+
+  Standard_EXPORT
+    Standard_Integer FillEdgeInfo(const TopoDS_Shape& aS,
+                                  GEOMAlgo_ShapeInfo& aInfo) ;
+
+  Standard_EXPORT
+    Standard_Integer FillFaceInfo(const TopoDS_Shape& aS,
+                                  GEOMAlgo_ShapeInfo& aInfo) ;
+
   Standard_EXPORT
     void FillNbSubShapes(const TopoDS_Shape& aS,GEOMAlgo_ShapeInfo& aInfo) ;
 
@@ -142,6 +200,7 @@ class GEOMAlgo_ShapeInfoFiller  : public GEOMAlgo_Algo
   GEOMAlgo_ShapeInfo myEmptyInfo;
   GEOMAlgo_IndexedDataMapOfShapeShapeInfo myMapInfo;
   Standard_Real myTolerance;
+  Handle(GEOMAlgo_GPropsCache) myGPropsCache;
 };
 
 #endif
@@ -830,16 +830,22 @@ Standard_Boolean  GEOMAlgo_ShapeInfoFiller::TreatStepSphere
   //
   //--------------------------------
   GProp_GProps aGProps;
+  gp_Pnt aPCG;
   //
   bOnlyClosed=Standard_False;
   //
   aVolume=aSphere[0].Volume();
   //
   //modified by NIZNHY-PKV Tue Jun 09 08:39:47 2015f
-  BRepGProp::VolumeProperties(aSd, aGProps, aTol,  bOnlyClosed);
-  //BRepGProp::VolumeProperties(aSd, aGProps,  bOnlyClosed);
+  if (!myGPropsCache.IsNull()) {
+    myGPropsCache->Properties(aSd, 3, aTol, aVolumeS, aPCG);
+  }
+  else {
+    BRepGProp::VolumeProperties(aSd, aGProps, aTol,  bOnlyClosed);
+    //BRepGProp::VolumeProperties(aSd, aGProps,  bOnlyClosed);
+    aVolumeS=aGProps.Mass();
+  }
   //modified by NIZNHY-PKV Tue Jun 09 08:39:50 2015t
-  aVolumeS=aGProps.Mass();
   if (aVolumeS<0.) {
     aVolumeS=-aVolumeS;
   }
@@ -852,10 +858,15 @@ Standard_Boolean  GEOMAlgo_ShapeInfoFiller::TreatStepSphere
   aArea=aSphere[0].Area();
   //
   //modified by NIZNHY-PKV Tue Jun 09 08:23:54 2015f
-  BRepGProp::SurfaceProperties(aSd, aGProps, aTol);
-  //BRepGProp::SurfaceProperties(aSd, aGProps);
+  if (!myGPropsCache.IsNull()) {
+    myGPropsCache->Properties(aSd, 2, aTol, aAreaS, aPCG);
+  }
+  else {
+    BRepGProp::SurfaceProperties(aSd, aGProps, aTol);
+    //BRepGProp::SurfaceProperties(aSd, aGProps);
+    aAreaS=aGProps.Mass();
+  }
   //modified by NIZNHY-PKV Tue Jun 09 08:23:56 2015t
-  aAreaS=aGProps.Mass();
   //
   dA=fabs(aAreaS-aArea);
   if (dA>aTol) {
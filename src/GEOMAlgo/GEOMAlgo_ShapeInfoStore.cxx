@@ -0,0 +1,564 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_ShapeInfoStore.cxx
+//
+#include <GEOMAlgo_ShapeInfoStore.hxx>
+
+#include <gp_Pnt.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Ax3.hxx>
+
+static
+  Standard_Integer FieldGroup(const GEOMAlgo_ShapeInfoStore::Field aF);
+static
+  Standard_Integer FieldGroups(const GEOMAlgo_KindOfName aKN);
+
+// the groups of the fields
+enum {
+  GEOMAlgo_FG_LOCATION  = 0x001,
+  GEOMAlgo_FG_DIRECTION = 0x002,
+  GEOMAlgo_FG_POSITION  = 0x004,
+  GEOMAlgo_FG_RADIUS1   = 0x008,
+  GEOMAlgo_FG_RADIUS2   = 0x010,
+  GEOMAlgo_FG_LENGTH    = 0x020,
+  GEOMAlgo_FG_WIDTH     = 0x040,
+  GEOMAlgo_FG_HEIGHT    = 0x080,
+  GEOMAlgo_FG_PNT1      = 0x100,
+  GEOMAlgo_FG_PNT2      = 0x200
+};
+
+//=======================================================================
+//function :
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoStore::GEOMAlgo_ShapeInfoStore()
+{
+  Standard_Integer i;
+  //
+  for (i=0; i<NbNames; ++i) {
+    myNbRows[i]=0;
+  }
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_ShapeInfoStore::~GEOMAlgo_ShapeInfoStore()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  : the arrays are kept for the next Build()
+//=======================================================================
+void GEOMAlgo_ShapeInfoStore::Clear()
+{
+  Standard_Integer i;
+  //
+  myShapes.Clear();
+  for (i=0; i<NbNames; ++i) {
+    myNbRows[i]=0;
+  }
+}
+//=======================================================================
+//function : Build
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoStore::Build
+  (const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& aMapInfo)
+{
+  Standard_Integer i, k, aNb, aNbC, aRow;
+  GEOMAlgo_KindOfName aKN;
+  //
+  Clear();
+  //
+  aNb=aMapInfo.Extent();
+  if (!aNb) {
+    return;
+  }
+  //
+  myTypes.Resize(1, aNb, Standard_False);
+  myKindsOfShape.Resize(1, aNb, Standard_False);
+  myKindsOfName.Resize(1, aNb, Standard_False);
+  myKindsOfBounds.Resize(1, aNb, Standard_False);
+  myKindsOfClosed.Resize(1, aNb, Standard_False);
+  myKindsOfDef.Resize(1, aNb, Standard_False);
+  myRows.Resize(1, aNb, Standard_False);
+  //
+  // 1. the kinds and the rows
+  for (i=1; i<=aNb; ++i) {
+    const GEOMAlgo_ShapeInfo& aInfo=aMapInfo(i);
+    //
+    myShapes.Add(aMapInfo.FindKey(i));
+    aKN=aInfo.KindOfName();
+    myTypes(i)=(Standard_Byte)aInfo.Type();
+    myKindsOfShape(i)=(Standard_Byte)aInfo.KindOfShape();
+    myKindsOfName(i)=(Standard_Byte)aKN;
+    myKindsOfBounds(i)=(Standard_Byte)aInfo.KindOfBounds();
+    myKindsOfClosed(i)=(Standard_Byte)aInfo.KindOfClosed();
+    myKindsOfDef(i)=(Standard_Byte)aInfo.KindOfDef();
+    myRows(i)=myNbRows[aKN]++;
+  }
+  //
+  // 2. the tables
+  for (k=0; k<NbNames; ++k) {
+    if (!myNbRows[k]) {
+      continue;
+    }
+    myIds[k].Resize(0, myNbRows[k]-1, Standard_False);
+    aNbC=NbColumns((GEOMAlgo_KindOfName)k);
+    if (aNbC) {
+      myColumns[k].Resize(0, aNbC*myNbRows[k]-1, Standard_False);
+    }
+  }
+  //
+  // 3. the values
+  for (i=1; i<=aNb; ++i) {
+    const GEOMAlgo_ShapeInfo& aInfo=aMapInfo(i);
+    const gp_Ax3& aAx3=aInfo.Position();
+    const gp_Pnt& aPO=aAx3.Location();
+    const gp_Dir& aDZ=aAx3.Direction();
+    const gp_Dir& aDX=aAx3.XDirection();
+    const gp_Pnt& aP=aInfo.Location();
+    const gp_Dir& aD=aInfo.Direction();
+    const gp_Pnt& aP1=aInfo.Pnt1();
+    const gp_Pnt& aP2=aInfo.Pnt2();
+    //
+    aKN=(GEOMAlgo_KindOfName)myKindsOfName(i);
+    aRow=myRows(i);
+    myIds[aKN](aRow)=i;
+    //
+    SetValue(aKN, aRow, LocationX, aP.X());
+    SetValue(aKN, aRow, LocationY, aP.Y());
+    SetValue(aKN, aRow, LocationZ, aP.Z());
+    SetValue(aKN, aRow, DirectionX, aD.X());
+    SetValue(aKN, aRow, DirectionY, aD.Y());
+    SetValue(aKN, aRow, DirectionZ, aD.Z());
+    SetValue(aKN, aRow, OriginX, aPO.X());
+    SetValue(aKN, aRow, OriginY, aPO.Y());
+    SetValue(aKN, aRow, OriginZ, aPO.Z());
+    SetValue(aKN, aRow, AxisX, aDZ.X());
+    SetValue(aKN, aRow, AxisY, aDZ.Y());
+    SetValue(aKN, aRow, AxisZ, aDZ.Z());
+    SetValue(aKN, aRow, XAxisX, aDX.X());
+    SetValue(aKN, aRow, XAxisY, aDX.Y());
+    SetValue(aKN, aRow, XAxisZ, aDX.Z());
+    SetValue(aKN, aRow, Radius1, aInfo.Radius1());
+    SetValue(aKN, aRow, Radius2, aInfo.Radius2());
+    SetValue(aKN, aRow, Length, aInfo.Length());
+    SetValue(aKN, aRow, Width, aInfo.Width());
+    SetValue(aKN, aRow, Height, aInfo.Height());
+    SetValue(aKN, aRow, Pnt1X, aP1.X());
+    SetValue(aKN, aRow, Pnt1Y, aP1.Y());
+    SetValue(aKN, aRow, Pnt1Z, aP1.Z());
+    SetValue(aKN, aRow, Pnt2X, aP2.X());
+    SetValue(aKN, aRow, Pnt2Y, aP2.Y());
+    SetValue(aKN, aRow, Pnt2Z, aP2.Z());
+  }
+}
+//=======================================================================
+//function : SetValue
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoStore::SetValue(const GEOMAlgo_KindOfName aKN,
+                                       const Standard_Integer aRow,
+                                       const Field aF,
+                                       const Standard_Real aValue)
+{
+  Standard_Integer iC;
+  //
+  iC=ColumnIndex(aKN, aF);
+  if (iC<0) {
+    return;
+  }
+  myColumns[aKN](iC*myNbRows[aKN]+aRow)=aValue;
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::Extent() const
+{
+  return myShapes.Extent();
+}
+//=======================================================================
+//function : Index
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::Index(const TopoDS_Shape& aS) const
+{
+  return myShapes.FindIndex(aS);
+}
+//=======================================================================
+//function : Shape
+//purpose  :
+//=======================================================================
+const TopoDS_Shape& GEOMAlgo_ShapeInfoStore::Shape
+  (const Standard_Integer aId) const
+{
+  return myShapes(aId);
+}
+//=======================================================================
+//function : Type
+//purpose  :
+//=======================================================================
+TopAbs_ShapeEnum GEOMAlgo_ShapeInfoStore::Type
+  (const Standard_Integer aId) const
+{
+  return (TopAbs_ShapeEnum)myTypes(aId);
+}
+//=======================================================================
+//function : KindOfShape
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfShape GEOMAlgo_ShapeInfoStore::KindOfShape
+  (const Standard_Integer aId) const
+{
+  return (GEOMAlgo_KindOfShape)myKindsOfShape(aId);
+}
+//=======================================================================
+//function : KindOfName
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfName GEOMAlgo_ShapeInfoStore::KindOfName
+  (const Standard_Integer aId) const
+{
+  return (GEOMAlgo_KindOfName)myKindsOfName(aId);
+}
+//=======================================================================
+//function : KindOfBounds
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfBounds GEOMAlgo_ShapeInfoStore::KindOfBounds
+  (const Standard_Integer aId) const
+{
+  return (GEOMAlgo_KindOfBounds)myKindsOfBounds(aId);
+}
+//=======================================================================
+//function : KindOfClosed
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfClosed GEOMAlgo_ShapeInfoStore::KindOfClosed
+  (const Standard_Integer aId) const
+{
+  return (GEOMAlgo_KindOfClosed)myKindsOfClosed(aId);
+}
+//=======================================================================
+//function : KindOfDef
+//purpose  :
+//=======================================================================
+GEOMAlgo_KindOfDef GEOMAlgo_ShapeInfoStore::KindOfDef
+  (const Standard_Integer aId) const
+{
+  return (GEOMAlgo_KindOfDef)myKindsOfDef(aId);
+}
+//=======================================================================
+//function : Row
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::Row
+  (const Standard_Integer aId) const
+{
+  return myRows(aId);
+}
+//=======================================================================
+//function : NbRows
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::NbRows
+  (const GEOMAlgo_KindOfName aKN) const
+{
+  return myNbRows[aKN];
+}
+//=======================================================================
+//function : Ids
+//purpose  :
+//=======================================================================
+const Standard_Integer* GEOMAlgo_ShapeInfoStore::Ids
+  (const GEOMAlgo_KindOfName aKN) const
+{
+  if (!myNbRows[aKN]) {
+    return NULL;
+  }
+  return &myIds[aKN](0);
+}
+//=======================================================================
+//function : Column
+//purpose  :
+//=======================================================================
+const Standard_Real* GEOMAlgo_ShapeInfoStore::Column
+  (const GEOMAlgo_KindOfName aKN,
+   const Field aF) const
+{
+  Standard_Integer iC;
+  //
+  iC=ColumnIndex(aKN, aF);
+  if (iC<0 || !myNbRows[aKN]) {
+    return NULL;
+  }
+  return &myColumns[aKN](iC*myNbRows[aKN]);
+}
+//=======================================================================
+//function : Value
+//purpose  :
+//=======================================================================
+Standard_Real GEOMAlgo_ShapeInfoStore::Value(const Standard_Integer aId,
+                                             const Field aF) const
+{
+  Standard_Integer iC;
+  GEOMAlgo_KindOfName aKN;
+  //
+  aKN=KindOfName(aId);
+  iC=ColumnIndex(aKN, aF);
+  if (iC<0) {
+    return 0.;
+  }
+  return myColumns[aKN](iC*myNbRows[aKN]+myRows(aId));
+}
+//=======================================================================
+//function : Info
+//purpose  :
+//=======================================================================
+void GEOMAlgo_ShapeInfoStore::Info(const Standard_Integer aId,
+                                   GEOMAlgo_ShapeInfo& aInfo) const
+{
+  GEOMAlgo_KindOfName aKN;
+  //
+  aInfo.Reset();
+  //
+  aKN=KindOfName(aId);
+  aInfo.SetType(Type(aId));
+  aInfo.SetKindOfShape(KindOfShape(aId));
+  aInfo.SetKindOfName(aKN);
+  aInfo.SetKindOfBounds(KindOfBounds(aId));
+  aInfo.SetKindOfClosed(KindOfClosed(aId));
+  aInfo.SetKindOfDef(KindOfDef(aId));
+  //
+  if (HasField(aKN, LocationX)) {
+    aInfo.SetLocation(gp_Pnt(Value(aId, LocationX),
+                             Value(aId, LocationY),
+                             Value(aId, LocationZ)));
+  }
+  if (HasField(aKN, DirectionX)) {
+    aInfo.SetDirection(gp_Dir(Value(aId, DirectionX),
+                              Value(aId, DirectionY),
+                              Value(aId, DirectionZ)));
+  }
+  if (HasField(aKN, OriginX)) {
+    gp_Ax3 aAx3(gp_Pnt(Value(aId, OriginX),
+                       Value(aId, OriginY),
+                       Value(aId, OriginZ)),
+                gp_Dir(Value(aId, AxisX),
+                       Value(aId, AxisY),
+                       Value(aId, AxisZ)),
+                gp_Dir(Value(aId, XAxisX),
+                       Value(aId, XAxisY),
+                       Value(aId, XAxisZ)));
+    aInfo.SetPosition(aAx3);
+  }
+  if (HasField(aKN, Radius1)) {
+    aInfo.SetRadius1(Value(aId, Radius1));
+  }
+  if (HasField(aKN, Radius2)) {
+    aInfo.SetRadius2(Value(aId, Radius2));
+  }
+  if (HasField(aKN, Length)) {
+    aInfo.SetLength(Value(aId, Length));
+  }
+  if (HasField(aKN, Width)) {
+    aInfo.SetWidth(Value(aId, Width));
+  }
+  if (HasField(aKN, Height)) {
+    aInfo.SetHeight(Value(aId, Height));
+  }
+  if (HasField(aKN, Pnt1X)) {
+    aInfo.SetPnt1(gp_Pnt(Value(aId, Pnt1X),
+                         Value(aId, Pnt1Y),
+                         Value(aId, Pnt1Z)));
+  }
+  if (HasField(aKN, Pnt2X)) {
+    aInfo.SetPnt2(gp_Pnt(Value(aId, Pnt2X),
+                         Value(aId, Pnt2Y),
+                         Value(aId, Pnt2Z)));
+  }
+}
+//=======================================================================
+//function : NbBytes
+//purpose  :
+//=======================================================================
+Standard_Size GEOMAlgo_ShapeInfoStore::NbBytes() const
+{
+  Standard_Integer k;
+  Standard_Size aNb, aNbBytes;
+  //
+  aNb=(Standard_Size)Extent();
+  aNbBytes=aNb*(6*sizeof(Standard_Byte)+sizeof(Standard_Integer));
+  for (k=0; k<NbNames; ++k) {
+    aNb=(Standard_Size)myNbRows[k];
+    aNbBytes+=aNb*sizeof(Standard_Integer);
+    aNbBytes+=aNb*NbColumns((GEOMAlgo_KindOfName)k)*sizeof(Standard_Real);
+  }
+  return aNbBytes;
+}
+//=======================================================================
+//function : HasField
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_ShapeInfoStore::HasField
+  (const GEOMAlgo_KindOfName aKN,
+   const Field aF)
+{
+  return (FieldGroups(aKN) & FieldGroup(aF))!=0;
+}
+//=======================================================================
+//function : ColumnIndex
+//purpose  : the number of the used fields before aF or -1
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::ColumnIndex
+  (const GEOMAlgo_KindOfName aKN,
+   const Field aF)
+{
+  Standard_Integer i, iC, aGroups;
+  //
+  aGroups=FieldGroups(aKN);
+  if (!(aGroups & FieldGroup(aF))) {
+    return -1;
+  }
+  //
+  iC=0;
+  for (i=0; i<aF; ++i) {
+    if (aGroups & FieldGroup((Field)i)) {
+      ++iC;
+    }
+  }
+  return iC;
+}
+//=======================================================================
+//function : NbColumns
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_ShapeInfoStore::NbColumns
+  (const GEOMAlgo_KindOfName aKN)
+{
+  Standard_Integer i, aNbC, aGroups;
+  //
+  aGroups=FieldGroups(aKN);
+  aNbC=0;
+  for (i=0; i<NbFields; ++i) {
+    if (aGroups & FieldGroup((Field)i)) {
+      ++aNbC;
+    }
+  }
+  return aNbC;
+}
+//=======================================================================
+//function : FieldGroup
+//purpose  :
+//=======================================================================
+Standard_Integer FieldGroup(const GEOMAlgo_ShapeInfoStore::Field aF)
+{
+  switch (aF) {
+    case GEOMAlgo_ShapeInfoStore::LocationX:
+    case GEOMAlgo_ShapeInfoStore::LocationY:
+    case GEOMAlgo_ShapeInfoStore::LocationZ:
+      return GEOMAlgo_FG_LOCATION;
+    case GEOMAlgo_ShapeInfoStore::DirectionX:
+    case GEOMAlgo_ShapeInfoStore::DirectionY:
+    case GEOMAlgo_ShapeInfoStore::DirectionZ:
+      return GEOMAlgo_FG_DIRECTION;
+    case GEOMAlgo_ShapeInfoStore::OriginX:
+    case GEOMAlgo_ShapeInfoStore::OriginY:
+    case GEOMAlgo_ShapeInfoStore::OriginZ:
+    case GEOMAlgo_ShapeInfoStore::AxisX:
+    case GEOMAlgo_ShapeInfoStore::AxisY:
+    case GEOMAlgo_ShapeInfoStore::AxisZ:
+    case GEOMAlgo_ShapeInfoStore::XAxisX:
+    case GEOMAlgo_ShapeInfoStore::XAxisY:
+    case GEOMAlgo_ShapeInfoStore::XAxisZ:
+      return GEOMAlgo_FG_POSITION;
+    case GEOMAlgo_ShapeInfoStore::Radius1:
+      return GEOMAlgo_FG_RADIUS1;
+    case GEOMAlgo_ShapeInfoStore::Radius2:
+      return GEOMAlgo_FG_RADIUS2;
+    case GEOMAlgo_ShapeInfoStore::Length:
+      return GEOMAlgo_FG_LENGTH;
+    case GEOMAlgo_ShapeInfoStore::Width:
+      return GEOMAlgo_FG_WIDTH;
+    case GEOMAlgo_ShapeInfoStore::Height:
+      return GEOMAlgo_FG_HEIGHT;
+    case GEOMAlgo_ShapeInfoStore::Pnt1X:
+    case GEOMAlgo_ShapeInfoStore::Pnt1Y:
+    case GEOMAlgo_ShapeInfoStore::Pnt1Z:
+      return GEOMAlgo_FG_PNT1;
+    case GEOMAlgo_ShapeInfoStore::Pnt2X:
+    case GEOMAlgo_ShapeInfoStore::Pnt2Y:
+    case GEOMAlgo_ShapeInfoStore::Pnt2Z:
+      return GEOMAlgo_FG_PNT2;
+    default:
+      break;
+  }
+  return 0;
+}
+//=======================================================================
+//function : FieldGroups
+//purpose  : the fields that are set by GEOMAlgo_ShapeInfoFiller
+//           for the kind of name aKN
+//=======================================================================
+Standard_Integer FieldGroups(const GEOMAlgo_KindOfName aKN)
+{
+  Standard_Integer aLP;
+  //
+  aLP=GEOMAlgo_FG_LOCATION|GEOMAlgo_FG_POSITION;
+  switch (aKN) {
+    case GEOMAlgo_KN_SPHERE:
+    case GEOMAlgo_KN_DISKCIRCLE:
+      return aLP|GEOMAlgo_FG_RADIUS1;
+    case GEOMAlgo_KN_CYLINDER:
+      return aLP|GEOMAlgo_FG_RADIUS1|GEOMAlgo_FG_HEIGHT;
+    case GEOMAlgo_KN_TORUS:
+    case GEOMAlgo_KN_DISKELLIPSE:
+      return aLP|GEOMAlgo_FG_RADIUS1|GEOMAlgo_FG_RADIUS2;
+    case GEOMAlgo_KN_CONE:
+      return aLP|GEOMAlgo_FG_RADIUS1|GEOMAlgo_FG_RADIUS2|GEOMAlgo_FG_HEIGHT;
+    case GEOMAlgo_KN_CIRCLE:
+    case GEOMAlgo_KN_ARCCIRCLE:
+      return aLP|GEOMAlgo_FG_RADIUS1|GEOMAlgo_FG_PNT1|GEOMAlgo_FG_PNT2;
+    case GEOMAlgo_KN_ELLIPSE:
+    case GEOMAlgo_KN_ARCELLIPSE:
+      return aLP|GEOMAlgo_FG_RADIUS1|GEOMAlgo_FG_RADIUS2|
+        GEOMAlgo_FG_PNT1|GEOMAlgo_FG_PNT2;
+    case GEOMAlgo_KN_PLANE:
+    case GEOMAlgo_KN_POLYGON:
+    case GEOMAlgo_KN_TRIANGLE:
+    case GEOMAlgo_KN_QUADRANGLE:
+      return aLP;
+    case GEOMAlgo_KN_RECTANGLE:
+      return aLP|GEOMAlgo_FG_LENGTH|GEOMAlgo_FG_WIDTH;
+    case GEOMAlgo_KN_BOX:
+      return aLP|GEOMAlgo_FG_LENGTH|GEOMAlgo_FG_WIDTH|GEOMAlgo_FG_HEIGHT;
+    case GEOMAlgo_KN_LINE:
+      return GEOMAlgo_FG_LOCATION|GEOMAlgo_FG_DIRECTION;
+    case GEOMAlgo_KN_SEGMENT:
+      return GEOMAlgo_FG_LOCATION|GEOMAlgo_FG_DIRECTION|GEOMAlgo_FG_LENGTH|
+        GEOMAlgo_FG_PNT1|GEOMAlgo_FG_PNT2;
+    default:
+      break;
+  }
+  // the vertices and the other shapes
+  return GEOMAlgo_FG_LOCATION;
+}
@@ -0,0 +1,190 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_ShapeInfoStore.hxx
+//
+#ifndef _GEOMAlgo_ShapeInfoStore_HeaderFile
+#define _GEOMAlgo_ShapeInfoStore_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Real.hxx>
+#include <Standard_Byte.hxx>
+
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include <NCollection_Array1.hxx>
+
+#include <GEOMAlgo_KindOfShape.hxx>
+#include <GEOMAlgo_KindOfName.hxx>
+#include <GEOMAlgo_KindOfBounds.hxx>
+#include <GEOMAlgo_KindOfClosed.hxx>
+#include <GEOMAlgo_KindOfDef.hxx>
+#include <GEOMAlgo_ShapeInfo.hxx>
+#include <GEOMAlgo_IndexedDataMapOfShapeShapeInfo.hxx>
+
+//=======================================================================
+//class    : GEOMAlgo_ShapeInfoStore
+//purpose  : The compact copy of the records of GEOMAlgo_ShapeInfoFiller.
+//           The shapes have the dense ids 1..Extent().
+//           The records of each kind of name are kept in a table,
+//           the table has one contiguous column of the values for
+//           each field that is used by the kind, e.g. the cylinders
+//           have the columns of the location, of the position, of the
+//           radius and of the height only.
+//           The position (gp_Ax3) is kept as the origin, the main
+//           direction (Axis) and the X direction (XAxis).
+//           The numbers of the sub-shapes are not kept.
+//=======================================================================
+class GEOMAlgo_ShapeInfoStore
+{
+ public:
+  //! The fields of the record <br>
+  enum Field {
+    LocationX, LocationY, LocationZ,
+    DirectionX, DirectionY, DirectionZ,
+    OriginX, OriginY, OriginZ,
+    AxisX, AxisY, AxisZ,
+    XAxisX, XAxisY, XAxisZ,
+    Radius1,
+    Radius2,
+    Length,
+    Width,
+    Height,
+    Pnt1X, Pnt1Y, Pnt1Z,
+    Pnt2X, Pnt2Y, Pnt2Z,
+    NbFields
+  };
+
+  Standard_EXPORT
+    GEOMAlgo_ShapeInfoStore();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_ShapeInfoStore();
+
+  Standard_EXPORT
+    void Clear() ;
+
+  //! Copies the records of aMapInfo, the id of the shape is <br>
+  //!          its index in aMapInfo. <br>
+  Standard_EXPORT
+    void Build(const GEOMAlgo_IndexedDataMapOfShapeShapeInfo& aMapInfo) ;
+
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns the id of aS or 0 <br>
+  Standard_EXPORT
+    Standard_Integer Index(const TopoDS_Shape& aS) const;
+
+  Standard_EXPORT
+    const TopoDS_Shape& Shape(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    TopAbs_ShapeEnum Type(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfShape KindOfShape(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfName KindOfName(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfBounds KindOfBounds(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfClosed KindOfClosed(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    GEOMAlgo_KindOfDef KindOfDef(const Standard_Integer aId) const;
+
+  //! Returns the row of the shape aId in the table of its <br>
+  //!          kind of name, 0 <= row < NbRows(KindOfName(aId)) <br>
+  Standard_EXPORT
+    Standard_Integer Row(const Standard_Integer aId) const;
+
+  Standard_EXPORT
+    Standard_Integer NbRows(const GEOMAlgo_KindOfName aKN) const;
+
+  //! Returns the ids of the rows of the table aKN, <br>
+  //!          NbRows(aKN) values or NULL <br>
+  Standard_EXPORT
+    const Standard_Integer* Ids(const GEOMAlgo_KindOfName aKN) const;
+
+  //! Returns True if the records of the kind aKN have the field aF <br>
+  Standard_EXPORT
+    static  Standard_Boolean HasField(const GEOMAlgo_KindOfName aKN,
+                                      const Field aF) ;
+
+  //! Returns the values of the field aF of the table aKN, <br>
+  //!          NbRows(aKN) values or NULL if the kind has not <br>
+  //!          the field <br>
+  Standard_EXPORT
+    const Standard_Real* Column(const GEOMAlgo_KindOfName aKN,
+                                const Field aF) const;
+
+  //! Returns the value of the field aF of the shape aId, <br>
+  //!          0. if the kind of the shape has not the field <br>
+  Standard_EXPORT
+    Standard_Real Value(const Standard_Integer aId,
+                        const Field aF) const;
+
+  //! Restores the record of the shape aId, the fields that are <br>
+  //!          not kept have the default values <br>
+  Standard_EXPORT
+    void Info(const Standard_Integer aId,
+              GEOMAlgo_ShapeInfo& aInfo) const;
+
+  //! Returns the size of the arrays in bytes <br>
+  Standard_EXPORT
+    Standard_Size NbBytes() const;
+
+ protected:
+  Standard_EXPORT
+    static  Standard_Integer ColumnIndex(const GEOMAlgo_KindOfName aKN,
+                                         const Field aF) ;
+
+  Standard_EXPORT
+    static  Standard_Integer NbColumns(const GEOMAlgo_KindOfName aKN) ;
+
+  Standard_EXPORT
+    void SetValue(const GEOMAlgo_KindOfName aKN,
+                  const Standard_Integer aRow,
+                  const Field aF,
+                  const Standard_Real aValue) ;
+
+  enum {
+    NbNames=GEOMAlgo_KN_SOLID+1
+  };
+
+  TopTools_IndexedMapOfShape myShapes;
+  NCollection_Array1<Standard_Byte> myTypes;
+  NCollection_Array1<Standard_Byte> myKindsOfShape;
+  NCollection_Array1<Standard_Byte> myKindsOfName;
+  NCollection_Array1<Standard_Byte> myKindsOfBounds;
+  NCollection_Array1<Standard_Byte> myKindsOfClosed;
+  NCollection_Array1<Standard_Byte> myKindsOfDef;
+  NCollection_Array1<Standard_Integer> myRows;
+  Standard_Integer myNbRows[NbNames];
+  NCollection_Array1<Standard_Integer> myIds[NbNames];
+  NCollection_Array1<Standard_Real> myColumns[NbNames];
+};
+#endif
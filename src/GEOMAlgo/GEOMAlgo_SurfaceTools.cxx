@@ -42,6 +42,7 @@
 #include <GeomAbs_SurfaceType.hxx>
 #include <GeomAdaptor_Surface.hxx>
 #include <IntSurf_Quadric.hxx>
+#include <Bnd_Box.hxx>
 
 
 //=======================================================================
@@ -113,6 +114,114 @@
   return iErr;
 }
 //=======================================================================
+//function : GetState
+//purpose  : the distance of IntSurf_Quadric is linear in the points
+//           for the plane, convex for the cylinder and the sphere,
+//           so the maximum is reached in a corner of the box
+//=======================================================================
+Standard_Integer GEOMAlgo_SurfaceTools::GetState
+  (const Bnd_Box& aBox,
+   const GeomAdaptor_Surface& aGAS,
+   const Standard_Real aTol,
+   TopAbs_State& aState)
+{
+  Standard_Integer i, iErr;
+  Standard_Real aDMin, aDMax, aD, aR, aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  GeomAbs_SurfaceType aType;
+  gp_Pnt aP, aPC;
+  //
+  iErr=0;
+  aState=TopAbs_UNKNOWN;
+  if (aBox.IsVoid() || aBox.IsOpen()) {
+    return iErr;
+  }
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  aPC.SetCoord(0.5*(aXmin+aXmax), 0.5*(aYmin+aYmax), 0.5*(aZmin+aZmax));
+  //
+  aType=aGAS.GetType();
+  switch (aType) {
+  case GeomAbs_Plane:
+    DistanceRange(aBox, aGAS.Plane(), aDMin, aDMax);
+    break;
+
+  case GeomAbs_Cylinder: {
+    const gp_Cylinder aCyl=aGAS.Cylinder();
+    const gp_Lin aLin(aCyl.Axis());
+    //
+    aR=aCyl.Radius();
+    aDMax=-aR;
+    for (i=0; i<8; ++i) {
+      aP.SetCoord((i&1) ? aXmax : aXmin,
+                  (i&2) ? aYmax : aYmin,
+                  (i&4) ? aZmax : aZmin);
+      aD=aLin.Distance(aP)-aR;
+      if (aD>aDMax) {
+        aDMax=aD;
+      }
+    }
+    // the sphere around the box
+    aD=0.5*sqrt((aXmax-aXmin)*(aXmax-aXmin)+
+                (aYmax-aYmin)*(aYmax-aYmin)+
+                (aZmax-aZmin)*(aZmax-aZmin));
+    aDMin=aLin.Distance(aPC)-aD;
+    if (aDMin<0.) {
+      aDMin=0.;
+    }
+    aDMin-=aR;
+    break;
+  }
+
+  case GeomAbs_Sphere: {
+    const gp_Sphere aSph=aGAS.Sphere();
+    const gp_Pnt& aC=aSph.Location();
+    Standard_Real dX, dY, dZ;
+    //
+    aR=aSph.Radius();
+    dX=Max(Max(aXmin-aC.X(), aC.X()-aXmax), 0.);
+    dY=Max(Max(aYmin-aC.Y(), aC.Y()-aYmax), 0.);
+    dZ=Max(Max(aZmin-aC.Z(), aC.Z()-aZmax), 0.);
+    aDMin=sqrt(dX*dX+dY*dY+dZ*dZ)-aR;
+    //
+    dX=Max(Abs(aXmin-aC.X()), Abs(aXmax-aC.X()));
+    dY=Max(Abs(aYmin-aC.Y()), Abs(aYmax-aC.Y()));
+    dZ=Max(Abs(aZmin-aC.Z()), Abs(aZmax-aC.Z()));
+    aDMax=sqrt(dX*dX+dY*dY+dZ*dZ)-aR;
+    break;
+  }
+
+  default:
+    iErr=1; // unprocessed surface type
+    return iErr;
+  }
+  //
+  if (aDMin > aTol) {
+    aState=TopAbs_OUT;
+  }
+  else if (aDMax < -aTol) {
+    aState=TopAbs_IN;
+  }
+  return iErr;
+}
+//=======================================================================
+//function : DistanceRange
+//purpose  :
+//=======================================================================
+void GEOMAlgo_SurfaceTools::DistanceRange(const Bnd_Box& aBox,
+                                          const gp_Pln& aPln,
+                                          Standard_Real& aDMin,
+                                          Standard_Real& aDMax)
+{
+  Standard_Real aA, aB, aC, aD, aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+  //
+  aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+  aPln.Coefficients(aA, aB, aC, aD);
+  //
+  aDMin=aD+Min(aA*aXmin, aA*aXmax)+Min(aB*aYmin, aB*aYmax)+
+    Min(aC*aZmin, aC*aZmax);
+  aDMax=aD+Max(aA*aXmin, aA*aXmax)+Max(aB*aYmin, aB*aYmax)+
+    Max(aC*aZmin, aC*aZmax);
+}
+//=======================================================================
 //function : ReverseState
 //purpose  :
 //=======================================================================
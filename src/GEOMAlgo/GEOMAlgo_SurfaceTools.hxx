@@ -41,6 +41,7 @@
 #include <GeomAdaptor_Surface.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Sphere.hxx>
+#include <Bnd_Box.hxx>
 
 
 //=======================================================================
@@ -74,6 +75,24 @@ class GEOMAlgo_SurfaceTools
                                       const Standard_Real aTol,
                                       TopAbs_State& aSt) ;
 
+  //! Computes the state of all points of the box aBox relative to <br>
+  //!          the surface aS as GetState() for a point does: aSt is <br>
+  //!          IN or OUT if all points of aBox have this state, <br>
+  //!          UNKNOWN otherwise. Returns 1 for unprocessed surface type. <br>
+  Standard_EXPORT
+    static  Standard_Integer GetState(const Bnd_Box& aBox,
+                                      const GeomAdaptor_Surface& aS,
+                                      const Standard_Real aTol,
+                                      TopAbs_State& aSt) ;
+
+  //! Computes the range [aDMin, aDMax] of the signed distance from <br>
+  //!          the points of the box aBox to the plane aPln. <br>
+  Standard_EXPORT
+    static  void DistanceRange(const Bnd_Box& aBox,
+                               const gp_Pln& aPln,
+                               Standard_Real& aDMin,
+                               Standard_Real& aDMax) ;
+
   Standard_EXPORT
     static  TopAbs_State ReverseState(const TopAbs_State aSt) ;
 
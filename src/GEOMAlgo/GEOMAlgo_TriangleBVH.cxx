@@ -0,0 +1,456 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_TriangleBVH.cxx
+//
+#include <GEOMAlgo_TriangleBVH.hxx>
+
+#include <math.h>
+#include <algorithm>
+
+IMPLEMENT_STANDARD_RTTIEXT(GEOMAlgo_TriangleBVH, Standard_Transient);
+
+namespace {
+  // the number of the triangles in a leaf
+  const Standard_Integer NbLeafTriangles=4;
+  // the depth of the tree is not greater than it
+  const Standard_Integer NbMaxDepth=128;
+  // the relative tolerance of the ray/triangle intersection
+  const Standard_Real RayEps=1.e-9;
+  // the direction of the rays, not parallel to the usual planes
+  const Standard_Real RayDir[3]={
+    0.48367953652934, 0.59238261493802, 0.64433812747103
+  };
+
+  //=====================================================================
+  //class    : CentreLess
+  //purpose  : compares the centres of the triangles along an axis
+  //=====================================================================
+  struct CentreLess
+  {
+    CentreLess(const Standard_Real* pCentres,
+               const Standard_Integer iAxis)
+    : myCentres(pCentres), myAxis(iAxis) {}
+    //
+    bool operator()(const Standard_Integer i1,
+                    const Standard_Integer i2) const
+    {
+      return myCentres[3*i1+myAxis] < myCentres[3*i2+myAxis];
+    }
+    //
+    const Standard_Real* myCentres;
+    Standard_Integer myAxis;
+  };
+
+  //=====================================================================
+  //function : SquareDistance
+  //purpose  : the square distance from aP to the triangle pT
+  //           (Ericson, Real-Time Collision Detection, 5.1.5)
+  //=====================================================================
+  Standard_Real SquareDistance(const Standard_Real* aP,
+                               const Standard_Real* pT)
+  {
+    Standard_Integer k;
+    Standard_Real ab[3], ac[3], ap[3], bp[3], cp[3], aQ[3], d1, d2, d3, d4,
+      d5, d6, va, vb, vc, v, w, aD2, aD;
+    const Standard_Real* a=pT;
+    const Standard_Real* b=pT+3;
+    const Standard_Real* c=pT+6;
+    //
+    for (k=0; k<3; ++k) {
+      ab[k]=b[k]-a[k];
+      ac[k]=c[k]-a[k];
+      ap[k]=aP[k]-a[k];
+    }
+    d1=ab[0]*ap[0]+ab[1]*ap[1]+ab[2]*ap[2];
+    d2=ac[0]*ap[0]+ac[1]*ap[1]+ac[2]*ap[2];
+    if (d1<=0. && d2<=0.) {
+      for (k=0; k<3; ++k) aQ[k]=a[k];
+    }
+    else {
+      for (k=0; k<3; ++k) bp[k]=aP[k]-b[k];
+      d3=ab[0]*bp[0]+ab[1]*bp[1]+ab[2]*bp[2];
+      d4=ac[0]*bp[0]+ac[1]*bp[1]+ac[2]*bp[2];
+      for (k=0; k<3; ++k) cp[k]=aP[k]-c[k];
+      d5=ab[0]*cp[0]+ab[1]*cp[1]+ab[2]*cp[2];
+      d6=ac[0]*cp[0]+ac[1]*cp[1]+ac[2]*cp[2];
+      vc=d1*d4-d3*d2;
+      vb=d5*d2-d1*d6;
+      va=d3*d6-d5*d4;
+      //
+      if (d3>=0. && d4<=d3) {
+        for (k=0; k<3; ++k) aQ[k]=b[k];
+      }
+      else if (vc<=0. && d1>=0. && d3<=0.) {
+        v=d1/(d1-d3);
+        for (k=0; k<3; ++k) aQ[k]=a[k]+v*ab[k];
+      }
+      else if (d6>=0. && d5<=d6) {
+        for (k=0; k<3; ++k) aQ[k]=c[k];
+      }
+      else if (vb<=0. && d2>=0. && d6<=0.) {
+        w=d2/(d2-d6);
+        for (k=0; k<3; ++k) aQ[k]=a[k]+w*ac[k];
+      }
+      else if (va<=0. && (d4-d3)>=0. && (d5-d6)>=0.) {
+        w=(d4-d3)/((d4-d3)+(d5-d6));
+        for (k=0; k<3; ++k) aQ[k]=b[k]+w*(c[k]-b[k]);
+      }
+      else {
+        aD=va+vb+vc;
+        if (aD<=0.) {
+          // degenerated triangle, take the vertex a
+          for (k=0; k<3; ++k) aQ[k]=a[k];
+        }
+        else {
+          v=vb/aD;
+          w=vc/aD;
+          for (k=0; k<3; ++k) aQ[k]=a[k]+ab[k]*v+ac[k]*w;
+        }
+      }
+    }
+    //
+    aD2=0.;
+    for (k=0; k<3; ++k) {
+      aD=aP[k]-aQ[k];
+      aD2+=aD*aD;
+    }
+    return aD2;
+  }
+}
+
+//=======================================================================
+//function : GEOMAlgo_TriangleBVH
+//purpose  :
+//=======================================================================
+GEOMAlgo_TriangleBVH::GEOMAlgo_TriangleBVH()
+{
+}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_TriangleBVH::~GEOMAlgo_TriangleBVH()
+{
+}
+//=======================================================================
+//function : Clear
+//purpose  :
+//=======================================================================
+void GEOMAlgo_TriangleBVH::Clear()
+{
+  myCoords.clear();
+  myNodes.clear();
+}
+//=======================================================================
+//function : AddTriangle
+//purpose  :
+//=======================================================================
+void GEOMAlgo_TriangleBVH::AddTriangle(const gp_Pnt& aP1,
+                                       const gp_Pnt& aP2,
+                                       const gp_Pnt& aP3)
+{
+  const gp_Pnt* pP[3]={&aP1, &aP2, &aP3};
+  Standard_Integer i;
+  //
+  for (i=0; i<3; ++i) {
+    myCoords.push_back(pP[i]->X());
+    myCoords.push_back(pP[i]->Y());
+    myCoords.push_back(pP[i]->Z());
+  }
+}
+//=======================================================================
+//function : Build
+//purpose  :
+//=======================================================================
+void GEOMAlgo_TriangleBVH::Build()
+{
+  Standard_Integer i, j, k, aNbT, aNbS, iNode, iAxis, iMid, aStack[NbMaxDepth];
+  Standard_Real aCMin[3], aCMax[3], aC;
+  std::vector<Standard_Integer> aOrder;
+  std::vector<Standard_Real> aCentres, aCoords;
+  //
+  myNodes.clear();
+  aNbT=NbTriangles();
+  if (!aNbT) {
+    return;
+  }
+  //
+  aOrder.resize(aNbT);
+  aCentres.resize(3*aNbT);
+  for (i=0; i<aNbT; ++i) {
+    aOrder[i]=i;
+    for (k=0; k<3; ++k) {
+      aCentres[3*i+k]=(myCoords[9*i+k]+myCoords[9*i+3+k]+
+                       myCoords[9*i+6+k])/3.;
+    }
+  }
+  //
+  Node aRoot;
+  aRoot.myLeft=-1;
+  aRoot.myRight=-1;
+  aRoot.myFirst=0;
+  aRoot.myLast=aNbT;
+  myNodes.push_back(aRoot);
+  //
+  aNbS=0;
+  aStack[aNbS++]=0;
+  while (aNbS) {
+    iNode=aStack[--aNbS];
+    const Standard_Integer iFirst=myNodes[iNode].myFirst;
+    const Standard_Integer iLast=myNodes[iNode].myLast;
+    //
+    // the box of the triangles and of their centres
+    {
+      Node& aNode=myNodes[iNode];
+      for (k=0; k<3; ++k) {
+        aNode.myMin[k]=RealLast();
+        aNode.myMax[k]=RealFirst();
+        aCMin[k]=RealLast();
+        aCMax[k]=RealFirst();
+      }
+      for (i=iFirst; i<iLast; ++i) {
+        const Standard_Integer iT=aOrder[i];
+        for (j=0; j<3; ++j) {
+          for (k=0; k<3; ++k) {
+            aC=myCoords[9*iT+3*j+k];
+            aNode.myMin[k]=Min(aNode.myMin[k], aC);
+            aNode.myMax[k]=Max(aNode.myMax[k], aC);
+          }
+        }
+        for (k=0; k<3; ++k) {
+          aC=aCentres[3*iT+k];
+          aCMin[k]=Min(aCMin[k], aC);
+          aCMax[k]=Max(aCMax[k], aC);
+        }
+      }
+    }
+    //
+    if (iLast-iFirst<=NbLeafTriangles || aNbS+2>NbMaxDepth) {
+      continue;
+    }
+    //
+    iAxis=0;
+    for (k=1; k<3; ++k) {
+      if (aCMax[k]-aCMin[k] > aCMax[iAxis]-aCMin[iAxis]) {
+        iAxis=k;
+      }
+    }
+    //
+    iMid=(iFirst+iLast)/2;
+    std::nth_element(aOrder.begin()+iFirst, aOrder.begin()+iMid,
+                     aOrder.begin()+iLast,
+                     CentreLess(&aCentres[0], iAxis));
+    //
+    Node aLeft, aRight;
+    aLeft.myLeft=aLeft.myRight=-1;
+    aLeft.myFirst=iFirst;
+    aLeft.myLast=iMid;
+    aRight.myLeft=aRight.myRight=-1;
+    aRight.myFirst=iMid;
+    aRight.myLast=iLast;
+    //
+    myNodes[iNode].myLeft=(Standard_Integer)myNodes.size();
+    myNodes.push_back(aLeft);
+    myNodes[iNode].myRight=(Standard_Integer)myNodes.size();
+    myNodes.push_back(aRight);
+    //
+    aStack[aNbS++]=myNodes[iNode].myLeft;
+    aStack[aNbS++]=myNodes[iNode].myRight;
+  }
+  //
+  // the triangles of a leaf are consecutive
+  aCoords.resize(myCoords.size());
+  for (i=0; i<aNbT; ++i) {
+    for (k=0; k<9; ++k) {
+      aCoords[9*i+k]=myCoords[9*aOrder[i]+k];
+    }
+  }
+  myCoords.swap(aCoords);
+}
+//=======================================================================
+//function : IsOut
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_TriangleBVH::IsOut(const gp_Pnt& aP,
+                                             const Standard_Real aD) const
+{
+  if (myNodes.empty()) {
+    return Standard_True;
+  }
+  //
+  const Node& aRoot=myNodes[0];
+  return (aP.X() < aRoot.myMin[0]-aD || aP.X() > aRoot.myMax[0]+aD ||
+          aP.Y() < aRoot.myMin[1]-aD || aP.Y() > aRoot.myMax[1]+aD ||
+          aP.Z() < aRoot.myMin[2]-aD || aP.Z() > aRoot.myMax[2]+aD);
+}
+//=======================================================================
+//function : IsNear
+//purpose  :
+//=======================================================================
+Standard_Boolean GEOMAlgo_TriangleBVH::IsNear(const gp_Pnt& aP,
+                                              const Standard_Real aD) const
+{
+  Standard_Integer i, k, aNbS, aStack[NbMaxDepth];
+  Standard_Real aXYZ[3], aD2, aDB2, aDx;
+  //
+  if (myNodes.empty()) {
+    return Standard_False;
+  }
+  //
+  aXYZ[0]=aP.X();
+  aXYZ[1]=aP.Y();
+  aXYZ[2]=aP.Z();
+  aD2=aD*aD;
+  //
+  aNbS=0;
+  aStack[aNbS++]=0;
+  while (aNbS) {
+    const Node& aNode=myNodes[aStack[--aNbS]];
+    //
+    aDB2=0.;
+    for (k=0; k<3; ++k) {
+      aDx=0.;
+      if (aXYZ[k]<aNode.myMin[k]) {
+        aDx=aNode.myMin[k]-aXYZ[k];
+      }
+      else if (aXYZ[k]>aNode.myMax[k]) {
+        aDx=aXYZ[k]-aNode.myMax[k];
+      }
+      aDB2+=aDx*aDx;
+    }
+    if (aDB2>aD2) {
+      continue;
+    }
+    //
+    if (aNode.myLeft<0) {
+      for (i=aNode.myFirst; i<aNode.myLast; ++i) {
+        if (SquareDistance(aXYZ, &myCoords[9*i])<=aD2) {
+          return Standard_True;
+        }
+      }
+      continue;
+    }
+    aStack[aNbS++]=aNode.myLeft;
+    aStack[aNbS++]=aNode.myRight;
+  }
+  return Standard_False;
+}
+//=======================================================================
+//function : NbRayHits
+//purpose  : Moller-Trumbore intersection of the ray with the triangles
+//           whose boxes the ray crosses
+//=======================================================================
+Standard_Integer GEOMAlgo_TriangleBVH::NbRayHits
+  (const gp_Pnt& aP,
+   Standard_Boolean& bIsDegenerated) const
+{
+  Standard_Integer i, k, aNbS, aNbHits, aStack[NbMaxDepth];
+  Standard_Real aO[3], aInvD[3], aT1, aT2, aTMin, aTMax, e1[3], e2[3],
+    aPV[3], aTV[3], aQV[3], aDet, aInvDet, u, v, t, aL1, aL2;
+  //
+  bIsDegenerated=Standard_False;
+  aNbHits=0;
+  if (myNodes.empty()) {
+    return aNbHits;
+  }
+  //
+  aO[0]=aP.X();
+  aO[1]=aP.Y();
+  aO[2]=aP.Z();
+  for (k=0; k<3; ++k) {
+    aInvD[k]=1./RayDir[k];
+  }
+  //
+  aNbS=0;
+  aStack[aNbS++]=0;
+  while (aNbS) {
+    const Node& aNode=myNodes[aStack[--aNbS]];
+    //
+    // the ray and the box
+    aTMin=0.;
+    aTMax=RealLast();
+    for (k=0; k<3; ++k) {
+      aT1=(aNode.myMin[k]-aO[k])*aInvD[k];
+      aT2=(aNode.myMax[k]-aO[k])*aInvD[k];
+      aTMin=Max(aTMin, Min(aT1, aT2));
+      aTMax=Min(aTMax, Max(aT1, aT2));
+    }
+    if (aTMin>aTMax) {
+      continue;
+    }
+    //
+    if (aNode.myLeft>=0) {
+      aStack[aNbS++]=aNode.myLeft;
+      aStack[aNbS++]=aNode.myRight;
+      continue;
+    }
+    //
+    for (i=aNode.myFirst; i<aNode.myLast; ++i) {
+      const Standard_Real* pT=&myCoords[9*i];
+      for (k=0; k<3; ++k) {
+        e1[k]=pT[3+k]-pT[k];
+        e2[k]=pT[6+k]-pT[k];
+        aTV[k]=aO[k]-pT[k];
+      }
+      aPV[0]=RayDir[1]*e2[2]-RayDir[2]*e2[1];
+      aPV[1]=RayDir[2]*e2[0]-RayDir[0]*e2[2];
+      aPV[2]=RayDir[0]*e2[1]-RayDir[1]*e2[0];
+      aDet=e1[0]*aPV[0]+e1[1]*aPV[1]+e1[2]*aPV[2];
+      //
+      aL1=sqrt(e1[0]*e1[0]+e1[1]*e1[1]+e1[2]*e1[2]);
+      aL2=sqrt(e2[0]*e2[0]+e2[1]*e2[1]+e2[2]*e2[2]);
+      if (fabs(aDet)<=RayEps*aL1*aL2) {
+        // the ray is parallel to the triangle
+        aQV[0]=e1[1]*e2[2]-e1[2]*e2[1];
+        aQV[1]=e1[2]*e2[0]-e1[0]*e2[2];
+        aQV[2]=e1[0]*e2[1]-e1[1]*e2[0];
+        if (fabs(aQV[0]*aTV[0]+aQV[1]*aTV[1]+aQV[2]*aTV[2]) <=
+            RayEps*aL1*aL2*(aL1+aL2)) {
+          bIsDegenerated=Standard_True; // along the triangle
+        }
+        continue;
+      }
+      aInvDet=1./aDet;
+      //
+      u=(aTV[0]*aPV[0]+aTV[1]*aPV[1]+aTV[2]*aPV[2])*aInvDet;
+      if (u<-RayEps || u>1.+RayEps) {
+        continue;
+      }
+      aQV[0]=aTV[1]*e1[2]-aTV[2]*e1[1];
+      aQV[1]=aTV[2]*e1[0]-aTV[0]*e1[2];
+      aQV[2]=aTV[0]*e1[1]-aTV[1]*e1[0];
+      v=(RayDir[0]*aQV[0]+RayDir[1]*aQV[1]+RayDir[2]*aQV[2])*aInvDet;
+      if (v<-RayEps || u+v>1.+RayEps) {
+        continue;
+      }
+      t=(e2[0]*aQV[0]+e2[1]*aQV[1]+e2[2]*aQV[2])*aInvDet;
+      if (t<0.) {
+        continue;
+      }
+      //
+      if (u<RayEps || v<RayEps || u+v>1.-RayEps) {
+        bIsDegenerated=Standard_True; // an edge or a vertex
+        continue;
+      }
+      ++aNbHits;
+    }
+  }
+  return aNbHits;
+}
@@ -0,0 +1,109 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+//
+// File:        GEOMAlgo_TriangleBVH.hxx
+//
+#ifndef _GEOMAlgo_TriangleBVH_HeaderFile
+#define _GEOMAlgo_TriangleBVH_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_DefineHandle.hxx>
+#include <Standard_Transient.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Boolean.hxx>
+#include <Standard_Real.hxx>
+#include <gp_Pnt.hxx>
+
+#include <vector>
+
+DEFINE_STANDARD_HANDLE(GEOMAlgo_TriangleBVH, Standard_Transient);
+
+//=======================================================================
+//class    : GEOMAlgo_TriangleBVH
+//purpose  : Bounding volume hierarchy of a set of triangles in 3D,
+//           built once, then queried from any number of threads:
+//           - is there a triangle closer than a distance to a point;
+//           - how many triangles the ray from a point crosses.
+//           The tree is split at the median of the centres of the
+//           triangles along the longest side of their box.
+//=======================================================================
+class GEOMAlgo_TriangleBVH : public Standard_Transient
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_TriangleBVH();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_TriangleBVH();
+
+  Standard_EXPORT
+    void Clear() ;
+
+  Standard_EXPORT
+    void AddTriangle(const gp_Pnt& aP1,
+                     const gp_Pnt& aP2,
+                     const gp_Pnt& aP3) ;
+
+  //! Builds the tree, the triangles can not be added after it <br>
+  Standard_EXPORT
+    void Build() ;
+
+  Standard_Integer NbTriangles() const {
+    return (Standard_Integer)(myCoords.size()/9);
+  }
+
+  //! Returns True if the distance from aP to the box of all <br>
+  //!          triangles is greater than aD <br>
+  Standard_EXPORT
+    Standard_Boolean IsOut(const gp_Pnt& aP,
+                           const Standard_Real aD) const;
+
+  //! Returns True if there is a triangle at the distance not <br>
+  //!          greater than aD from aP <br>
+  Standard_EXPORT
+    Standard_Boolean IsNear(const gp_Pnt& aP,
+                            const Standard_Real aD) const;
+
+  //! Returns the number of the triangles crossed by the ray from <br>
+  //!          aP in a fixed direction. bIsDegenerated is set if the <br>
+  //!          ray passes too close to an edge or a vertex of a triangle <br>
+  //!          or along a triangle, the number is not reliable then. <br>
+  Standard_EXPORT
+    Standard_Integer NbRayHits(const gp_Pnt& aP,
+                               Standard_Boolean& bIsDegenerated) const;
+
+  DEFINE_STANDARD_RTTIEXT(GEOMAlgo_TriangleBVH, Standard_Transient)
+
+ protected:
+  struct Node {
+    Standard_Real myMin[3];
+    Standard_Real myMax[3];
+    // the children, -1 for a leaf
+    Standard_Integer myLeft;
+    Standard_Integer myRight;
+    // the triangles of a leaf
+    Standard_Integer myFirst;
+    Standard_Integer myLast;
+  };
+
+  // 9 coordinates of each triangle
+  std::vector<Standard_Real> myCoords;
+  std::vector<Node> myNodes;
+};
+#endif
@@ -0,0 +1,177 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_UnionFind.cxx
+//
+#include <GEOMAlgo_UnionFind.hxx>
+
+//=======================================================================
+//function : GEOMAlgo_UnionFind
+//purpose  :
+//=======================================================================
+GEOMAlgo_UnionFind::GEOMAlgo_UnionFind()
+:
+  myNb(0),
+  myParent(NULL)
+{}
+//=======================================================================
+//function : ~
+//purpose  :
+//=======================================================================
+GEOMAlgo_UnionFind::~GEOMAlgo_UnionFind()
+{
+  delete [] myParent;
+}
+//=======================================================================
+//function : Init
+//purpose  :
+//=======================================================================
+void GEOMAlgo_UnionFind::Init(const Standard_Integer theNb)
+{
+  Standard_Integer i;
+  //
+  delete [] myParent;
+  myParent=NULL;
+  myNb=(theNb>0) ? theNb : 0;
+  //
+  myParent=new std::atomic<Standard_Integer>[myNb+1];
+  for (i=0; i<=myNb; ++i) {
+    myParent[i].store(i, std::memory_order_relaxed);
+  }
+}
+//=======================================================================
+//function : Extent
+//purpose  :
+//=======================================================================
+Standard_Integer GEOMAlgo_UnionFind::Extent()const
+{
+  return myNb;
+}
+//=======================================================================
+//function : Find
+//purpose  : path halving; a concurrent Union() only moves a root
+//           under a smaller root, so the shortcut written here never
+//           breaks a path
+//=======================================================================
+Standard_Integer GEOMAlgo_UnionFind::Find(const Standard_Integer theI)const
+{
+  Standard_Integer i, aP, aGP;
+  //
+  i=theI;
+  for (;;) {
+    aP=myParent[i].load(std::memory_order_acquire);
+    if (aP==i) {
+      return i;
+    }
+    aGP=myParent[aP].load(std::memory_order_acquire);
+    if (aGP!=aP) {
+      myParent[i].compare_exchange_weak(aP, aGP,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed);
+    }
+    i=aGP;
+  }
+}
+//=======================================================================
+//function : Union
+//purpose  : the root with the greater index is linked to the other one
+//=======================================================================
+Standard_Boolean GEOMAlgo_UnionFind::Union(const Standard_Integer theI,
+                                           const Standard_Integer theJ)
+{
+  Standard_Integer aRI, aRJ, aR;
+  //
+  aRI=theI;
+  aRJ=theJ;
+  for (;;) {
+    aRI=Find(aRI);
+    aRJ=Find(aRJ);
+    if (aRI==aRJ) {
+      return Standard_False;
+    }
+    if (aRI<aRJ) {
+      aR=aRI;
+      aRI=aRJ;
+      aRJ=aR;
+    }
+    // aRI > aRJ, aRI becomes the child of aRJ if it is still a root
+    aR=aRI;
+    if (myParent[aRI].compare_exchange_strong(aR, aRJ,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+      return Standard_True;
+    }
+  }
+}
+//=======================================================================
+//function : Sets
+//purpose  :
+//=======================================================================
+void GEOMAlgo_UnionFind::Sets
+  (Standard_Integer& theNbSets,
+   NCollection_Array1<Standard_Integer>& theOffsets,
+   NCollection_Array1<Standard_Integer>& theMembers)const
+{
+  Standard_Integer i, aR, aNbS;
+  //
+  theNbSets=0;
+  if (!myNb) {
+    return;
+  }
+  //
+  // 1. number of the set of each root, sizes of the sets
+  NCollection_Array1<Standard_Integer> aRoot(1, myNb);
+  NCollection_Array1<Standard_Integer> aSet(1, myNb);
+  //
+  aNbS=0;
+  for (i=1; i<=myNb; ++i) {
+    aR=Find(i);
+    aRoot(i)=aR;
+    if (aR==i) {
+      // the root is the smallest index, so it is met first
+      ++aNbS;
+      aSet(i)=aNbS;
+    }
+  }
+  //
+  // 2. offsets
+  theOffsets.Resize(1, aNbS+1, Standard_False);
+  theOffsets.Init(0);
+  for (i=1; i<=myNb; ++i) {
+    ++theOffsets(aSet(aRoot(i)));
+  }
+  aR=1;
+  for (i=1; i<=aNbS+1; ++i) {
+    Standard_Integer aN=(i<=aNbS) ? theOffsets(i) : 0;
+    theOffsets(i)=aR;
+    aR+=aN;
+  }
+  //
+  // 3. members, in the ascending order inside of each set
+  theMembers.Resize(1, myNb, Standard_False);
+  NCollection_Array1<Standard_Integer> aPos(1, aNbS);
+  for (i=1; i<=aNbS; ++i) {
+    aPos(i)=theOffsets(i);
+  }
+  for (i=1; i<=myNb; ++i) {
+    Standard_Integer& aP=aPos(aSet(aRoot(i)));
+    theMembers(aP)=i;
+    ++aP;
+  }
+  theNbSets=aNbS;
+}
@@ -0,0 +1,86 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_UnionFind.hxx
+//
+#ifndef _GEOMAlgo_UnionFind_HeaderFile
+#define _GEOMAlgo_UnionFind_HeaderFile
+
+#include <Standard.hxx>
+#include <Standard_Macro.hxx>
+#include <Standard_Integer.hxx>
+#include <Standard_Boolean.hxx>
+#include <NCollection_Array1.hxx>
+
+#include <atomic>
+
+//=======================================================================
+//class    : GEOMAlgo_UnionFind
+//purpose  : Disjoint sets over the indices [1, N].
+//           Find() and Union() are lock-free and can be called
+//           concurrently from several threads.
+//           The root of a set is always the smallest index of the set,
+//           so the resulting partition does not depend on the order
+//           of the unions.
+//=======================================================================
+class GEOMAlgo_UnionFind
+{
+ public:
+  Standard_EXPORT
+    GEOMAlgo_UnionFind();
+
+  Standard_EXPORT
+    virtual ~GEOMAlgo_UnionFind();
+
+  //! Makes theNb singleton sets {1}, {2}, ..., {theNb} <br>
+  Standard_EXPORT
+    void Init(const Standard_Integer theNb) ;
+
+  Standard_EXPORT
+    Standard_Integer Extent() const;
+
+  //! Returns the root (the smallest index) of the set of theI <br>
+  Standard_EXPORT
+    Standard_Integer Find(const Standard_Integer theI) const;
+
+  //! Merges the sets of theI and theJ. <br>
+  //!          Returns False if they are already in the same set <br>
+  Standard_EXPORT
+    Standard_Boolean Union(const Standard_Integer theI,
+                           const Standard_Integer theJ) ;
+
+  //! Returns the sets in the compressed (CSR) form: <br>
+  //!          the members of the set k (k=1..theNbSets) are <br>
+  //!          theMembers(theOffsets(k)) .. theMembers(theOffsets(k+1)-1). <br>
+  //!          The sets are ordered by their smallest index, the members <br>
+  //!          of a set are in the ascending order. <br>
+  //!          Not to be called concurrently with Union(). <br>
+  Standard_EXPORT
+    void Sets(Standard_Integer& theNbSets,
+              NCollection_Array1<Standard_Integer>& theOffsets,
+              NCollection_Array1<Standard_Integer>& theMembers) const;
+
+ private:
+  GEOMAlgo_UnionFind(const GEOMAlgo_UnionFind&);
+  GEOMAlgo_UnionFind& operator=(const GEOMAlgo_UnionFind&);
+
+ protected:
+  Standard_Integer myNb;
+  std::atomic<Standard_Integer>* myParent;
+};
+#endif
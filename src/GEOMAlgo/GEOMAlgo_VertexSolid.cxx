@@ -54,6 +54,12 @@
 #include <BOPDS_VectorOfInterfVE.hxx>
 #include <BOPDS_VectorOfInterfVF.hxx>
 #include <BOPDS_Interf.hxx>
+//
+#include <OSD_Parallel.hxx>
+#include <NCollection_Array1.hxx>
+//
+#include <GEOMAlgo_ContextPool.hxx>
+#include <GEOMAlgo_AlgoTools.hxx>
 
 //=======================================================================
 //function : GEOMAlgo_VertexSolid
@@ -114,16 +120,105 @@ void GEOMAlgo_VertexSolid::Perform()
   }
 }
 //=======================================================================
+//class    : GEOMAlgo_VertexSolidFunctor
+//purpose  : classifies the chunk of the vertices theIndices;
+//           each chunk takes the context of a free slot of the pool,
+//           the pool has one slot per thread
+//=======================================================================
+class GEOMAlgo_VertexSolidFunctor
+{
+ public:
+  GEOMAlgo_VertexSolidFunctor
+    (const BOPDS_DS& theDS,
+     const TopoDS_Solid& theSolid,
+     const NCollection_Array1<Standard_Integer>& theIndices,
+     const Handle(GEOMAlgo_ContextPool)& thePool,
+     NCollection_Array1<TopAbs_State>& theStates,
+     const Standard_Integer theNbChunks)
+  :
+    myDS(theDS),
+    mySolid(theSolid),
+    myIndices(theIndices),
+    myPool(thePool),
+    myStates(theStates),
+    myNbChunks(theNbChunks)
+  {}
+  //
+  void operator()(const Standard_Integer theChunk) const
+  {
+    Standard_Integer i, i1, i2, aNb, iSlot;
+    Standard_Real aTol;
+    gp_Pnt aP3D;
+    Handle(IntTools_Context) aCtx;
+    //
+    // the context of the free slot of the pool, a local one
+    // if there is no free slot
+    iSlot=myPool->Acquire();
+    if (iSlot<0) {
+      aCtx=new IntTools_Context;
+    }
+    else {
+      aCtx=myPool->Context(iSlot);
+    }
+    BRepClass3d_SolidClassifier& aSC=aCtx->SolidClassifier(mySolid);
+    //
+    aTol=1.e-7;
+    aNb=myIndices.Length();
+    GEOMAlgo_AlgoTools::ChunkBounds(theChunk, myNbChunks, 1, aNb, i1, i2);
+    for (i=i1; i<=i2; ++i) {
+      const TopoDS_Vertex& aV=TopoDS::Vertex(myDS.Shape(myIndices(i)));
+      aP3D=BRep_Tool::Pnt(aV);
+      aSC.Perform(aP3D, aTol);
+      myStates(i)=aSC.State();
+    }
+    //
+    if (iSlot>=0) {
+      myPool->Release(iSlot);
+    }
+  }
+  //
+ protected:
+  const BOPDS_DS& myDS;
+  const TopoDS_Solid& mySolid;
+  const NCollection_Array1<Standard_Integer>& myIndices;
+  Handle(GEOMAlgo_ContextPool) myPool;
+  NCollection_Array1<TopAbs_State>& myStates;
+  Standard_Integer myNbChunks;
+};
+
+//=======================================================================
+// function: MarkInterfered
+// purpose:  marks the shapes of the range [iBeg, iEnd] that take part
+//           in the interference
+//=======================================================================
+static
+  void MarkInterfered(const BOPDS_Interf& aInterf,
+                      const Standard_Integer iBeg,
+                      const Standard_Integer iEnd,
+                      NCollection_Array1<Standard_Boolean>& aIsON)
+{
+  Standard_Integer n1, n2;
+  //
+  aInterf.Indices(n1, n2);
+  if (n1>=iBeg && n1<=iEnd) {
+    aIsON(n1)=Standard_True;
+  }
+  if (n2>=iBeg && n2<=iEnd) {
+    aIsON(n2)=Standard_True;
+  }
+}
+//=======================================================================
 // function: BuildResult
-// purpose:
+// purpose:  the vertices that take part in the interferences VV, VE
+//           and VF are ON, the other ones are classified by the solid;
+//           the classification is run in parallel if myRunParallel
+//           is set, the order of the vertices in the lists does not
+//           depend on the mode
 //=======================================================================
 void GEOMAlgo_VertexSolid::BuildResult()
 {
-  Standard_Integer i, iBeg, iEnd, aNbVV, aNbVE, aNbVF, j, iFound;//, aNbRanges;
-  Standard_Real aTol;
+  Standard_Integer i, j, k, iBeg, iEnd, aNbVV, aNbVE, aNbVF, aNb, aNbChunks;
   TopAbs_State aSt;
-  TopAbs_ShapeEnum aType;
-  gp_Pnt aP3D;
   //
   myLSIN.Clear();
   myLSOUT.Clear();
@@ -142,74 +237,79 @@ void GEOMAlgo_VertexSolid::BuildResult()
   const TopoDS_Shape& aTool=aLS.Last();
   const TopoDS_Solid& aSolid=(myRank==0) ? TopoDS::Solid(aTool) : TopoDS::Solid(aObj);
   //
-  Handle(IntTools_Context) aCtx=myDSFiller->Context();
-  BRepClass3d_SolidClassifier& aSC=aCtx->SolidClassifier(aSolid);
-  //
-  //aNbRanges=aDS.NbRanges();
   const BOPDS_IndexRange& aRange=aDS.Range(myRank);
   aRange.Indices(iBeg, iEnd);
+  if (iEnd<iBeg) {
+    return;
+  }
+  //
+  // 1. the shapes of the range that have interferences
+  NCollection_Array1<Standard_Boolean> aIsON(iBeg, iEnd);
+  aIsON.Init(Standard_False);
   //
+  aNbVV=aVVs.Length();
+  for (j=0; j<aNbVV; ++j) {
+    MarkInterfered(aVVs(j), iBeg, iEnd, aIsON);
+  }
+  aNbVE=aVEs.Length();
+  for (j=0; j<aNbVE; ++j) {
+    MarkInterfered(aVEs(j), iBeg, iEnd, aIsON);
+  }
+  aNbVF=aVFs.Length();
+  for (j=0; j<aNbVF; ++j) {
+    MarkInterfered(aVFs(j), iBeg, iEnd, aIsON);
+  }
+  //
+  // 2. the free vertices
+  aNb=0;
   for (i=iBeg; i<=iEnd; ++i) {
-    const TopoDS_Shape& aS=aDS.Shape(i);
-    aType=aS.ShapeType();
-    if (aType!=TopAbs_VERTEX) {
-      continue; 
+    if (!aIsON(i) && aDS.Shape(i).ShapeType()==TopAbs_VERTEX) {
+      ++aNb;
+    }
+  }
+  //
+  NCollection_Array1<Standard_Integer> aIndices(1, Max(aNb, 1));
+  NCollection_Array1<TopAbs_State> aStates(1, Max(aNb, 1));
+  k=0;
+  for (i=iBeg; i<=iEnd; ++i) {
+    if (!aIsON(i) && aDS.Shape(i).ShapeType()==TopAbs_VERTEX) {
+      aIndices(++k)=i;
     }
+  }
+  //
+  // 3. classify the free vertices
+  if (aNb) {
+    Handle(GEOMAlgo_ContextPool) aPool;
     //
-    const TopoDS_Vertex& aV=TopoDS::Vertex(aS);
+    aNbChunks=GEOMAlgo_AlgoTools::NbChunks(aNb, myRunParallel);
     //
-    iFound=0;
+    aPool=new GEOMAlgo_ContextPool(myDSFiller->Context());
+    aPool->Reserve(GEOMAlgo_AlgoTools::NbSlots(aNbChunks));
     //
-    // 1
-    aNbVV=aVVs.Length();
-    for (j=0; j<aNbVV; ++j) {
-      BOPDS_InterfVV& aVV=aVVs(j);
-      if (aVV.Contains(i)) {
-        myLSON.Append(aV);
-        iFound=1;
-        break;
-      }
-    }
-    if (iFound) {
-      continue; 
-    }
-    // 2
-    aNbVE=aVEs.Length();
-    for (j=0; j<aNbVE; ++j) {
-      BOPDS_InterfVE& aVE=aVEs(j);
-      if (aVE.Contains(i)) {
-        myLSON.Append(aV);
-        iFound=1;
-        break;
-      }
-    }
-    if (iFound) {
+    GEOMAlgo_VertexSolidFunctor aFunctor(aDS, aSolid, aIndices, aPool,
+                                         aStates, aNbChunks);
+    OSD_Parallel::For(0, aNbChunks, aFunctor, aNbChunks==1);
+  }
+  //
+  // 4. the result
+  k=1;
+  for (i=iBeg; i<=iEnd; ++i) {
+    const TopoDS_Shape& aS=aDS.Shape(i);
+    if (aS.ShapeType()!=TopAbs_VERTEX) {
       continue; 
     }
-    // 3
-    aNbVF=aVFs.Length();
-    for (j=0; j<aNbVF; ++j) {
-      BOPDS_InterfVF& aVF=aVFs(j);
-      if (aVF.Contains(i)) {
-        myLSON.Append(aV);
-        iFound=1;
-        break;
-      }
-    }
-    if (iFound) {
-      continue; 
+    //
+    if (aIsON(i)) {
+      myLSON.Append(aS);
+      continue;
     }
     //
-    // 4
-    aP3D=BRep_Tool::Pnt(aV);
-    aTol=1.e-7;
-    aSC.Perform(aP3D, aTol);
-    aSt=aSC.State();
+    aSt=aStates(k++);
     if (aSt==TopAbs_IN) {
-      myLSIN.Append(aV);
+      myLSIN.Append(aS);
     }
     else if (aSt==TopAbs_OUT) {
-      myLSOUT.Append(aV);
+      myLSOUT.Append(aS);
     }
-  }//for (i=iBeg; i<iEnd; ++i) {
+  }//for (i=iBeg; i<=iEnd; ++i) {
 }
@@ -0,0 +1,892 @@
+// Copyright (C) 2007-2019  CEA/DEN, EDF R&D, OPEN CASCADE
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307 USA
+//
+// See http://www.salome-platform.org/ or email : webmaster.salome@opencascade.com
+//
+// File:        GEOMAlgo_bench.cxx
+//
+// Benchmark driver for the GEOMAlgo algorithms.
+//
+// Usage: GEOMAlgo_bench [-n N] [-c case] [-a algo] [-t] [-p] [-e NbE]
+//   -n N     size parameter of the synthetic models (default 4)
+//   -c case  boxes | cylinders | shells | all (default all) |
+//            passkeys
+//   -a algo  Gluer | Gluer2 | GlueDetector | FinderShapeOn2 |
+//            VertexSolid | ClsfSolid | GetInPlaceOld | Extractor |
+//            ShapeInfoFiller | RemoverWebs | all (default all)
+//   -t       print the phases of the algorithms as well
+//   -p       run the algorithms in the parallel mode
+//   -e NbE   number of the edge keys of the case passkeys
+//            (default 1000000)
+//
+// The models are:
+//   boxes     - N x N x N grid of unit boxes sharing faces;
+//   cylinders - N x N array of stacks of N cylinders sharing caps;
+//   shells    - row of N x N hollow boxes (solids with an inner shell).
+//
+// One line is printed for each run:
+//   case N algo wall[s] peakRSS[MB] err warn nbV nbE nbF nbSo -> counts
+// With -t each run is followed by the lines
+//   phase name wall[s] nbShapes nbTreeQueries nbClsfCalls
+// The peak RSS is the peak of the process, run one algorithm per
+// process (-a) to have a clean value.
+//
+// The case passkeys is not a part of all. It makes NbE edge keys
+// GEOMAlgo_PassKeyShape(V1, V2) on a grid of vertices and prints the
+// distribution of the lengths of the buckets of a map of NbE keys for
+// the former hash (sum of the hash codes of the vertices) and for
+// GEOMAlgo_PassKeyShape::HashCode():
+//   passkeys NbE hash buckets max mean | n0 n1 ... n7 n8+
+// mean is the mean length of the non-empty buckets, nK is the number
+// of the buckets of the length K.
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <OSD_Timer.hxx>
+#include <OSD_MemInfo.hxx>
+
+#include <gp_Pnt.hxx>
+#include <gp_Ax2.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Vec.hxx>
+#include <gp_Trsf.hxx>
+#include <TopLoc_Location.hxx>
+
+#include <TopAbs_ShapeEnum.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Shape.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <BRep_Builder.hxx>
+#include <TopExp.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+#include <TopTools_ListOfShape.hxx>
+
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeCylinder.hxx>
+#include <BRepAlgoAPI_Cut.hxx>
+#include <BOPAlgo_PaveFiller.hxx>
+#include <Bnd_Box.hxx>
+#include <BRepBndLib.hxx>
+
+#include <TCollection.hxx>
+#include <NCollection_Array1.hxx>
+#include <NCollection_Vector.hxx>
+#include <TopoDS_Vertex.hxx>
+
+#include <GEOMAlgo_Gluer.hxx>
+#include <GEOMAlgo_Gluer2.hxx>
+#include <GEOMAlgo_GlueDetector.hxx>
+#include <GEOMAlgo_FinderShapeOn2.hxx>
+#include <GEOMAlgo_InnerPointsCache.hxx>
+#include <GEOMAlgo_ClsfBox.hxx>
+#include <GEOMAlgo_VertexSolid.hxx>
+#include <GEOMAlgo_ClsfSolid.hxx>
+#include <GEOMAlgo_GetInPlaceOld.hxx>
+#include <GEOMAlgo_GPropsCache.hxx>
+#include <GEOMAlgo_Extractor.hxx>
+#include <GEOMAlgo_ShapeInfoFiller.hxx>
+#include <GEOMAlgo_ShapeInfoStore.hxx>
+#include <GEOMAlgo_RemoverWebs.hxx>
+#include <GEOMAlgo_PassKeyShape.hxx>
+#include <GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape.hxx>
+
+static
+  Standard_Real PeakRSS();
+static
+  void PrintPhases(const GEOMAlgo_Algo& aAlgo);
+static
+  Standard_Integer NbSubShapes(const TopoDS_Shape& aS,
+                               const TopAbs_ShapeEnum aType);
+static
+  void Report(const char* aCase,
+              const Standard_Integer aN,
+              const char* aAlgo,
+              const Standard_Real aTime,
+              const Standard_Integer iErr,
+              const Standard_Integer iWrn,
+              const TopoDS_Shape& aS,
+              const char* aCounts);
+static
+  TopoDS_Shape MakeBoxes(const Standard_Integer aN);
+static
+  TopoDS_Shape MakeCylinders(const Standard_Integer aN);
+static
+  TopoDS_Shape MakeShells(const Standard_Integer aN);
+static
+  TopoDS_Shape Glue(const TopoDS_Shape& aS);
+static
+  void Run(const char* aCase,
+           const Standard_Integer aN,
+           const TopoDS_Shape& aS,
+           const char* aAlgo);
+static
+  void RunPassKeys(const Standard_Integer aNbE);
+static
+  void PrintBuckets(const Standard_Integer aNbE,
+                    const char* aHash,
+                    const NCollection_Array1<Standard_Integer>& aBuckets);
+static
+  Standard_Integer LegacyHashCode(const TopoDS_Shape& aS1,
+                                  const TopoDS_Shape& aS2,
+                                  const Standard_Integer aUpper);
+
+static const Standard_Real theTol=1.e-7;
+static Standard_Boolean theTiming=Standard_False;
+static Standard_Boolean theParallel=Standard_False;
+
+//=======================================================================
+//function : main
+//purpose  :
+//=======================================================================
+int main(int argc, char** argv)
+{
+  Standard_Integer i, aN, aNbE;
+  const char* pCase="all";
+  const char* pAlgo="all";
+  //
+  aN=4;
+  aNbE=1000000;
+  for (i=1; i<argc; ++i) {
+    if (!strcmp(argv[i], "-n") && i+1<argc) {
+      aN=atoi(argv[++i]);
+    }
+    else if (!strcmp(argv[i], "-c") && i+1<argc) {
+      pCase=argv[++i];
+    }
+    else if (!strcmp(argv[i], "-a") && i+1<argc) {
+      pAlgo=argv[++i];
+    }
+    else if (!strcmp(argv[i], "-t")) {
+      theTiming=Standard_True;
+    }
+    else if (!strcmp(argv[i], "-p")) {
+      theParallel=Standard_True;
+    }
+    else if (!strcmp(argv[i], "-e") && i+1<argc) {
+      aNbE=atoi(argv[++i]);
+    }
+    else {
+      printf("Usage: %s [-n N] [-c case] [-a algo] [-t] [-p] [-e NbE]\n",
+             argv[0]);
+      return 1;
+    }
+  }
+  if (aN<1) {
+    aN=1;
+  }
+  //
+  if (!strcmp(pCase, "passkeys")) {
+    RunPassKeys(aNbE>1 ? aNbE : 1);
+    return 0;
+  }
+  //
+  printf("# case N algo wall[s] peakRSS[MB] err warn nbV nbE nbF nbSo "
+         "-> counts\n");
+  //
+  if (!strcmp(pCase, "all") || !strcmp(pCase, "boxes")) {
+    Run("boxes", aN, MakeBoxes(aN), pAlgo);
+  }
+  if (!strcmp(pCase, "all") || !strcmp(pCase, "cylinders")) {
+    Run("cylinders", aN, MakeCylinders(aN), pAlgo);
+  }
+  if (!strcmp(pCase, "all") || !strcmp(pCase, "shells")) {
+    Run("shells", aN, MakeShells(aN), pAlgo);
+  }
+  return 0;
+}
+//=======================================================================
+//function : Run
+//purpose  : runs the algorithms selected by aAlgo on the model aS
+//=======================================================================
+void Run(const char* aCase,
+         const Standard_Integer aN,
+         const TopoDS_Shape& aS,
+         const char* aAlgo)
+{
+  Standard_Boolean bAll;
+  char aCounts[256];
+  OSD_Timer aTimer;
+  //
+  bAll=!strcmp(aAlgo, "all");
+  //
+  // GlueDetector
+  if (bAll || !strcmp(aAlgo, "GlueDetector")) {
+    GEOMAlgo_GlueDetector aGD;
+    //
+    aGD.SetArgument(aS);
+    aGD.SetTolerance(theTol);
+    aGD.SetRunParallel(theParallel);
+    aGD.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aGD.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "images=%d origins=%d",
+            aGD.Images().Extent(), aGD.Origins().Extent());
+    Report(aCase, aN, "GlueDetector", aTimer.ElapsedTime(),
+           aGD.ErrorStatus(), aGD.WarningStatus(), aS, aCounts);
+    PrintPhases(aGD);
+  }
+  //
+  // Gluer
+  if (bAll || !strcmp(aAlgo, "Gluer")) {
+    GEOMAlgo_Gluer aGluer;
+    //
+    aGluer.SetShape(aS);
+    aGluer.SetTolerance(theTol);
+    aGluer.SetCheckGeometry(Standard_True);
+    aGluer.SetRunParallel(theParallel);
+    aGluer.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aGluer.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "images=%d alone=%d",
+            aGluer.Images().Extent(), aGluer.AloneShapes());
+    Report(aCase, aN, "Gluer", aTimer.ElapsedTime(),
+           aGluer.ErrorStatus(), aGluer.WarningStatus(),
+           aGluer.Result(), aCounts);
+    PrintPhases(aGluer);
+  }
+  //
+  // Gluer2
+  if (bAll || !strcmp(aAlgo, "Gluer2")) {
+    GEOMAlgo_Gluer2 aGluer2;
+    //
+    aGluer2.SetArgument(aS);
+    aGluer2.SetTolerance(theTol);
+    aGluer2.SetRunParallel(theParallel);
+    aGluer2.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aGluer2.Detect();
+    aGluer2.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "detected=%d",
+            aGluer2.ShapesDetected().Extent());
+    Report(aCase, aN, "Gluer2", aTimer.ElapsedTime(),
+           aGluer2.ErrorStatus(), aGluer2.WarningStatus(),
+           aGluer2.Shape(), aCounts);
+    PrintPhases(aGluer2);
+  }
+  //
+  // FinderShapeOn2, the box covers the half of the model, the one
+  // with X < N/2; the second run takes the inner points from the cache
+  // of the first
+  if (bAll || !strcmp(aAlgo, "FinderShapeOn2")) {
+    Standard_Integer iRun;
+    Standard_Real aD, aE;
+    TopoDS_Shape aBox;
+    Handle(GEOMAlgo_ClsfBox) aClsf;
+    Handle(GEOMAlgo_InnerPointsCache) aCache;
+    //
+    aD=0.5*aN+0.25;
+    aE=aN+0.25;
+    aBox=BRepPrimAPI_MakeBox(gp_Pnt(-0.25, -0.25, -0.25),
+                             gp_Pnt(aD, aE, aE)).Shape();
+    aClsf=new GEOMAlgo_ClsfBox;
+    aClsf->SetBox(aBox);
+    aClsf->SetTolerance(theTol);
+    aCache=new GEOMAlgo_InnerPointsCache;
+    //
+    for (iRun=0; iRun<2; ++iRun) {
+      GEOMAlgo_FinderShapeOn2 aFinder;
+      //
+      aFinder.SetShape(aS);
+      aFinder.SetTolerance(theTol);
+      aFinder.SetClsf(aClsf);
+      aFinder.SetShapeType(TopAbs_FACE);
+      aFinder.SetState(GEOMAlgo_ST_IN);
+      aFinder.SetInnerPointsCache(aCache);
+      aFinder.SetRunParallel(theParallel);
+      aFinder.SetTimingEnabled(theTiming);
+      aTimer.Reset();
+      aTimer.Start();
+      aFinder.Perform();
+      aTimer.Stop();
+      //
+      sprintf(aCounts, "found=%d states=%d cached=%d",
+              aFinder.Shapes().Extent(), aFinder.MSS().Extent(),
+              aCache->Extent());
+      Report(aCase, aN, iRun ? "FinderShapeOn2/cached" : "FinderShapeOn2",
+             aTimer.ElapsedTime(), aFinder.ErrorStatus(),
+             aFinder.WarningStatus(), aS, aCounts);
+      PrintPhases(aFinder);
+    }
+  }
+  //
+  // VertexSolid, the free vertices of the model are classified by
+  // the box that covers the half of the model, the one with X < N/2
+  if (bAll || !strcmp(aAlgo, "VertexSolid")) {
+    Standard_Integer i, aNbV;
+    Standard_Real aD, aE;
+    TopoDS_Compound aCV;
+    TopoDS_Shape aBox;
+    TopTools_IndexedMapOfShape aMV;
+    TopTools_ListOfShape aLS;
+    BRep_Builder aBB;
+    BOPAlgo_PaveFiller aPF;
+    GEOMAlgo_VertexSolid aVXS;
+    //
+    TopExp::MapShapes(aS, TopAbs_VERTEX, aMV);
+    aNbV=aMV.Extent();
+    aBB.MakeCompound(aCV);
+    for (i=1; i<=aNbV; ++i) {
+      aBB.Add(aCV, aMV(i));
+    }
+    //
+    aD=0.5*aN+0.25;
+    aE=aN+0.25;
+    aBox=BRepPrimAPI_MakeBox(gp_Pnt(-0.25, -0.25, -0.25),
+                             gp_Pnt(aD, aE, aE)).Solid();
+    //
+    aLS.Append(aCV);
+    aLS.Append(aBox);
+    aPF.SetArguments(aLS);
+    aPF.SetRunParallel(theParallel);
+    aPF.Perform();
+    //
+    aVXS.SetFiller(aPF);
+    aVXS.SetRunParallel(theParallel);
+    aVXS.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aVXS.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "in=%d out=%d on=%d",
+            aVXS.Shapes(TopAbs_IN).Extent(),
+            aVXS.Shapes(TopAbs_OUT).Extent(),
+            aVXS.Shapes(TopAbs_ON).Extent());
+    Report(aCase, aN, "VertexSolid", aTimer.ElapsedTime(),
+           aVXS.ErrorStatus(), aVXS.WarningStatus(), aS, aCounts);
+    PrintPhases(aVXS);
+  }
+  //
+  // ClsfSolid, a grid of points over the box of the first solid
+  // is classified by the triangulation (SetUseBVH) and exactly;
+  // diff, the number of the points with different states, must be 0
+  if (bAll || !strcmp(aAlgo, "ClsfSolid")) {
+    Standard_Integer i, j, k, aNbG, aNbP, aNbIn, aNbDiff, iErr;
+    Standard_Real aXmin, aYmin, aZmin, aXmax, aYmax, aZmax;
+    TopTools_IndexedMapOfShape aMSo;
+    Bnd_Box aBox;
+    Handle(GEOMAlgo_ClsfSolid) aClsfBVH, aClsfExact;
+    //
+    TopExp::MapShapes(aS, TopAbs_SOLID, aMSo);
+    if (aMSo.Extent()) {
+      const TopoDS_Shape& aSo=aMSo(1);
+      //
+      BRepBndLib::Add(aSo, aBox);
+      aBox.Enlarge(0.1);
+      aBox.Get(aXmin, aYmin, aZmin, aXmax, aYmax, aZmax);
+      //
+      aNbG=20;
+      aNbP=aNbG*aNbG*aNbG;
+      NCollection_Array1<gp_Pnt> aPnts(1, aNbP);
+      NCollection_Array1<TopAbs_State> aStsBVH(1, aNbP), aStsExact(1, aNbP);
+      aNbP=0;
+      for (i=0; i<aNbG; ++i) {
+        for (j=0; j<aNbG; ++j) {
+          for (k=0; k<aNbG; ++k) {
+            aPnts(++aNbP)=
+              gp_Pnt(aXmin+(aXmax-aXmin)*(i+0.5)/aNbG,
+                     aYmin+(aYmax-aYmin)*(j+0.5)/aNbG,
+                     aZmin+(aZmax-aZmin)*(k+0.5)/aNbG);
+          }
+        }
+      }
+      //
+      aClsfExact=new GEOMAlgo_ClsfSolid;
+      aClsfExact->SetShape(aSo);
+      aClsfExact->SetTolerance(theTol);
+      aClsfExact->CheckData();
+      aClsfExact->Perform(&aPnts(1), aNbP, &aStsExact(1));
+      //
+      aClsfBVH=new GEOMAlgo_ClsfSolid;
+      aClsfBVH->SetShape(aSo);
+      aClsfBVH->SetTolerance(theTol);
+      aClsfBVH->SetUseBVH(Standard_True);
+      aTimer.Reset();
+      aTimer.Start();
+      aClsfBVH->CheckData();
+      aClsfBVH->Perform(&aPnts(1), aNbP, &aStsBVH(1));
+      aTimer.Stop();
+      //
+      iErr=aClsfBVH->ErrorStatus();
+      if (!iErr) {
+        iErr=aClsfExact->ErrorStatus();
+      }
+      aNbIn=0;
+      aNbDiff=0;
+      for (i=1; i<=aNbP; ++i) {
+        if (aStsExact(i)==TopAbs_IN) {
+          ++aNbIn;
+        }
+        if (aStsBVH(i)!=aStsExact(i)) {
+          ++aNbDiff;
+        }
+      }
+      //
+      sprintf(aCounts, "pnts=%d in=%d diff=%d", aNbP, aNbIn, aNbDiff);
+      Report(aCase, aN, "ClsfSolid", aTimer.ElapsedTime(),
+             iErr, 0, aSo, aCounts);
+    }
+  }
+  //
+  // GetInPlaceOld, every second face of the model is searched;
+  // the second run takes the properties from the cache of the first
+  if (bAll || !strcmp(aAlgo, "GetInPlaceOld")) {
+    Standard_Integer i, iRun, iErr, aNbF;
+    TopoDS_Compound aCF;
+    TopTools_IndexedMapOfShape aMF;
+    TopTools_ListOfShape aLSInPlace;
+    BRep_Builder aBB;
+    Handle(GEOMAlgo_GPropsCache) aCache;
+    //
+    TopExp::MapShapes(aS, TopAbs_FACE, aMF);
+    aNbF=aMF.Extent();
+    aBB.MakeCompound(aCF);
+    for (i=1; i<=aNbF; i+=2) {
+      aBB.Add(aCF, aMF(i));
+    }
+    aCache=new GEOMAlgo_GPropsCache;
+    //
+    for (iRun=0; iRun<2; ++iRun) {
+      aTimer.Reset();
+      aTimer.Start();
+      iErr=GEOMAlgo_GetInPlaceOld::Perform(aS, aCF, aLSInPlace,
+                                           theParallel, aCache);
+      aTimer.Stop();
+      //
+      sprintf(aCounts, "found=%d cached=%d",
+              aLSInPlace.Extent(), aCache->Extent());
+      Report(aCase, aN, iRun ? "GetInPlaceOld/cached" : "GetInPlaceOld",
+             aTimer.ElapsedTime(), iErr, 0, aS, aCounts);
+    }
+  }
+  //
+  // Extractor, every second face is removed
+  if (bAll || !strcmp(aAlgo, "Extractor")) {
+    Standard_Integer i, aNbF;
+    TopTools_IndexedMapOfShape aMF;
+    TopTools_ListOfShape aLF;
+    GEOMAlgo_Extractor aExtractor;
+    //
+    TopExp::MapShapes(aS, TopAbs_FACE, aMF);
+    aNbF=aMF.Extent();
+    for (i=1; i<=aNbF; i+=2) {
+      aLF.Append(aMF(i));
+    }
+    //
+    aExtractor.SetShape(aS);
+    aExtractor.SetShapesToRemove(aLF);
+    aExtractor.SetRunParallel(theParallel);
+    aExtractor.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aExtractor.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "removed=%d modified=%d new=%d",
+            aExtractor.GetRemoved().Extent(),
+            aExtractor.GetModified().Extent(),
+            aExtractor.GetNew().Extent());
+    Report(aCase, aN, "Extractor", aTimer.ElapsedTime(),
+           aExtractor.ErrorStatus(), aExtractor.WarningStatus(),
+           aExtractor.GetResult(), aCounts);
+    PrintPhases(aExtractor);
+    //
+    // the faces are removed one by one from the prepared shape
+    Standard_Integer aNbSets, aNbFailed;
+    NCollection_Vector<TopTools_ListOfShape> aSets;
+    //
+    aNbSets=(aNbF<64) ? aNbF : 64;
+    for (i=1; i<=aNbSets; ++i) {
+      TopTools_ListOfShape aLF1;
+      aLF1.Append(aMF(i));
+      aSets.Append(aLF1);
+    }
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    aExtractor.PerformBatch(aSets);
+    aTimer.Stop();
+    //
+    aNbFailed=0;
+    for (i=0; i<aExtractor.GetBatchErrors().Length(); ++i) {
+      if (aExtractor.GetBatchErrors()(i)) {
+        ++aNbFailed;
+      }
+    }
+    sprintf(aCounts, "sets=%d failed=%d", aNbSets, aNbFailed);
+    Report(aCase, aN, "Extractor/batch", aTimer.ElapsedTime(),
+           aExtractor.ErrorStatus(), aExtractor.WarningStatus(),
+           aS, aCounts);
+    PrintPhases(aExtractor);
+  }
+  //
+  // ShapeInfoFiller
+  if (bAll || !strcmp(aAlgo, "ShapeInfoFiller")) {
+    GEOMAlgo_ShapeInfoFiller aSIF;
+    //
+    aSIF.SetShape(aS);
+    aSIF.SetTolerance(theTol);
+    aSIF.SetRunParallel(theParallel);
+    aSIF.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aSIF.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "kind=%d", (int)aSIF.Info().KindOfShape());
+    Report(aCase, aN, "ShapeInfoFiller", aTimer.ElapsedTime(),
+           aSIF.ErrorStatus(), aSIF.WarningStatus(), aS, aCounts);
+    PrintPhases(aSIF);
+    //
+    // nothing is modified, only the containers are re-filled
+    TopTools_ListOfShape aLSModified;
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    aSIF.Update(aLSModified);
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "kind=%d", (int)aSIF.Info().KindOfShape());
+    Report(aCase, aN, "ShapeInfoFiller/update", aTimer.ElapsedTime(),
+           aSIF.ErrorStatus(), aSIF.WarningStatus(), aS, aCounts);
+    PrintPhases(aSIF);
+    //
+    // the compact copy of the records
+    GEOMAlgo_ShapeInfoStore aStore;
+    //
+    aTimer.Reset();
+    aTimer.Start();
+    aStore.Build(aSIF.MapInfo());
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "records=%d bytes=%lu map_bytes=%lu",
+            aStore.Extent(), (unsigned long)aStore.NbBytes(),
+            (unsigned long)(aStore.Extent()*sizeof(GEOMAlgo_ShapeInfo)));
+    Report(aCase, aN, "ShapeInfoStore", aTimer.ElapsedTime(),
+           0, 0, aS, aCounts);
+  }
+  //
+  // RemoverWebs, the argument is the glued model
+  if (bAll || !strcmp(aAlgo, "RemoverWebs")) {
+    TopoDS_Shape aSG;
+    GEOMAlgo_RemoverWebs aRW;
+    //
+    aSG=Glue(aS);
+    aRW.SetShape(aSG);
+    aRW.SetRunParallel(theParallel);
+    aRW.SetTimingEnabled(theTiming);
+    aTimer.Reset();
+    aTimer.Start();
+    aRW.Perform();
+    aTimer.Stop();
+    //
+    sprintf(aCounts, "solids=%d", NbSubShapes(aRW.Result(), TopAbs_SOLID));
+    Report(aCase, aN, "RemoverWebs", aTimer.ElapsedTime(),
+           aRW.ErrorStatus(), aRW.WarningStatus(), aRW.Result(), aCounts);
+    PrintPhases(aRW);
+  }
+}
+//=======================================================================
+//function : RunPassKeys
+//purpose  : bucket lengths of the edge keys, see the header
+//=======================================================================
+void RunPassKeys(const Standard_Integer aNbE)
+{
+  Standard_Integer i, j, k, aNbV, aNbB, aNbK, aIdx;
+  BRep_Builder aBB;
+  OSD_Timer aTimer;
+  TopTools_ListOfShape aLE;
+  GEOMAlgo_PassKeyShape aPK;
+  GEOMAlgo_IndexedDataMapOfPassKeyShapeListOfShape aMPKLE;
+  //
+  // k x k vertices give 2*k*(k-1) edges between the neighbours
+  aNbV=2;
+  while (2*aNbV*(aNbV-1)<aNbE) {
+    ++aNbV;
+  }
+  NCollection_Array1<TopoDS_Vertex> aV(0, aNbV*aNbV-1);
+  for (i=0; i<aNbV; ++i) {
+    for (j=0; j<aNbV; ++j) {
+      aBB.MakeVertex(aV(i*aNbV+j), gp_Pnt(i, j, 0.), theTol);
+    }
+  }
+  //
+  // the number of the buckets of a map of aNbE keys
+  aNbB=TCollection::NextPrimeForMap(aNbE);
+  NCollection_Array1<Standard_Integer> aBOld(1, aNbB), aBNew(1, aNbB);
+  aBOld.Init(0);
+  aBNew.Init(0);
+  //
+  aNbK=0;
+  for (i=0; i<aNbV && aNbK<aNbE; ++i) {
+    for (j=0; j<aNbV && aNbK<aNbE; ++j) {
+      for (k=0; k<2 && aNbK<aNbE; ++k) {
+        if ((!k && j+1==aNbV) || (k && i+1==aNbV)) {
+          continue;
+        }
+        const TopoDS_Shape& aV1=aV(i*aNbV+j);
+        const TopoDS_Shape& aV2=aV(k ? (i+1)*aNbV+j : i*aNbV+j+1);
+        //
+        ++aBOld(LegacyHashCode(aV1, aV2, aNbB));
+        aPK.SetShapes(aV1, aV2);
+        ++aBNew(aPK.HashCode(aNbB));
+        ++aNbK;
+      }
+    }
+  }
+  PrintBuckets(aNbK, "sum", aBOld);
+  PrintBuckets(aNbK, "mixed", aBNew);
+  //
+  // the time of filling the map used by the gluers
+  aTimer.Start();
+  for (i=0; i<aNbV; ++i) {
+    for (j=0; j+1<aNbV; ++j) {
+      aPK.SetShapes(aV(i*aNbV+j), aV(i*aNbV+j+1));
+      aIdx=aMPKLE.FindIndex(aPK);
+      if (!aIdx) {
+        aMPKLE.Add(aPK, aLE);
+      }
+    }
+  }
+  aTimer.Stop();
+  printf("passkeys %d map %d keys %.6f s\n",
+         aNbK, aMPKLE.Extent(), aTimer.ElapsedTime());
+  fflush(stdout);
+}
+//=======================================================================
+//function : PrintBuckets
+//purpose  :
+//=======================================================================
+void PrintBuckets(const Standard_Integer aNbE,
+                  const char* aHash,
+                  const NCollection_Array1<Standard_Integer>& aBuckets)
+{
+  Standard_Integer i, aL, aMax, aNbNE;
+  Standard_Integer aHist[9];
+  //
+  memset(aHist, 0, sizeof(aHist));
+  aMax=0;
+  aNbNE=0;
+  for (i=aBuckets.Lower(); i<=aBuckets.Upper(); ++i) {
+    aL=aBuckets(i);
+    ++aHist[aL<8 ? aL : 8];
+    if (aL) {
+      ++aNbNE;
+    }
+    if (aL>aMax) {
+      aMax=aL;
+    }
+  }
+  printf("passkeys %d %s %d %d %.3f |",
+         aNbE, aHash, aBuckets.Length(), aMax,
+         aNbNE ? (Standard_Real)aNbE/aNbNE : 0.);
+  for (i=0; i<9; ++i) {
+    printf(" %d", aHist[i]);
+  }
+  printf("\n");
+  fflush(stdout);
+}
+//=======================================================================
+//function : LegacyHashCode
+//purpose  : the hash code of GEOMAlgo_PassKeyShape(aS1, aS2) before
+//           the key was redesigned: the sum of the hash codes
+//=======================================================================
+Standard_Integer LegacyHashCode(const TopoDS_Shape& aS1,
+                                const TopoDS_Shape& aS2,
+                                const Standard_Integer aUpper)
+{
+  Standard_Integer aSum;
+  //
+  // the ids were normalized by IntegerLast()/2, a no-op for them
+  aSum=aS1.HashCode(432123)+aS2.HashCode(432123);
+  return ::HashCode(aSum, aUpper);
+}
+//=======================================================================
+//function : Report
+//purpose  :
+//=======================================================================
+void Report(const char* aCase,
+            const Standard_Integer aN,
+            const char* aAlgo,
+            const Standard_Real aTime,
+            const Standard_Integer iErr,
+            const Standard_Integer iWrn,
+            const TopoDS_Shape& aS,
+            const char* aCounts)
+{
+  printf("%s %d %s %.6f %.1f %d %d %d %d %d %d -> %s\n",
+         aCase, aN, aAlgo, aTime, PeakRSS(), iErr, iWrn,
+         NbSubShapes(aS, TopAbs_VERTEX),
+         NbSubShapes(aS, TopAbs_EDGE),
+         NbSubShapes(aS, TopAbs_FACE),
+         NbSubShapes(aS, TopAbs_SOLID),
+         aCounts);
+  fflush(stdout);
+}
+//=======================================================================
+//function : PrintPhases
+//purpose  :
+//=======================================================================
+void PrintPhases(const GEOMAlgo_Algo& aAlgo)
+{
+  GEOMAlgo_VectorOfPhaseInfo::Iterator aIt(aAlgo.Phases());
+  for (; aIt.More(); aIt.Next()) {
+    const GEOMAlgo_PhaseInfo& aPh=aIt.Value();
+    printf("  phase %s %.6f %lu %lu %lu\n",
+           aPh.Name().ToCString(), aPh.Time(),
+           (unsigned long)aPh.NbShapes(),
+           (unsigned long)aPh.NbTreeQueries(),
+           (unsigned long)aPh.NbClsfCalls());
+  }
+  fflush(stdout);
+}
+//=======================================================================
+//function : PeakRSS
+//purpose  : peak working set of the process, MB
+//=======================================================================
+Standard_Real PeakRSS()
+{
+  Standard_Size aPeak;
+  OSD_MemInfo aMI(Standard_False);
+  //
+  aMI.SetActive(OSD_MemInfo::MemWorkingSetPeak, Standard_True);
+  aMI.Update();
+  aPeak=aMI.Value(OSD_MemInfo::MemWorkingSetPeak);
+  if (aPeak==Standard_Size(-1)) {
+    return -1.;
+  }
+  return aPeak/(1024.*1024.);
+}
+//=======================================================================
+//function : NbSubShapes
+//purpose  :
+//=======================================================================
+Standard_Integer NbSubShapes(const TopoDS_Shape& aS,
+                             const TopAbs_ShapeEnum aType)
+{
+  TopTools_IndexedMapOfShape aM;
+  //
+  if (aS.IsNull()) {
+    return 0;
+  }
+  TopExp::MapShapes(aS, aType, aM);
+  return aM.Extent();
+}
+//=======================================================================
+//function : MakeBoxes
+//purpose  : N x N x N grid of unit boxes,
+//           the neighbouring boxes have coinciding faces
+//=======================================================================
+TopoDS_Shape MakeBoxes(const Standard_Integer aN)
+{
+  Standard_Integer i, j, k;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  for (i=0; i<aN; ++i) {
+    for (j=0; j<aN; ++j) {
+      for (k=0; k<aN; ++k) {
+        BRepPrimAPI_MakeBox aMB(gp_Pnt(i, j, k), 1., 1., 1.);
+        aBB.Add(aC, aMB.Shape());
+      }
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : MakeCylinders
+//purpose  : N x N array of stacks of N cylinders,
+//           the cylinders of one stack have coinciding caps
+//=======================================================================
+TopoDS_Shape MakeCylinders(const Standard_Integer aN)
+{
+  Standard_Integer i, j, k;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aBB.MakeCompound(aC);
+  for (i=0; i<aN; ++i) {
+    for (j=0; j<aN; ++j) {
+      for (k=0; k<aN; ++k) {
+        gp_Ax2 aAx2(gp_Pnt(i+0.5, j+0.5, k), gp_Dir(0., 0., 1.));
+        BRepPrimAPI_MakeCylinder aMC(aAx2, 0.4, 1.);
+        aBB.Add(aC, aMC.Shape());
+      }
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : MakeShells
+//purpose  : row of N x N hollow unit boxes,
+//           each solid has the outer and the inner shell
+//=======================================================================
+TopoDS_Shape MakeShells(const Standard_Integer aN)
+{
+  Standard_Integer i, j;
+  TopoDS_Shape aHollow;
+  TopoDS_Compound aC;
+  BRep_Builder aBB;
+  //
+  aHollow=BRepAlgoAPI_Cut
+    (BRepPrimAPI_MakeBox(gp_Pnt(0., 0., 0.), 1., 1., 1.).Shape(),
+     BRepPrimAPI_MakeBox(gp_Pnt(0.25, 0.25, 0.25), 0.5, 0.5, 0.5).Shape());
+  //
+  aBB.MakeCompound(aC);
+  for (i=0; i<aN; ++i) {
+    for (j=0; j<aN; ++j) {
+      TopExp_Explorer aExp(aHollow, TopAbs_SOLID);
+      for (; aExp.More(); aExp.Next()) {
+        gp_Trsf aTrsf;
+        //
+        aTrsf.SetTranslation(gp_Vec(i, j, 0.));
+        aBB.Add(aC, aExp.Current().Moved(TopLoc_Location(aTrsf)));
+      }
+    }
+  }
+  return aC;
+}
+//=======================================================================
+//function : Glue
+//purpose  : glued copy of aS, used as the argument of RemoverWebs
+//=======================================================================
+TopoDS_Shape Glue(const TopoDS_Shape& aS)
+{
+  GEOMAlgo_Gluer2 aGluer2;
+  //
+  aGluer2.SetArgument(aS);
+  aGluer2.SetTolerance(theTol);
+  aGluer2.Detect();
+  aGluer2.Perform();
+  if (aGluer2.ErrorStatus()) {
+    return aS;
+  }
+  return aGluer2.Shape();
+}